@@ -0,0 +1,35 @@
+#include "benchmark.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+
+namespace {
+	std::atomic<std::size_t> s_allocationsCount {0};
+
+} // namespace
+
+
+auto operator new(std::size_t size) -> void* {
+	s_allocationsCount.fetch_add(1, std::memory_order_relaxed);
+	if (void *pointer {std::malloc(size == 0 ? 1 : size)}; pointer != nullptr)
+		return pointer;
+	throw std::bad_alloc();
+}
+
+auto operator delete(void *pointer) noexcept -> void {
+	std::free(pointer);
+}
+
+auto operator delete(void *pointer, std::size_t) noexcept -> void {
+	std::free(pointer);
+}
+
+
+namespace flex::benchmarks {
+	auto getAllocationsCount() noexcept -> std::size_t {
+		return s_allocationsCount.load(std::memory_order_relaxed);
+	}
+
+} // namespace flex::benchmarks
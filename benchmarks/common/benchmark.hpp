@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string_view>
+
+
+namespace flex::benchmarks {
+	/*
+	 * @brief The amount of calls to the global `operator new` since the start of the program
+	 * */
+	auto getAllocationsCount() noexcept -> std::size_t;
+
+	template <typename T>
+	auto doNotOptimize(const T &value) noexcept -> void {
+	#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+	#else
+		static volatile const void *sink {};
+		sink = &value;
+	#endif
+	}
+
+	struct Result {
+		double nanosecondsPerIteration;
+		double allocationsPerIteration;
+	};
+
+	/*
+	 * @brief Time `iterations` calls to `function` after a warmup, and print a line of report
+	 * */
+	template <typename Function>
+	auto run(std::string_view name, std::size_t iterations, Function &&function) -> Result {
+		for (std::size_t i {0}; i < iterations / 10 + 1; ++i)
+			function();
+
+		const std::size_t allocationsStart {getAllocationsCount()};
+		const auto start {std::chrono::steady_clock::now()};
+		for (std::size_t i {0}; i < iterations; ++i)
+			function();
+		const auto end {std::chrono::steady_clock::now()};
+		const std::size_t allocations {getAllocationsCount() - allocationsStart};
+
+		const Result result {
+			.nanosecondsPerIteration = std::chrono::duration<double, std::nano> (end - start).count() / static_cast<double> (iterations),
+			.allocationsPerIteration = static_cast<double> (allocations) / static_cast<double> (iterations)
+		};
+		std::cout << name << " : " << result.nanosecondsPerIteration << " ns/op, "
+			<< result.allocationsPerIteration << " allocations/op" << std::endl;
+		return result;
+	}
+
+} // namespace flex::benchmarks
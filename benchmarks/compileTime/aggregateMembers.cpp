@@ -0,0 +1,34 @@
+#include <cstddef>
+#include <iostream>
+#include <utility>
+
+#include <flex/reflection/reflection.hpp>
+
+// generated by benchmarks/CMakeLists.txt, defines the aggregate `BenchmarkAggregate` with
+// `FLEX_BENCHMARK_AGGREGATE_SIZE` members `m0`, `m1`, ... alternating `int` and `double`, and the
+// name of the last one in `BENCHMARK_AGGREGATE_LAST_NAME`
+#include "benchmarkAggregate.hpp"
+
+
+static_assert(flex::reflection_members_count_v<BenchmarkAggregate> == FLEX_BENCHMARK_AGGREGATE_SIZE);
+static_assert(std::tuple_size_v<flex::reflection_members_t<BenchmarkAggregate>> == FLEX_BENCHMARK_AGGREGATE_SIZE);
+static_assert(flex::reflection_members_names_v<BenchmarkAggregate>.back() == BENCHMARK_AGGREGATE_LAST_NAME);
+
+
+/*
+ * The interesting figure is the compile time, printed by the build. Running the executable writes
+ * each member through the reflection, so that all the accessors get instantiated.
+ * */
+auto main() -> int {
+	BenchmarkAggregate aggregate {};
+	std::size_t touched {0};
+	[&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+		((flex::reflection_traits<BenchmarkAggregate>::getMember<INDICES> (aggregate) = static_cast<int> (INDICES), ++touched), ...);
+	}(std::make_index_sequence<FLEX_BENCHMARK_AGGREGATE_SIZE> {});
+
+	std::cout << "aggregate of " << FLEX_BENCHMARK_AGGREGATE_SIZE << " members :\n"
+		<< "    members found : " << flex::reflection_members_count_v<BenchmarkAggregate> << "\n"
+		<< "    members written : " << touched << "\n"
+		<< "    last member : " << flex::reflection_traits<BenchmarkAggregate>::getMember<FLEX_BENCHMARK_AGGREGATE_SIZE - 1> (aggregate) << std::endl;
+	return 0;
+}
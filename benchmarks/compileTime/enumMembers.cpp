@@ -0,0 +1,29 @@
+#include <iostream>
+
+#include <flex/reflection/enums.hpp>
+
+// generated by benchmarks/CMakeLists.txt, defines `BenchmarkEnum` with `FLEX_BENCHMARK_ENUM_SIZE`
+// enumerators, from `-FLEX_BENCHMARK_ENUM_SIZE / 2` onward
+#include "benchmarkEnum.hpp"
+
+
+static_assert(flex::enum_members_count_v<BenchmarkEnum> == FLEX_BENCHMARK_ENUM_SIZE);
+static_assert(flex::toString(BenchmarkEnum::eValue0) == "eValue0");
+
+
+/*
+ * The interesting figure is the compile time, printed by the build. Running the executable prints
+ * how many instantiations the discovery needed.
+ * */
+auto main() -> int {
+	constexpr std::size_t candidates {flex::__internals::enum_candidates_count_v<BenchmarkEnum>};
+	constexpr std::size_t batches {
+		(candidates + flex::__internals::ENUM_PROBE_BATCH_SIZE - 1) / flex::__internals::ENUM_PROBE_BATCH_SIZE
+	};
+
+	std::cout << "enum of " << FLEX_BENCHMARK_ENUM_SIZE << " values :\n"
+		<< "    getEnumName instantiations : " << candidates << "\n"
+		<< "    batch instantiations : " << batches << "\n"
+		<< "    members found : " << flex::enum_members_count_v<BenchmarkEnum> << std::endl;
+	return 0;
+}
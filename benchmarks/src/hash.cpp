@@ -0,0 +1,69 @@
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <flex/hash.hpp>
+
+#include "benchmark.hpp"
+
+
+namespace {
+	struct Key {
+		std::uint64_t userId;
+		std::uint32_t shard;
+		std::uint32_t region;
+	};
+
+	/*
+	 * @brief The baseline : the hand written `std::hash` combination the keys used to have
+	 * */
+	auto hashByHand(const Key &key) noexcept -> std::size_t {
+		std::size_t seed {std::hash<std::uint64_t> {} (key.userId)};
+		seed ^= std::hash<std::uint32_t> {} (key.shard) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+		seed ^= std::hash<std::uint32_t> {} (key.region) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+		return seed;
+	}
+
+} // namespace
+
+
+auto main() -> int {
+	constexpr std::size_t COUNT {1'000'000};
+	std::mt19937_64 generator {42};
+	std::vector<Key> keys (COUNT);
+	for (auto &key : keys)
+		key = Key{generator(), static_cast<std::uint32_t> (generator() % 64), static_cast<std::uint32_t> (generator() % 8)};
+
+	std::vector<std::size_t> hashes (COUNT);
+	const auto byHand {flex::benchmarks::run("hand written std::hash", 50, [&]() {
+		for (std::size_t i {0}; i < COUNT; ++i)
+			hashes[i] = hashByHand(keys[i]);
+		flex::benchmarks::doNotOptimize(hashes);
+	})};
+
+	const flex::hash<Key> hasher {};
+	const auto single {flex::benchmarks::run("flex::hash", 50, [&]() {
+		for (std::size_t i {0}; i < COUNT; ++i)
+			hashes[i] = hasher(keys[i]);
+		flex::benchmarks::doNotOptimize(hashes);
+	})};
+
+	const auto batch {flex::benchmarks::run("flex::hash_batch", 50, [&]() {
+		flex::hash_batch(std::span<const Key> {keys}, std::span{hashes});
+		flex::benchmarks::doNotOptimize(hashes);
+	})};
+
+	for (std::size_t i {0}; i < COUNT; ++i) {
+		if (hashes[i] != hasher(keys[i])) {
+			std::cerr << "result mismatch" << std::endl;
+			return 1;
+		}
+	}
+
+	std::cout << "    " << byHand.nanosecondsPerIteration / static_cast<double> (COUNT) << " / "
+		<< single.nanosecondsPerIteration / static_cast<double> (COUNT) << " / "
+		<< batch.nanosecondsPerIteration / static_cast<double> (COUNT) << " ns/key" << std::endl;
+	return 0;
+}
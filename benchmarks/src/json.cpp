@@ -0,0 +1,271 @@
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <flex/json.hpp>
+
+#include "benchmark.hpp"
+
+
+namespace {
+	struct Route {
+		std::string path;
+		std::string method;
+		std::uint32_t timeoutMilliseconds;
+		bool authenticated;
+		double weight;
+	};
+
+	struct Service {
+		std::string name;
+		std::string host;
+		std::uint16_t port;
+		std::vector<std::string> tags;
+		std::vector<Route> routes;
+		std::optional<std::string> description;
+	};
+
+	struct Payload {
+		std::uint64_t version;
+		std::vector<Service> services;
+	};
+
+
+	auto makePayload() -> Payload {
+		Payload payload {.version = 42, .services = {}};
+		for (std::size_t i {0}; i < 32; ++i) {
+			Service service {
+				.name = "service-" + std::to_string(i),
+				.host = "10.0.0." + std::to_string(i),
+				.port = static_cast<std::uint16_t> (8000 + i),
+				.tags = {"internal", "v2", "team-" + std::to_string(i % 4)},
+				.routes = {},
+				.description = i % 2 == 0 ? std::optional<std::string> {"handles \"things\""} : std::nullopt
+			};
+			for (std::size_t j {0}; j < 8; ++j) {
+				service.routes.push_back({
+					.path = "/api/v1/resource/" + std::to_string(j),
+					.method = j % 2 == 0 ? "GET" : "POST",
+					.timeoutMilliseconds = static_cast<std::uint32_t> (250 * (j + 1)),
+					.authenticated = j % 3 != 0,
+					.weight = 0.125 * static_cast<double> (j)
+				});
+			}
+			payload.services.push_back(std::move(service));
+		}
+		return payload;
+	}
+
+
+	/*
+	 * @brief The baseline : a stream writer quoting keys at runtime and a DOM parser with
+	 *        `std::map` objects, the fields being looked up afterwards
+	 * */
+	namespace naive {
+		auto writeString(std::ostringstream &stream, const std::string &string) -> void {
+			stream << '"';
+			for (char character : string) {
+				if (character == '"' || character == '\\')
+					stream << '\\';
+				stream << character;
+			}
+			stream << '"';
+		}
+
+		auto write(const Payload &payload) -> std::string {
+			std::ostringstream stream {};
+			stream << "{\"version\":" << payload.version << ",\"services\":[";
+			for (std::size_t i {0}; i < payload.services.size(); ++i) {
+				const Service &service {payload.services[i]};
+				stream << (i == 0 ? "" : ",") << "{";
+				stream << "\"name\":"; writeString(stream, service.name);
+				stream << ",\"host\":"; writeString(stream, service.host);
+				stream << ",\"port\":" << service.port << ",\"tags\":[";
+				for (std::size_t j {0}; j < service.tags.size(); ++j) {
+					stream << (j == 0 ? "" : ",");
+					writeString(stream, service.tags[j]);
+				}
+				stream << "],\"routes\":[";
+				for (std::size_t j {0}; j < service.routes.size(); ++j) {
+					const Route &route {service.routes[j]};
+					stream << (j == 0 ? "" : ",") << "{\"path\":";
+					writeString(stream, route.path);
+					stream << ",\"method\":";
+					writeString(stream, route.method);
+					stream << ",\"timeoutMilliseconds\":" << route.timeoutMilliseconds
+						<< ",\"authenticated\":" << (route.authenticated ? "true" : "false")
+						<< ",\"weight\":" << route.weight << "}";
+				}
+				stream << "],\"description\":";
+				if (service.description)
+					writeString(stream, *service.description);
+				else
+					stream << "null";
+				stream << "}";
+			}
+			stream << "]}";
+			return stream.str();
+		}
+
+
+		struct Value {
+			std::variant<std::nullptr_t, bool, double, std::string, std::vector<Value>, std::map<std::string, Value>> data;
+		};
+
+		struct Parser {
+			std::string_view input;
+			std::size_t position;
+
+			auto skip() -> void {
+				while (position < input.size() && std::isspace(static_cast<unsigned char> (input[position])))
+					++position;
+			}
+
+			auto parseString() -> std::string {
+				std::string result {};
+				++position;
+				while (input[position] != '"') {
+					if (input[position] == '\\')
+						++position;
+					result += input[position++];
+				}
+				++position;
+				return result;
+			}
+
+			auto parse() -> Value {
+				this->skip();
+				const char character {input[position]};
+				if (character == '{') {
+					++position;
+					std::map<std::string, Value> object {};
+					this->skip();
+					while (input[position] != '}') {
+						this->skip();
+						std::string key {this->parseString()};
+						this->skip();
+						++position;
+						object[key] = this->parse();
+						this->skip();
+						if (input[position] == ',')
+							++position;
+					}
+					++position;
+					return Value{std::move(object)};
+				}
+				if (character == '[') {
+					++position;
+					std::vector<Value> array {};
+					this->skip();
+					while (input[position] != ']') {
+						array.push_back(this->parse());
+						this->skip();
+						if (input[position] == ',')
+							++position;
+					}
+					++position;
+					return Value{std::move(array)};
+				}
+				if (character == '"')
+					return Value{this->parseString()};
+				if (input.substr(position, 4) == "true") {
+					position += 4;
+					return Value{true};
+				}
+				if (input.substr(position, 5) == "false") {
+					position += 5;
+					return Value{false};
+				}
+				if (input.substr(position, 4) == "null") {
+					position += 4;
+					return Value{nullptr};
+				}
+				char *end {};
+				const double number {std::strtod(input.data() + position, &end)};
+				position = static_cast<std::size_t> (end - input.data());
+				return Value{number};
+			}
+		};
+
+		auto field(const Value &object, const std::string &name) -> const Value& {
+			return std::get<std::map<std::string, Value>> (object.data).at(name);
+		}
+
+		auto read(std::string_view input) -> Payload {
+			const Value root {Parser{input, 0}.parse()};
+			Payload payload {};
+			payload.version = static_cast<std::uint64_t> (std::get<double> (field(root, "version").data));
+			for (const Value &serviceValue : std::get<std::vector<Value>> (field(root, "services").data)) {
+				Service service {};
+				service.name = std::get<std::string> (field(serviceValue, "name").data);
+				service.host = std::get<std::string> (field(serviceValue, "host").data);
+				service.port = static_cast<std::uint16_t> (std::get<double> (field(serviceValue, "port").data));
+				for (const Value &tag : std::get<std::vector<Value>> (field(serviceValue, "tags").data))
+					service.tags.push_back(std::get<std::string> (tag.data));
+				for (const Value &routeValue : std::get<std::vector<Value>> (field(serviceValue, "routes").data)) {
+					service.routes.push_back({
+						.path = std::get<std::string> (field(routeValue, "path").data),
+						.method = std::get<std::string> (field(routeValue, "method").data),
+						.timeoutMilliseconds = static_cast<std::uint32_t> (std::get<double> (field(routeValue, "timeoutMilliseconds").data)),
+						.authenticated = std::get<bool> (field(routeValue, "authenticated").data),
+						.weight = std::get<double> (field(routeValue, "weight").data)
+					});
+				}
+				if (const auto *description {std::get_if<std::string> (&field(serviceValue, "description").data)}; description)
+					service.description = *description;
+				payload.services.push_back(std::move(service));
+			}
+			return payload;
+		}
+
+	} // namespace naive
+
+
+	auto printThroughput(const flex::benchmarks::Result &result, std::size_t bytes) -> void {
+		std::cout << "    " << static_cast<double> (bytes) / result.nanosecondsPerIteration * 1e3 << " MB/s" << std::endl;
+	}
+
+} // namespace
+
+
+auto main() -> int {
+	constexpr std::size_t ITERATIONS {2'000};
+	const Payload payload {makePayload()};
+	const std::string json {flex::json::write(payload)};
+	std::cout << "payload : " << json.size() << " bytes" << std::endl;
+
+	const auto parsed {flex::json::read<Payload> (json)};
+	if (!parsed || flex::json::write(*parsed) != json || flex::json::write(naive::read(naive::write(payload))) != json) {
+		std::cerr << "round trip mismatch" << std::endl;
+		return 1;
+	}
+
+	std::string output {};
+	printThroughput(flex::benchmarks::run("flex::json::write", ITERATIONS, [&]() {
+		output.clear();
+		flex::json::write(payload, output);
+		flex::benchmarks::doNotOptimize(output);
+	}), json.size());
+
+	printThroughput(flex::benchmarks::run("naive write", ITERATIONS, [&]() {
+		const std::string result {naive::write(payload)};
+		flex::benchmarks::doNotOptimize(result);
+	}), json.size());
+
+	printThroughput(flex::benchmarks::run("flex::json::read", ITERATIONS, [&]() {
+		const auto result {flex::json::read<Payload> (json)};
+		flex::benchmarks::doNotOptimize(result);
+	}), json.size());
+
+	printThroughput(flex::benchmarks::run("naive read", ITERATIONS, [&]() {
+		const Payload result {naive::read(json)};
+		flex::benchmarks::doNotOptimize(result);
+	}), json.size());
+
+	return 0;
+}
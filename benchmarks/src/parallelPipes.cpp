@@ -0,0 +1,42 @@
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <flex/pipes/parallel.hpp>
+#include <flex/pipes/toNumber.hpp>
+#include <flex/pipes/transform.hpp>
+#include <flex/pipes/valueOr.hpp>
+
+#include "benchmark.hpp"
+
+
+auto main() -> int {
+	constexpr std::size_t COUNT {2'000'000};
+	std::vector<std::string> fields (COUNT);
+	for (std::size_t i {0}; i < COUNT; ++i)
+		fields[i] = (i % 100 == 0 ? "x" : "") + std::to_string(i * 7919 % 1'000'003);
+
+	auto pipeline {flex::pipes::to_number<std::int64_t> ()
+		| flex::pipes::transform([](std::int64_t value) {return value * 3 + 1;})
+	};
+
+	std::vector<std::optional<std::int64_t>> sequentialResults (COUNT);
+	const auto sequential {flex::benchmarks::run("sequential", 10, [&]() {
+		flex::pipes::apply_into(fields, pipeline, sequentialResults.begin());
+		flex::benchmarks::doNotOptimize(sequentialResults);
+	})};
+
+	flex::pipes::ParallelResults<std::optional<std::int64_t>> parallelResults {};
+	const auto parallel {flex::benchmarks::run("flex::pipes::par", 10, [&]() {
+		parallelResults = fields | flex::pipes::par(pipeline);
+		flex::benchmarks::doNotOptimize(parallelResults);
+	})};
+
+	if (parallelResults.results != sequentialResults || parallelResults.failedIndices.size() != COUNT / 100) {
+		std::cerr << "result mismatch" << std::endl;
+		return 1;
+	}
+	std::cout << "    x" << sequential.nanosecondsPerIteration / parallel.nanosecondsPerIteration
+		<< " on " << flex::ThreadPool::getDefault().getThreadsCount() << " threads" << std::endl;
+	return 0;
+}
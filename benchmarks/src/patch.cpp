@@ -0,0 +1,71 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <flex/patch.hpp>
+#include <flex/serialization.hpp>
+
+#include "benchmark.hpp"
+
+
+namespace {
+	struct Player {
+		std::uint32_t id;
+		float x;
+		float y;
+		float z;
+		std::int32_t health;
+		std::int32_t mana;
+		std::string name;
+		std::vector<std::uint32_t> inventory;
+	};
+
+	struct World {
+		std::uint64_t tick;
+		Player player0;
+		Player player1;
+		Player player2;
+		Player player3;
+		std::vector<std::uint32_t> events;
+	};
+
+	auto makePlayer(std::uint32_t id) -> Player {
+		return Player{id, 1.f, 2.f, 3.f, 100, 50, "player " + std::to_string(id), std::vector<std::uint32_t> (64, id)};
+	}
+
+} // namespace
+
+
+auto main() -> int {
+	const World previous {1, makePlayer(0), makePlayer(1), makePlayer(2), makePlayer(3), std::vector<std::uint32_t> (256, 0)};
+	World current {previous};
+	// a typical tick : the clock and one player moving
+	current.tick = 2;
+	current.player2.x += 0.25f;
+	current.player2.z -= 0.5f;
+
+	std::vector<std::byte> snapshot {};
+	std::vector<std::byte> patch {};
+
+	const auto snapshots {flex::benchmarks::run("flex::serialize", 100'000, [&]() {
+		snapshot.clear();
+		flex::serialize(current, snapshot);
+		flex::benchmarks::doNotOptimize(snapshot);
+	})};
+
+	const auto patches {flex::benchmarks::run("flex::makePatch", 100'000, [&]() {
+		patch.clear();
+		flex::makePatch(previous, current, patch);
+		flex::benchmarks::doNotOptimize(patch);
+	})};
+
+	World patched {previous};
+	if (!flex::applyPatch(patched, patch) || !flex::equal(patched, current)) {
+		std::cerr << "result mismatch" << std::endl;
+		return 1;
+	}
+
+	std::cout << "    " << snapshot.size() << " bytes in " << snapshots.nanosecondsPerIteration << " ns against "
+		<< patch.size() << " bytes in " << patches.nanosecondsPerIteration << " ns" << std::endl;
+	return 0;
+}
@@ -0,0 +1,80 @@
+#include <array>
+#include <format>
+#include <sstream>
+#include <string>
+
+#include <flex/logger.hpp>
+
+#include "benchmark.hpp"
+
+
+namespace {
+	struct Vector3 {
+		float x;
+		float y;
+		float z;
+	};
+
+	struct Entity {
+		std::string name;
+		std::uint32_t id;
+		double health;
+		bool alive;
+		Vector3 position;
+	};
+
+	/*
+	 * @brief The former approach : a stream per struct, nested members through `std::vformat`
+	 * */
+	template <flex::reflectable T>
+	auto naiveFormat(std::ostringstream &stream, const T &value) -> void {
+		stream << "{";
+		[&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+			((
+				stream << std::get<INDICES> (flex::reflection_members_names_v<T>) << ": ",
+				[&]() {
+					const auto &member {flex::reflection_traits<T>::template getMember<INDICES> (value)};
+					if constexpr (flex::is_reflectable_v<std::remove_cvref_t<decltype(member)>>) {
+						std::ostringstream nested {};
+						naiveFormat(nested, member);
+						stream << std::vformat("{}", std::make_format_args(nested.str()));
+					}
+					else
+						stream << std::vformat("{}", std::make_format_args(member));
+				}(),
+				stream << (INDICES + 1 < sizeof...(INDICES) ? ", " : "")
+			), ...);
+		}(std::make_index_sequence<flex::reflection_members_count_v<T>> {});
+		stream << "}";
+	}
+
+} // namespace
+
+
+auto main() -> int {
+	constexpr std::size_t ITERATIONS {200'000};
+	const Entity entity {"player", 42, 87.5, true, {1.f, 2.5f, -3.f}};
+	std::array<char, 512> buffer {};
+
+	const auto direct {flex::benchmarks::run("std::format_to, flex formatter", ITERATIONS, [&]() {
+		const auto end {std::format_to(buffer.data(), "{}", entity)};
+		flex::benchmarks::doNotOptimize(end);
+	})};
+
+	const auto indented {flex::benchmarks::run("std::format_to, flex formatter, indented", ITERATIONS, [&]() {
+		const auto end {std::format_to(buffer.data(), "{:4}", entity)};
+		flex::benchmarks::doNotOptimize(end);
+	})};
+
+	(void)flex::benchmarks::run("std::ostringstream baseline", ITERATIONS, [&]() {
+		std::ostringstream stream {};
+		naiveFormat(stream, entity);
+		flex::benchmarks::doNotOptimize(stream);
+	});
+
+	if (direct.allocationsPerIteration != 0.0 || indented.allocationsPerIteration != 0.0) {
+		std::cerr << "the reflectable formatter allocated memory" << std::endl;
+		return 1;
+	}
+	return 0;
+}
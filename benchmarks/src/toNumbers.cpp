@@ -0,0 +1,74 @@
+#include <charconv>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <flex/pipes/toNumber.hpp>
+
+#include "benchmark.hpp"
+
+
+namespace {
+	auto makeLine(std::size_t count) -> std::string {
+		std::mt19937_64 generator {42};
+		std::uniform_int_distribution<std::int64_t> distribution {-1'000'000'000'000, 1'000'000'000'000};
+		std::string line {};
+		for (std::size_t i {0}; i < count; ++i) {
+			if (i != 0)
+				line += ',';
+			line += std::to_string(distribution(generator));
+		}
+		return line;
+	}
+
+
+	/*
+	 * @brief The baseline : a scan for the delimiter and a `std::from_chars` per field
+	 * */
+	auto parseNaive(std::string_view line, std::vector<std::int64_t> &output) -> bool {
+		std::size_t start {0};
+		while (true) {
+			const std::size_t end {std::min(line.find(',', start), line.size())};
+			std::int64_t value {};
+			const auto [ptr, err] {std::from_chars(line.data() + start, line.data() + end, value)};
+			if (err != std::errc{} || ptr != line.data() + end)
+				return false;
+			output.push_back(value);
+			if (end == line.size())
+				return true;
+			start = end + 1;
+		}
+	}
+
+} // namespace
+
+
+auto main() -> int {
+	constexpr std::size_t FIELDS {100'000};
+	const std::string line {makeLine(FIELDS)};
+
+	std::vector<std::int64_t> expected {};
+	std::vector<std::int64_t> values {};
+	if (!parseNaive(line, expected) || flex::pipes::to_numbers<std::int64_t> (line, ',', values) != FIELDS || values != expected) {
+		std::cerr << "result mismatch" << std::endl;
+		return 1;
+	}
+
+	std::vector<std::int64_t> buffer (FIELDS);
+	const auto flex {flex::benchmarks::run("flex::pipes::to_numbers", 200, [&]() {
+		const auto count {flex::pipes::to_numbers<std::int64_t> (line, ',', std::span{buffer})};
+		flex::benchmarks::doNotOptimize(count);
+	})};
+
+	const auto naive {flex::benchmarks::run("find + from_chars", 200, [&]() {
+		values.clear();
+		const bool success {parseNaive(line, values)};
+		flex::benchmarks::doNotOptimize(success);
+	})};
+
+	std::cout << "    " << static_cast<double> (line.size()) / flex.nanosecondsPerIteration * 1e3 << " MB/s against "
+		<< static_cast<double> (line.size()) / naive.nanosecondsPerIteration * 1e3 << " MB/s" << std::endl;
+	return 0;
+}
@@ -0,0 +1,50 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <flex/pipes/toString.hpp>
+
+#include "benchmark.hpp"
+
+
+auto main() -> int {
+	constexpr std::size_t COUNT {10'000};
+	std::mt19937_64 generator {42};
+	std::uniform_int_distribution<std::int64_t> distribution {-1'000'000'000, 1'000'000'000};
+	std::vector<std::int64_t> numbers (COUNT);
+	for (auto &number : numbers)
+		number = distribution(generator);
+
+	std::string output {};
+	const auto batch {flex::benchmarks::run("flex::pipes::to_strings", 500, [&]() {
+		output.clear();
+		flex::pipes::to_strings(numbers, ',', output);
+		flex::benchmarks::doNotOptimize(output);
+	})};
+
+	flex::pipes::NumberString<std::int64_t> string {};
+	flex::benchmarks::run("flex::pipes::to_string_into", 500, [&]() {
+		for (std::int64_t number : numbers) {
+			string.clear();
+			const auto written {number | flex::pipes::to_string_into(string)};
+			flex::benchmarks::doNotOptimize(written);
+		}
+	});
+
+	const auto perNumber {flex::benchmarks::run("flex::pipes::to_string", 500, [&]() {
+		for (std::int64_t number : numbers) {
+			const std::string result {number | flex::pipes::to_string()};
+			flex::benchmarks::doNotOptimize(result);
+		}
+	})};
+
+	flex::benchmarks::run("std::to_string", 500, [&]() {
+		for (std::int64_t number : numbers) {
+			const std::string result {std::to_string(number)};
+			flex::benchmarks::doNotOptimize(result);
+		}
+	});
+
+	return batch.allocationsPerIteration == 0 && perNumber.allocationsPerIteration == 0 ? 0 : 1;
+}
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "flex/reflection/layout.hpp"
+#include "flex/reflection/reflection.hpp"
+#include "flex/typeTraits.hpp"
+
+
+/*
+ * Comparison
+ *
+ * `flex::equal`, `flex::compare` and `flex::diff` are generated for the reflectable types, the
+ * ranges, the tuples and the optionals, member by member and in declaration order.
+ *
+ * Runs of trivially comparable members, whose values are equal exactly when their bytes are, are
+ * first checked with a single `memcmp`. `equal` and `compare` stop at the first difference.
+ * */
+namespace flex {
+	namespace __internals {
+		template <typename T>
+		auto equalValue(const T &lhs, const T &rhs) noexcept -> bool;
+
+		template <typename T>
+		auto compareValue(const T &lhs, const T &rhs) noexcept;
+
+
+		/*
+		 * @brief Whether the bytes of the block `SEGMENT` of `lhs` and `rhs` are the same. Only
+		 *        meaningful when `isContiguousBlock<SEGMENT>` holds
+		 * */
+		template <MembersSegment SEGMENT, flex::reflectable T>
+		auto equalBlock(const T &lhs, const T &rhs) noexcept -> bool {
+			return std::memcmp(
+				std::addressof(getMemberValue<SEGMENT.first> (lhs)),
+				std::addressof(getMemberValue<SEGMENT.first> (rhs)),
+				SEGMENT.size
+			) == 0;
+		}
+
+
+		template <flex::reflectable T>
+		auto equalMembers(const T &lhs, const T &rhs) noexcept -> bool {
+			return forEachMembersSegment<T> ([&]<MembersSegment SEGMENT> () {
+				if constexpr (SEGMENT.isBlock) {
+					if (isContiguousBlock<SEGMENT> (lhs))
+						return equalBlock<SEGMENT> (lhs, rhs);
+				}
+				return [&]<std::size_t ...OFFSETS>(std::index_sequence<OFFSETS...>) {
+					return (equalValue(getMemberValue<SEGMENT.first + OFFSETS> (lhs), getMemberValue<SEGMENT.first + OFFSETS> (rhs)) && ...);
+				}(std::make_index_sequence<SEGMENT.last - SEGMENT.first> {});
+			});
+		}
+
+		template <typename T>
+		auto equalValue(const T &lhs, const T &rhs) noexcept -> bool {
+			if constexpr (is_trivially_comparable_v<T>)
+				return std::memcmp(std::addressof(lhs), std::addressof(rhs), sizeof(T)) == 0;
+			else if constexpr (flex::arithmetic<T>)
+				return lhs == rhs;
+			else if constexpr (flex::optional<T>) {
+				if (lhs.has_value() != rhs.has_value())
+					return false;
+				return !lhs.has_value() || equalValue(*lhs, *rhs);
+			}
+			else if constexpr (flex::tuple<T> || flex::pair<T>) {
+				return [&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					return (equalValue(std::get<INDICES> (lhs), std::get<INDICES> (rhs)) && ...);
+				}(std::make_index_sequence<std::tuple_size_v<T>> {});
+			}
+			else if constexpr (trivially_comparable_range<T>) {
+				const std::size_t size {static_cast<std::size_t> (std::ranges::size(lhs))};
+				return size == static_cast<std::size_t> (std::ranges::size(rhs))
+					&& (size == 0 || std::memcmp(std::ranges::data(lhs), std::ranges::data(rhs), size * sizeof(std::ranges::range_value_t<T>)) == 0);
+			}
+			else if constexpr (std::ranges::input_range<const T>) {
+				if constexpr (std::ranges::sized_range<const T>) {
+					if (std::ranges::size(lhs) != std::ranges::size(rhs))
+						return false;
+				}
+				return std::ranges::equal(lhs, rhs, [](const auto &lhsElement, const auto &rhsElement) {
+					return equalValue(lhsElement, rhsElement);
+				});
+			}
+			else if constexpr (flex::reflectable<T>)
+				return equalMembers(lhs, rhs);
+			else
+				return lhs == rhs;
+		}
+
+
+		template <flex::reflectable T, typename Indices = std::make_index_sequence<flex::reflection_members_count_v<T>>>
+		struct members_comparison_category;
+
+		template <flex::reflectable T, std::size_t ...INDICES>
+		struct members_comparison_category<T, std::index_sequence<INDICES...>> {
+			using type = std::common_comparison_category_t<decltype(compareValue(
+				std::declval<const reflection_member_value_t<INDICES, T>&> (),
+				std::declval<const reflection_member_value_t<INDICES, T>&> ()
+			))...>;
+		};
+
+		template <flex::reflectable T>
+		auto compareMembers(const T &lhs, const T &rhs) noexcept {
+			using Result = typename members_comparison_category<T>::type;
+			Result result {Result::equivalent};
+			forEachMembersSegment<T> ([&]<MembersSegment SEGMENT> () {
+				if constexpr (SEGMENT.isBlock) {
+					if (isContiguousBlock<SEGMENT> (lhs) && equalBlock<SEGMENT> (lhs, rhs))
+						return true;
+				}
+				// the bytes don't give the order, the first different member of the block does
+				return [&]<std::size_t ...OFFSETS>(std::index_sequence<OFFSETS...>) {
+					return ((result = compareValue(
+						getMemberValue<SEGMENT.first + OFFSETS> (lhs),
+						getMemberValue<SEGMENT.first + OFFSETS> (rhs)
+					), result == 0) && ...);
+				}(std::make_index_sequence<SEGMENT.last - SEGMENT.first> {});
+			});
+			return result;
+		}
+
+		template <typename T>
+		auto compareValue(const T &lhs, const T &rhs) noexcept {
+			if constexpr (flex::arithmetic<T> || std::is_enum_v<T> || flex::pointer<T>)
+				return lhs <=> rhs;
+			else if constexpr (flex::optional<T>) {
+				using Result = std::common_comparison_category_t<std::strong_ordering, decltype(compareValue(*lhs, *rhs))>;
+				if (!lhs.has_value() || !rhs.has_value())
+					return static_cast<Result> (lhs.has_value() <=> rhs.has_value());
+				return static_cast<Result> (compareValue(*lhs, *rhs));
+			}
+			else if constexpr (flex::tuple<T> || flex::pair<T>) {
+				return [&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					using Result = std::common_comparison_category_t<decltype(compareValue(std::get<INDICES> (lhs), std::get<INDICES> (rhs)))...>;
+					Result result {Result::equivalent};
+					(((result = compareValue(std::get<INDICES> (lhs), std::get<INDICES> (rhs))), result == 0) && ...);
+					return result;
+				}(std::make_index_sequence<std::tuple_size_v<T>> {});
+			}
+			else if constexpr (std::ranges::input_range<const T>) {
+				return std::lexicographical_compare_three_way(
+					std::ranges::begin(lhs), std::ranges::end(lhs),
+					std::ranges::begin(rhs), std::ranges::end(rhs),
+					[](const auto &lhsElement, const auto &rhsElement) {return compareValue(lhsElement, rhsElement);}
+				);
+			}
+			else if constexpr (flex::reflectable<T>)
+				return compareMembers(lhs, rhs);
+			else
+				return lhs <=> rhs;
+		}
+
+	} // namespace __internals
+
+
+	/*
+	 * @brief Whether `lhs` and `rhs` are equal, member by member
+	 * */
+	template <typename T>
+	[[nodiscard]]
+	auto equal(const T &lhs, const T &rhs) noexcept -> bool {
+		return __internals::equalValue(lhs, rhs);
+	}
+
+	/*
+	 * @brief The lexicographical order of `lhs` and `rhs`, member by member in declaration order
+	 * @return The common comparison category of the members, `std::partial_ordering` as soon as one
+	 *         of them is a floating point
+	 * */
+	template <typename T>
+	[[nodiscard]]
+	auto compare(const T &lhs, const T &rhs) noexcept {
+		return __internals::compareValue(lhs, rhs);
+	}
+
+	/*
+	 * @brief The indices of the members that differ between `lhs` and `rhs`
+	 *
+	 * `flex::Bitfield` is keyed by an enum, the members are keyed by their index so the result is a
+	 * `std::bitset` of `reflection_members_count_v<T>` bits.
+	 * */
+	template <flex::reflectable T>
+	[[nodiscard]]
+	auto diff(const T &lhs, const T &rhs) noexcept -> std::bitset<flex::reflection_members_count_v<T>> {
+		std::bitset<flex::reflection_members_count_v<T>> changes {};
+		__internals::forEachMembersSegment<T> ([&]<__internals::MembersSegment SEGMENT> () {
+			if constexpr (SEGMENT.isBlock) {
+				if (__internals::isContiguousBlock<SEGMENT> (lhs) && __internals::equalBlock<SEGMENT> (lhs, rhs))
+					return true;
+			}
+			[&]<std::size_t ...OFFSETS>(std::index_sequence<OFFSETS...>) {
+				(changes.set(SEGMENT.first + OFFSETS, !__internals::equalValue(
+					__internals::getMemberValue<SEGMENT.first + OFFSETS> (lhs),
+					__internals::getMemberValue<SEGMENT.first + OFFSETS> (rhs)
+				)), ...);
+			}(std::make_index_sequence<SEGMENT.last - SEGMENT.first> {});
+			return true;
+		});
+		return changes;
+	}
+
+} // namespace flex
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+
+namespace flex {
+	/*
+	 * @brief A bounded, lock-free queue that can be shared by several producers
+	 *
+	 * The implementation is the sequence-numbered ring of Dmitry Vyukov. Each cell
+	 * stores the ticket it is waiting for, so producers and consumers only contend
+	 * on their own cursor and never take a lock. Popping from several threads is
+	 * allowed, which is what makes "evict the oldest element" possible from a
+	 * producer while a dedicated consumer drains the ring.
+	 *
+	 * The capacity is rounded up to the next power of two.
+	 * */
+	template <typename T>
+	requires std::movable<T> && std::default_initializable<T>
+	class ConcurrentRingBuffer final {
+		static constexpr std::size_t CACHE_LINE_SIZE {64};
+
+		struct alignas(CACHE_LINE_SIZE) Cell {
+			std::atomic<std::size_t> sequence;
+			T value;
+		};
+
+		public:
+			ConcurrentRingBuffer(std::size_t capacity) :
+				m_mask {std::bit_ceil(capacity < 2 ? 2uz : capacity) - 1},
+				m_cells {std::make_unique<Cell[]> (m_mask + 1)},
+				m_pushCursor {0},
+				m_popCursor {0}
+			{
+				for (std::size_t i {0}; i <= m_mask; ++i)
+					m_cells[i].sequence.store(i, std::memory_order_relaxed);
+			}
+
+			~ConcurrentRingBuffer() = default;
+
+			ConcurrentRingBuffer(const ConcurrentRingBuffer<T>&) = delete;
+			auto operator=(const ConcurrentRingBuffer<T>&) -> ConcurrentRingBuffer<T>& = delete;
+			ConcurrentRingBuffer(ConcurrentRingBuffer<T>&&) = delete;
+			auto operator=(ConcurrentRingBuffer<T>&&) -> ConcurrentRingBuffer<T>& = delete;
+
+
+			/*
+			 * @brief Try to push a value in the ring
+			 * @return `false` if the ring was full. In that case `value` is left untouched
+			 * */
+			[[nodiscard]]
+			auto tryPush(T &&value) noexcept -> bool {
+				Cell *cell {nullptr};
+				std::size_t position {m_pushCursor.load(std::memory_order_relaxed)};
+				while (true) {
+					cell = &m_cells[position & m_mask];
+					const std::size_t sequence {cell->sequence.load(std::memory_order_acquire)};
+					const auto difference {static_cast<std::ptrdiff_t> (sequence) - static_cast<std::ptrdiff_t> (position)};
+					if (difference == 0) {
+						if (m_pushCursor.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+							break;
+					}
+					else if (difference < 0)
+						return false;
+					else
+						position = m_pushCursor.load(std::memory_order_relaxed);
+				}
+
+				cell->value = std::move(value);
+				cell->sequence.store(position + 1, std::memory_order_release);
+				return true;
+			}
+
+			/*
+			 * @brief Try to pop the oldest value of the ring
+			 * @return `std::nullopt` if the ring was empty
+			 * */
+			[[nodiscard]]
+			auto tryPop() noexcept -> std::optional<T> {
+				Cell *cell {nullptr};
+				std::size_t position {m_popCursor.load(std::memory_order_relaxed)};
+				while (true) {
+					cell = &m_cells[position & m_mask];
+					const std::size_t sequence {cell->sequence.load(std::memory_order_acquire)};
+					const auto difference {static_cast<std::ptrdiff_t> (sequence) - static_cast<std::ptrdiff_t> (position + 1)};
+					if (difference == 0) {
+						if (m_popCursor.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+							break;
+					}
+					else if (difference < 0)
+						return std::nullopt;
+					else
+						position = m_popCursor.load(std::memory_order_relaxed);
+				}
+
+				std::optional<T> result {std::move(cell->value)};
+				cell->sequence.store(position + m_mask + 1, std::memory_order_release);
+				return result;
+			}
+
+
+			[[nodiscard]]
+			constexpr auto getCapacity() const noexcept -> std::size_t {return m_mask + 1;}
+
+			/*
+			 * @brief An approximation of the amount of elements in the ring
+			 * @note The value is stale as soon as it is returned if other threads are working on the ring
+			 * */
+			[[nodiscard]]
+			auto getApproximateSize() const noexcept -> std::size_t {
+				const std::size_t pushed {m_pushCursor.load(std::memory_order_relaxed)};
+				const std::size_t popped {m_popCursor.load(std::memory_order_relaxed)};
+				return pushed > popped ? pushed - popped : 0;
+			}
+
+
+		private:
+			std::size_t m_mask;
+			std::unique_ptr<Cell[]> m_cells;
+			alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_pushCursor;
+			alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_popCursor;
+	};
+
+} // namespace flex
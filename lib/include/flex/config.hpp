@@ -1,6 +1,11 @@
 #pragma once
 
 
+#if defined(__unix__) || defined(__APPLE__)
+	#define FLEX_POSIX
+#endif
+
+
 #ifdef __cpp_exceptions
 	#define FLEX_TRY try
 	#define FLEX_CATCH(...) catch (__VA_ARGS__)
@@ -10,3 +15,18 @@
 	#define FLEX_CATCH(...) if (false)
 	#define FLEX_THROW(...) std::abort()
 #endif
+
+
+#define FLEX_LOG_LEVEL_VERBOSE 0
+#define FLEX_LOG_LEVEL_INFO 1
+#define FLEX_LOG_LEVEL_WARNING 2
+#define FLEX_LOG_LEVEL_ERROR 3
+#define FLEX_LOG_LEVEL_FATAL 4
+
+/*
+ * Logs below this level are removed at compile time, arguments evaluation included.
+ * The value is one of the `FLEX_LOG_LEVEL_*` macros.
+ * */
+#ifndef FLEX_LOG_COMPILE_MIN_LEVEL
+	#define FLEX_LOG_COMPILE_MIN_LEVEL FLEX_LOG_LEVEL_VERBOSE
+#endif
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+
+#include "flex/config.hpp"
+#include "flex/reflection/enums.hpp"
+
+
+namespace flex {
+	/*
+	 * @brief A fixed-size array with one `V` per enumerator of `E`, indexed through `enum_index`
+	 *
+	 * The values are stored and iterated in the declaration order of the enumerators. Indexing is
+	 * a table lookup when the values of `E` are dense, and a binary search otherwise.
+	 * */
+	template <flex::enumeration E, typename V>
+	class EnumArray final {
+		using Storage = std::array<V, flex::enum_members_count_v<E>>;
+
+		public:
+			using key_type = E;
+			using value_type = V;
+			using size_type = std::size_t;
+			using reference = V&;
+			using const_reference = const V&;
+			using iterator = typename Storage::iterator;
+			using const_iterator = typename Storage::const_iterator;
+
+			static constexpr std::size_t SIZE {flex::enum_members_count_v<E>};
+
+			constexpr EnumArray() = default;
+			constexpr ~EnumArray() = default;
+			constexpr EnumArray(const EnumArray&) = default;
+			constexpr auto operator=(const EnumArray&) -> EnumArray& = default;
+			constexpr EnumArray(EnumArray&&) noexcept = default;
+			constexpr auto operator=(EnumArray&&) noexcept -> EnumArray& = default;
+
+			explicit constexpr EnumArray(const V &value) {
+				m_values.fill(value);
+			}
+
+			/*
+			 * @brief Sets the listed enumerators, the others being value-initialized
+			 * */
+			constexpr EnumArray(std::initializer_list<std::pair<E, V>> values) {
+				for (const auto &[key, value] : values)
+					(*this)[key] = value;
+			}
+
+			constexpr auto operator==(const EnumArray&) const -> bool = default;
+
+			/*
+			 * @brief The enumerator stored at position `index`
+			 * */
+			static constexpr auto keyAt(std::size_t index) noexcept -> E {
+				return flex::enum_members_v<E>[index].value;
+			}
+
+			static constexpr auto contains(E key) noexcept -> bool {
+				return flex::enum_index(key) != SIZE;
+			}
+
+			/*
+			 * @brief The value of `key`, which must be an enumerator of `E`
+			 * */
+			constexpr auto operator[](E key) noexcept -> V& {return m_values[flex::enum_index(key)];}
+			constexpr auto operator[](E key) const noexcept -> const V& {return m_values[flex::enum_index(key)];}
+
+			constexpr auto at(E key) -> V& {
+				const std::size_t index {flex::enum_index(key)};
+				if (index == SIZE)
+					FLEX_THROW(std::out_of_range("flex::EnumArray::at : not an enumerator"));
+				return m_values[index];
+			}
+
+			constexpr auto at(E key) const -> const V& {
+				const std::size_t index {flex::enum_index(key)};
+				if (index == SIZE)
+					FLEX_THROW(std::out_of_range("flex::EnumArray::at : not an enumerator"));
+				return m_values[index];
+			}
+
+			constexpr auto fill(const V &value) -> void {m_values.fill(value);}
+
+			static constexpr auto size() noexcept -> std::size_t {return SIZE;}
+			static constexpr auto empty() noexcept -> bool {return SIZE == 0;}
+
+			constexpr auto data() noexcept -> V* {return m_values.data();}
+			constexpr auto data() const noexcept -> const V* {return m_values.data();}
+
+			constexpr auto begin() noexcept -> iterator {return m_values.begin();}
+			constexpr auto begin() const noexcept -> const_iterator {return m_values.begin();}
+			constexpr auto end() noexcept -> iterator {return m_values.end();}
+			constexpr auto end() const noexcept -> const_iterator {return m_values.end();}
+
+			/*
+			 * @brief A view of `std::pair<E, V&>`, in declaration order
+			 * */
+			constexpr auto items() noexcept {
+				return std::views::iota(0uz, SIZE) | std::views::transform([this](std::size_t index) {
+					return std::pair<E, V&> {keyAt(index), m_values[index]};
+				});
+			}
+
+			constexpr auto items() const noexcept {
+				return std::views::iota(0uz, SIZE) | std::views::transform([this](std::size_t index) {
+					return std::pair<E, const V&> {keyAt(index), m_values[index]};
+				});
+			}
+
+		private:
+			Storage m_values {};
+	};
+
+} // namespace flex
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+
+#include "flex/reflection/enums.hpp"
+
+
+namespace flex {
+	/*
+	 * @brief A set of enumerators of `E`, stored as one bit per enumerator
+	 *
+	 * The bit of an enumerator is its `enum_index`, so the iteration follows the declaration
+	 * order. Values that aren't enumerators of `E` are never contained.
+	 * */
+	template <flex::enumeration E>
+	class EnumSet final {
+		using Word = std::uint64_t;
+		static constexpr std::size_t WORD_BITS {sizeof(Word) * 8};
+
+		public:
+			static constexpr std::size_t CAPACITY {flex::enum_members_count_v<E>};
+			static constexpr std::size_t WORDS_COUNT {(CAPACITY + WORD_BITS - 1) / WORD_BITS};
+
+			class Iterator final {
+				public:
+					using value_type = E;
+					using difference_type = std::ptrdiff_t;
+					using iterator_category = std::forward_iterator_tag;
+
+					constexpr Iterator() noexcept = default;
+					constexpr Iterator(const EnumSet *set, std::size_t index) noexcept : m_set {set}, m_index {index} {}
+
+					constexpr auto operator*() const noexcept -> E {return flex::enum_members_v<E>[m_index].value;}
+					constexpr auto operator==(const Iterator &other) const noexcept -> bool {return m_index == other.m_index;}
+
+					constexpr auto operator++() noexcept -> Iterator& {
+						m_index = m_set->findNext(m_index + 1);
+						return *this;
+					}
+
+					constexpr auto operator++(int) noexcept -> Iterator {
+						auto tmp {*this};
+						++*this;
+						return tmp;
+					}
+
+				private:
+					const EnumSet *m_set {nullptr};
+					std::size_t m_index {CAPACITY};
+			};
+
+			using value_type = E;
+			using iterator = Iterator;
+			using const_iterator = Iterator;
+
+			constexpr EnumSet() noexcept = default;
+			constexpr ~EnumSet() = default;
+			constexpr EnumSet(const EnumSet&) noexcept = default;
+			constexpr auto operator=(const EnumSet&) noexcept -> EnumSet& = default;
+			constexpr EnumSet(EnumSet&&) noexcept = default;
+			constexpr auto operator=(EnumSet&&) noexcept -> EnumSet& = default;
+
+			constexpr EnumSet(std::initializer_list<E> values) noexcept {
+				for (E value : values)
+					this->insert(value);
+			}
+
+			constexpr auto operator==(const EnumSet&) const noexcept -> bool = default;
+
+			/*
+			 * @brief A set of every enumerator of `E`
+			 * */
+			static constexpr auto all() noexcept -> EnumSet {
+				EnumSet set {};
+				for (std::size_t index {0}; index < CAPACITY; ++index)
+					set.m_words[index / WORD_BITS] |= Word{1} << (index % WORD_BITS);
+				return set;
+			}
+
+			/*
+			 * @brief Adds `value`, returns whether it was added
+			 * */
+			constexpr auto insert(E value) noexcept -> bool {
+				const std::size_t index {flex::enum_index(value)};
+				if (index == CAPACITY)
+					return false;
+				Word &word {m_words[index / WORD_BITS]};
+				const Word bit {Word{1} << (index % WORD_BITS)};
+				const bool inserted {!(word & bit)};
+				word |= bit;
+				return inserted;
+			}
+
+			/*
+			 * @brief Removes `value`, returns whether it was there
+			 * */
+			constexpr auto erase(E value) noexcept -> bool {
+				const std::size_t index {flex::enum_index(value)};
+				if (index == CAPACITY)
+					return false;
+				Word &word {m_words[index / WORD_BITS]};
+				const Word bit {Word{1} << (index % WORD_BITS)};
+				const bool erased {!!(word & bit)};
+				word &= ~bit;
+				return erased;
+			}
+
+			constexpr auto contains(E value) const noexcept -> bool {
+				const std::size_t index {flex::enum_index(value)};
+				if (index == CAPACITY)
+					return false;
+				return !!(m_words[index / WORD_BITS] & (Word{1} << (index % WORD_BITS)));
+			}
+
+			constexpr auto size() const noexcept -> std::size_t {
+				std::size_t size {0};
+				for (Word word : m_words)
+					size += static_cast<std::size_t> (std::popcount(word));
+				return size;
+			}
+
+			constexpr auto empty() const noexcept -> bool {
+				for (Word word : m_words) {
+					if (word != 0)
+						return false;
+				}
+				return true;
+			}
+
+			constexpr auto clear() noexcept -> void {m_words = {};}
+
+			constexpr auto begin() const noexcept -> Iterator {return Iterator{this, this->findNext(0)};}
+			constexpr auto end() const noexcept -> Iterator {return Iterator{this, CAPACITY};}
+
+			constexpr auto operator|=(const EnumSet &other) noexcept -> EnumSet& {
+				for (std::size_t i {0}; i < WORDS_COUNT; ++i)
+					m_words[i] |= other.m_words[i];
+				return *this;
+			}
+
+			constexpr auto operator&=(const EnumSet &other) noexcept -> EnumSet& {
+				for (std::size_t i {0}; i < WORDS_COUNT; ++i)
+					m_words[i] &= other.m_words[i];
+				return *this;
+			}
+
+			constexpr auto operator-=(const EnumSet &other) noexcept -> EnumSet& {
+				for (std::size_t i {0}; i < WORDS_COUNT; ++i)
+					m_words[i] &= ~other.m_words[i];
+				return *this;
+			}
+
+			constexpr auto operator|(const EnumSet &other) const noexcept -> EnumSet {auto tmp {*this}; return tmp |= other;}
+			constexpr auto operator&(const EnumSet &other) const noexcept -> EnumSet {auto tmp {*this}; return tmp &= other;}
+			constexpr auto operator-(const EnumSet &other) const noexcept -> EnumSet {auto tmp {*this}; return tmp -= other;}
+
+		private:
+			/*
+			 * @brief The first index from `index` whose bit is set, or `CAPACITY`
+			 * */
+			constexpr auto findNext(std::size_t index) const noexcept -> std::size_t {
+				while (index < CAPACITY) {
+					const Word word {m_words[index / WORD_BITS] >> (index % WORD_BITS)};
+					if (word != 0)
+						return index + static_cast<std::size_t> (std::countr_zero(word));
+					index = (index / WORD_BITS + 1) * WORD_BITS;
+				}
+				return CAPACITY;
+			}
+
+			std::array<Word, WORDS_COUNT> m_words {};
+	};
+
+} // namespace flex
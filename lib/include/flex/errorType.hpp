@@ -1,10 +1,16 @@
 #pragma once
 
+#include <concepts>
 #include <expected>
 #include <optional>
+#include <type_traits>
+#include <utility>
 
 
 namespace flex {
+	template <typename T>
+	struct error_type_traits;
+
 	namespace __internals {
 		template <typename T>
 		concept autogen_error_type = requires(T v, const T cv) {
@@ -24,6 +30,49 @@ namespace flex {
 			{cv.getError()} -> std::same_as<std::add_lvalue_reference_t<std::add_const_t<typename T::ErrorType>>>;
 		} && autogen_error_type<T>;
 
+
+		/*
+		 * @brief The autogen error types that opt in the pipes carrying failures, by declaring
+		 *        `template <typename U> using Rebind`, the same kind of type around a `U`, and a static
+		 *        `makeError()` building a failure, taking the error when the type has one. Their
+		 *        `Rebind` types must also be constructible from a value
+		 * */
+		template <typename T>
+		concept autogen_rebindable_error_type = autogen_error_type<T>
+			&& requires {typename std::type_identity<typename T::template Rebind<int>>::type;}
+			&& (autogen_error_type_with_error<T>
+				? requires(typename T::ErrorType error) {{T::makeError(std::move(error))} -> std::same_as<T>;}
+				: requires {{T::makeError()} -> std::same_as<T>;}
+			);
+
+
+		template <typename T>
+		struct autogen_error_type_rebind {};
+
+		template <autogen_rebindable_error_type T>
+		struct autogen_error_type_rebind<T> {
+			template <typename U>
+			using Rebind = T::template Rebind<U>;
+
+			/*
+			 * @brief A failure built by `T::makeError`, with the error of `source` when `T` has one
+			 * */
+			template <typename Source>
+			[[nodiscard]]
+			static constexpr auto fromErrorOf([[maybe_unused]] Source &&source) -> T {
+				if constexpr (autogen_error_type_with_error<T>) {
+					using SourceTraits = error_type_traits<std::remove_cvref_t<Source>>;
+					static_assert(std::same_as<typename SourceTraits::ErrorType, typename T::ErrorType>, "Only an error of the same type can be propagated");
+					if constexpr (std::is_rvalue_reference_v<Source&&>)
+						return T::makeError(std::move(SourceTraits::getError(source)));
+					else
+						return T::makeError(SourceTraits::getError(source));
+				}
+				else
+					return T::makeError();
+			}
+		};
+
 	} // namespace __internals
 
 
@@ -71,6 +120,16 @@ namespace flex {
 		template <typename U = std::remove_cvref_t<T>>
 		[[nodiscard]]
 		static constexpr auto getValueOr(const Type &instance, U &&defaultValue) noexcept -> ValueType {return instance.value_or(std::forward<U> (defaultValue));}
+
+		template <typename U>
+		using Rebind = std::optional<U>;
+
+		/*
+		 * @brief An empty instance, standing for the failure of `source`
+		 * */
+		template <typename Source>
+		[[nodiscard]]
+		static constexpr auto fromErrorOf(Source&&) noexcept -> Type {return std::nullopt;}
 	};
 
 
@@ -96,21 +155,38 @@ namespace flex {
 		static constexpr auto getValueOr(const Type &instance, U &&defaultValue) noexcept -> ValueType {return instance.value_or(std::forward<U> (defaultValue));}
 
 		[[nodiscard]]
-		static constexpr auto getError(Type &instance) noexcept -> ValueType& {return instance.error();}
+		static constexpr auto getError(Type &instance) noexcept -> ErrorType& {return instance.error();}
 		[[nodiscard]]
-		static constexpr auto getError(const Type &instance) noexcept -> const ValueType& {return instance.error();}
+		static constexpr auto getError(const Type &instance) noexcept -> const ErrorType& {return instance.error();}
 
-		template <typename G = std::remove_cvref_t<T>>
+		template <typename G = std::remove_cvref_t<E>>
 		[[nodiscard]]
 		static constexpr auto getErrorOr(Type &&instance, G &&defaultValue) noexcept -> ErrorType {return instance.error_or(std::forward<G> (defaultValue));}
-		template <typename G = std::remove_cvref_t<T>>
+		template <typename G = std::remove_cvref_t<E>>
 		[[nodiscard]]
 		static constexpr auto getErrorOr(const Type &instance, G &&defaultValue) noexcept -> ErrorType {return instance.error_or(std::forward<G> (defaultValue));}
+
+		template <typename U>
+		using Rebind = std::expected<U, E>;
+
+		/*
+		 * @brief An instance holding the error of `source`, which must hold one of type `E`
+		 * */
+		template <typename Source>
+		[[nodiscard]]
+		static constexpr auto fromErrorOf(Source &&source) -> Type {
+			using SourceTraits = error_type_traits<std::remove_cvref_t<Source>>;
+			static_assert(std::same_as<typename SourceTraits::ErrorType, E>, "Only an error of the same type can be propagated");
+			if constexpr (std::is_rvalue_reference_v<Source&&>)
+				return std::unexpected<E> (std::move(SourceTraits::getError(source)));
+			else
+				return std::unexpected<E> (SourceTraits::getError(source));
+		}
 	};
 
 
 	template <__internals::autogen_error_type T>
-	struct error_type_traits<T> {
+	struct error_type_traits<T> : __internals::autogen_error_type_rebind<T> {
 		static constexpr bool IS_ERROR_TYPE {true};
 		using Type = T;
 		using ValueType = T::ValueType;
@@ -133,7 +209,7 @@ namespace flex {
 
 
 	template <__internals::autogen_error_type_with_error T>
-	struct error_type_traits<T> {
+	struct error_type_traits<T> : __internals::autogen_error_type_rebind<T> {
 		static constexpr bool IS_ERROR_TYPE {true};
 		using Type = T;
 		using ValueType = T::ValueType;
@@ -154,9 +230,9 @@ namespace flex {
 		static constexpr auto getValueOr(const Type &instance, U &&defaultValue) noexcept -> ValueType {return !instance ? defaultValue : *instance;}
 
 		[[nodiscard]]
-		static constexpr auto getError(Type &instance) noexcept -> ValueType& {return instance.error();}
+		static constexpr auto getError(Type &instance) noexcept -> ErrorType& {return instance.getError();}
 		[[nodiscard]]
-		static constexpr auto getError(const Type &instance) noexcept -> const ValueType& {return instance.error();}
+		static constexpr auto getError(const Type &instance) noexcept -> const ErrorType& {return instance.getError();}
 
 		template <typename G = std::remove_cvref_t<T>>
 		[[nodiscard]]
@@ -193,4 +269,14 @@ namespace flex {
 	template <error_type_with_error T>
 	using error_type_error_t = typename error_type_traits<T>::ErrorType;
 
+
+	/*
+	 * @brief The error types whose traits can build the same kind of type around another value,
+	 *        and build an instance from the failure of another error type
+	 * */
+	template <typename T>
+	concept rebindable_error_type = error_type<T> && requires {
+		typename std::type_identity<typename error_type_traits<T>::template Rebind<int>>::type;
+	};
+
 } // namespace flex
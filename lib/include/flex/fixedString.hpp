@@ -0,0 +1,29 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+
+
+namespace flex {
+	/*
+	 * @brief A string literal usable as a template argument, like `get<"name">()`
+	 * */
+	template <std::size_t N>
+	struct FixedString {
+		char data[N] {};
+
+		constexpr FixedString(const char (&string)[N]) noexcept {
+			std::copy_n(string, N, data);
+		}
+
+		constexpr auto view() const noexcept -> std::string_view {
+			return std::string_view{data, N - 1};
+		}
+
+		constexpr operator std::string_view() const noexcept {
+			return this->view();
+		}
+	};
+
+} // namespace flex
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "flex/reflection/layout.hpp"
+#include "flex/reflection/reflection.hpp"
+#include "flex/typeTraits.hpp"
+
+
+/*
+ * Hashing
+ *
+ * `flex::hash<T>` is a drop-in for `std::hash<T>`, generated for the reflectable types, the ranges,
+ * the tuples and the optionals. Bytes are hashed with a wyhash-like 64 bits function.
+ *
+ * Types without padding whose equal values have equal bytes (`std::has_unique_object_representations`)
+ * are hashed as one block, and so are the runs of such members in a reflectable type and the
+ * contiguous ranges of such elements. Everything else is hashed element by element, each hash
+ * being the seed of the next one.
+ * */
+namespace flex {
+	template <typename T>
+	struct hash;
+
+
+	namespace __internals {
+		constexpr std::array<std::uint64_t, 4> HASH_SECRETS {
+			0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull
+		};
+
+	#ifdef __SIZEOF_INT128__
+		// `__extension__` keeps `-pedantic` quiet about the non standard type
+		__extension__ typedef unsigned __int128 uint128;
+	#endif
+
+		/*
+		 * @brief The xor of the two halves of the 128 bits product of `lhs` and `rhs`
+		 * */
+		constexpr auto hashMix(std::uint64_t lhs, std::uint64_t rhs) noexcept -> std::uint64_t {
+		#ifdef __SIZEOF_INT128__
+			const uint128 product {static_cast<uint128> (lhs) * rhs};
+			return static_cast<std::uint64_t> (product) ^ static_cast<std::uint64_t> (product >> 64);
+		#else
+			const std::uint64_t lhsHigh {lhs >> 32}, lhsLow {lhs & 0xffffffff};
+			const std::uint64_t rhsHigh {rhs >> 32}, rhsLow {rhs & 0xffffffff};
+			const std::uint64_t high {lhsHigh * rhsHigh}, middle0 {lhsHigh * rhsLow}, middle1 {lhsLow * rhsHigh}, low {lhsLow * rhsLow};
+			const std::uint64_t carry {((low >> 32) + (middle0 & 0xffffffff) + (middle1 & 0xffffffff)) >> 32};
+			return (low + (middle0 << 32) + (middle1 << 32)) ^ (high + (middle0 >> 32) + (middle1 >> 32) + carry);
+		#endif
+		}
+
+		inline auto hashRead64(const std::byte *data) noexcept -> std::uint64_t {
+			std::uint64_t value {};
+			std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		inline auto hashRead32(const std::byte *data) noexcept -> std::uint64_t {
+			std::uint32_t value {};
+			std::memcpy(&value, data, sizeof(value));
+			return value;
+		}
+
+		/*
+		 * @brief Hashes `size` bytes. With a `SIZE` known at compile time the branches on the size
+		 *        fold away, which is what `hash_batch` relies on to interleave the keys
+		 * */
+		template <std::size_t SIZE = std::dynamic_extent>
+		inline auto hashBytes(const std::byte *data, std::size_t size, std::uint64_t seed) noexcept -> std::uint64_t {
+			if constexpr (SIZE != std::dynamic_extent)
+				size = SIZE;
+
+			seed ^= hashMix(seed ^ HASH_SECRETS[0], HASH_SECRETS[1]);
+			std::uint64_t first {0};
+			std::uint64_t second {0};
+			if (size <= 16) {
+				if (size >= 4) {
+					const std::size_t shift {(size >> 3) << 2};
+					first = (hashRead32(data) << 32) | hashRead32(data + shift);
+					second = (hashRead32(data + size - 4) << 32) | hashRead32(data + size - 4 - shift);
+				}
+				else if (size > 0) {
+					first = (static_cast<std::uint64_t> (data[0]) << 16)
+						| (static_cast<std::uint64_t> (data[size >> 1]) << 8)
+						| static_cast<std::uint64_t> (data[size - 1]);
+				}
+			}
+			else {
+				std::size_t remaining {size};
+				if (remaining > 48) {
+					std::uint64_t seed1 {seed};
+					std::uint64_t seed2 {seed};
+					do {
+						seed = hashMix(hashRead64(data) ^ HASH_SECRETS[1], hashRead64(data + 8) ^ seed);
+						seed1 = hashMix(hashRead64(data + 16) ^ HASH_SECRETS[2], hashRead64(data + 24) ^ seed1);
+						seed2 = hashMix(hashRead64(data + 32) ^ HASH_SECRETS[3], hashRead64(data + 40) ^ seed2);
+						data += 48;
+						remaining -= 48;
+					} while (remaining > 48);
+					seed ^= seed1 ^ seed2;
+				}
+				while (remaining > 16) {
+					seed = hashMix(hashRead64(data) ^ HASH_SECRETS[1], hashRead64(data + 8) ^ seed);
+					data += 16;
+					remaining -= 16;
+				}
+				first = hashRead64(data + remaining - 16);
+				second = hashRead64(data + remaining - 8);
+			}
+			return hashMix(HASH_SECRETS[1] ^ size, hashMix(first ^ HASH_SECRETS[1], second ^ seed));
+		}
+
+
+		template <typename T>
+		auto hashValue(const T &value, std::uint64_t seed) noexcept -> std::uint64_t;
+
+		template <flex::reflectable T>
+		auto hashMembers(const T &value, std::uint64_t seed) noexcept -> std::uint64_t {
+			forEachMembersSegment<T> ([&]<MembersSegment SEGMENT> () {
+				if constexpr (SEGMENT.isBlock) {
+					if (isContiguousBlock<SEGMENT> (value)) {
+						const auto *first {reinterpret_cast<const std::byte*> (std::addressof(getMemberValue<SEGMENT.first> (value)))};
+						seed = hashBytes<SEGMENT.size> (first, SEGMENT.size, seed);
+						return true;
+					}
+				}
+				[&]<std::size_t ...OFFSETS>(std::index_sequence<OFFSETS...>) {
+					((seed = hashValue(getMemberValue<SEGMENT.first + OFFSETS> (value), seed)), ...);
+				}(std::make_index_sequence<SEGMENT.last - SEGMENT.first> {});
+				return true;
+			});
+			return seed;
+		}
+
+
+		template <typename T>
+		auto hashValue(const T &value, std::uint64_t seed) noexcept -> std::uint64_t {
+			if constexpr (is_trivially_comparable_v<T>)
+				return hashBytes<sizeof(T)> (reinterpret_cast<const std::byte*> (std::addressof(value)), sizeof(T), seed);
+			else if constexpr (std::floating_point<T>) {
+				// +0 and -0 are equal, and so are all the NaN as far as hashing goes
+				const T normalized {value == T{} ? T{} : (std::isnan(value) ? std::numeric_limits<T>::quiet_NaN() : value)};
+				return hashBytes<sizeof(T)> (reinterpret_cast<const std::byte*> (&normalized), sizeof(T), seed);
+			}
+			else if constexpr (std::same_as<T, bool>)
+				return hashValue(static_cast<std::uint8_t> (value), seed);
+			else if constexpr (flex::optional<T>) {
+				if (!value)
+					return hashValue(std::uint8_t{0}, seed);
+				return hashValue(*value, hashValue(std::uint8_t{1}, seed));
+			}
+			else if constexpr (flex::tuple<T> || flex::pair<T>)
+				return std::apply([&seed](const auto &...elements) {
+					((seed = hashValue(elements, seed)), ...);
+					return seed;
+				}, value);
+			else if constexpr (trivially_comparable_range<T>) {
+				return hashBytes(
+					reinterpret_cast<const std::byte*> (std::ranges::data(value)),
+					std::ranges::size(value) * sizeof(std::ranges::range_value_t<T>),
+					seed
+				);
+			}
+			else if constexpr (std::ranges::input_range<const T>) {
+				std::uint64_t count {0};
+				for (const auto &element : value) {
+					seed = hashValue(element, seed);
+					++count;
+				}
+				return hashValue(count, seed);
+			}
+			else if constexpr (flex::reflectable<T>)
+				return hashMembers(value, seed);
+			else if constexpr (requires {{std::hash<T> {} (value)} -> std::convertible_to<std::size_t>;})
+				return hashValue(static_cast<std::uint64_t> (std::hash<T> {} (value)), seed);
+			else {
+				static_assert(flex::false_v<T>, "T can't be hashed, specialize flex::hash<T>");
+				return seed;
+			}
+		}
+
+	} // namespace __internals
+
+
+	/*
+	 * @brief A `std::hash` like function object, generated from the reflection of `T`
+	 * */
+	template <typename T>
+	struct hash {
+		static constexpr bool IS_GENERATED {true};
+
+		[[nodiscard]]
+		auto operator()(const T &value) const noexcept -> std::size_t {
+			return static_cast<std::size_t> (__internals::hashValue(value, 0));
+		}
+	};
+
+
+	/*
+	 * @brief Hashes the `keys` into `output`, several keys at a time
+	 * @return The number of hashed keys, the smallest of the two sizes
+	 *
+	 * Keys that are hashed as a single block of known size go through several independent lanes
+	 * per iteration, so the multiplications of consecutive keys overlap instead of waiting on each
+	 * other. The results are the ones of `flex::hash<T>`, specializations included.
+	 * */
+	template <typename T>
+	auto hash_batch(std::span<const T> keys, std::span<std::size_t> output) noexcept -> std::size_t {
+		constexpr std::size_t LANES {4};
+		const std::size_t count {std::min(keys.size(), output.size())};
+		std::size_t i {0};
+		if constexpr (__internals::is_trivially_comparable_v<T> && requires {requires flex::hash<T>::IS_GENERATED;}) {
+			const auto *bytes {reinterpret_cast<const std::byte*> (keys.data())};
+			for (; i + LANES <= count; i += LANES) {
+				[&]<std::size_t ...LANE_INDICES>(std::index_sequence<LANE_INDICES...>) {
+					((output[i + LANE_INDICES] = static_cast<std::size_t> (
+						__internals::hashBytes<sizeof(T)> (bytes + (i + LANE_INDICES) * sizeof(T), sizeof(T), 0)
+					)), ...);
+				}(std::make_index_sequence<LANES> {});
+			}
+		}
+		const flex::hash<T> hasher {};
+		for (; i < count; ++i)
+			output[i] = hasher(keys[i]);
+		return count;
+	}
+
+	template <typename T>
+	auto hash_batch(std::span<const T> keys) -> std::vector<std::size_t> {
+		std::vector<std::size_t> output (keys.size());
+		hash_batch(keys, std::span{output});
+		return output;
+	}
+
+} // namespace flex
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+
+
+namespace flex {
+	/*
+	 * @brief A string of at most `N` characters stored inside the object, kept null-terminated
+	 *
+	 * Writing past the capacity is a precondition violation, except for `append` which refuses to.
+	 * */
+	template <std::size_t N>
+	class InplaceString final {
+		public:
+			using value_type = char;
+			using size_type = std::size_t;
+			using iterator = char*;
+			using const_iterator = const char*;
+
+			constexpr InplaceString() noexcept = default;
+			constexpr ~InplaceString() = default;
+			constexpr InplaceString(const InplaceString&) noexcept = default;
+			constexpr auto operator=(const InplaceString&) noexcept -> InplaceString& = default;
+			constexpr InplaceString(InplaceString&&) noexcept = default;
+			constexpr auto operator=(InplaceString&&) noexcept -> InplaceString& = default;
+
+			constexpr InplaceString(std::string_view string) noexcept {
+				this->append(string);
+			}
+
+			static constexpr auto capacity() noexcept -> std::size_t {return N;}
+
+			constexpr auto size() const noexcept -> std::size_t {return m_size;}
+			constexpr auto empty() const noexcept -> bool {return m_size == 0;}
+
+			constexpr auto data() noexcept -> char* {return m_data;}
+			constexpr auto data() const noexcept -> const char* {return m_data;}
+			constexpr auto c_str() const noexcept -> const char* {return m_data;}
+
+			constexpr auto begin() noexcept -> iterator {return m_data;}
+			constexpr auto begin() const noexcept -> const_iterator {return m_data;}
+			constexpr auto end() noexcept -> iterator {return m_data + m_size;}
+			constexpr auto end() const noexcept -> const_iterator {return m_data + m_size;}
+
+			constexpr auto operator[](std::size_t index) noexcept -> char& {return m_data[index];}
+			constexpr auto operator[](std::size_t index) const noexcept -> const char& {return m_data[index];}
+
+			constexpr auto view() const noexcept -> std::string_view {return std::string_view{m_data, m_size};}
+			constexpr operator std::string_view() const noexcept {return this->view();}
+
+			constexpr auto clear() noexcept -> void {this->resize(0);}
+
+			/*
+			 * @brief Sets the size, for characters written through `data()`. New characters are
+			 *        left as they are
+			 * */
+			constexpr auto resize(std::size_t size) noexcept -> void {
+				m_size = size;
+				m_data[m_size] = '\0';
+			}
+
+			constexpr auto push_back(char character) noexcept -> void {
+				m_data[m_size++] = character;
+				m_data[m_size] = '\0';
+			}
+
+			/*
+			 * @brief Appends `string` if it fits, returns whether it did
+			 * */
+			constexpr auto append(std::string_view string) noexcept -> bool {
+				if (string.size() > N - m_size)
+					return false;
+				std::ranges::copy(string, m_data + m_size);
+				this->resize(m_size + string.size());
+				return true;
+			}
+
+			constexpr auto operator==(const InplaceString &other) const noexcept -> bool {return this->view() == other.view();}
+			constexpr auto operator==(std::string_view string) const noexcept -> bool {return this->view() == string;}
+
+		private:
+			char m_data[N + 1] {};
+			std::size_t m_size {0};
+	};
+
+} // namespace flex
@@ -0,0 +1,727 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "flex/perfectHash.hpp"
+#include "flex/reflection/enums.hpp"
+#include "flex/reflection/reflection.hpp"
+#include "flex/typeTraits.hpp"
+
+
+/*
+ * JSON mapping
+ *
+ *   bool                        : true / false
+ *   arithmetic                  : number, written with `std::to_chars`, non-finite floats as null
+ *   strings                     : string
+ *   enum                        : the name of the enumerator as a string, or its value as a number
+ *                                 if it has no name
+ *   std::optional               : null when empty
+ *   maps with string keys       : object
+ *   std::pair / std::tuple      : array
+ *   other ranges                : array
+ *   reflectable                 : object, members that are missing from the input keep their value
+ *                                 and unknown keys are skipped
+ * */
+namespace flex::json {
+	enum class ErrorCode {
+		eUnexpectedEnd,
+		eUnexpectedCharacter,
+		eInvalidNumber,
+		eInvalidString,
+		eInvalidEnum,
+		eTooDeep,
+		eTrailingCharacters
+	};
+
+	struct Error {
+		ErrorCode code;
+		/*
+		 * @brief The offset of the error in the input
+		 * */
+		std::size_t position;
+	};
+
+	/*
+	 * @brief The deepest nesting of arrays and objects `read` accepts in the values it skips
+	 * */
+	constexpr std::size_t MAX_SKIPPED_DEPTH {256};
+
+
+	namespace __internals {
+		template <typename T>
+		concept string_key_map = std::ranges::sized_range<T>
+			&& requires(T range, typename T::key_type key, typename T::mapped_type value) {
+				range.emplace(std::move(key), std::move(value));
+			}
+			&& std::convertible_to<const typename T::key_type&, std::string_view>;
+
+
+		constexpr auto getEscapeTable() noexcept -> std::array<bool, 256> {
+			std::array<bool, 256> table {};
+			for (std::size_t i {0}; i < 0x20; ++i)
+				table[i] = true;
+			table['"'] = true;
+			table['\\'] = true;
+			return table;
+		}
+
+		constexpr std::array<bool, 256> ESCAPE_TABLE {getEscapeTable()};
+
+		constexpr auto needsEscape(char character) noexcept -> bool {
+			return ESCAPE_TABLE[static_cast<unsigned char> (character)];
+		}
+
+		/*
+		 * @brief Call `append` with the pieces of the escaped version of `string`
+		 * */
+		template <typename Append>
+		constexpr auto escapeString(std::string_view string, Append &&append) -> void {
+			constexpr std::string_view HEX_DIGITS {"0123456789abcdef"};
+			std::size_t start {0};
+			for (std::size_t i {0}; i < string.size(); ++i) {
+				const char character {string[i]};
+				if (!needsEscape(character))
+					continue;
+				append(string.substr(start, i - start));
+				start = i + 1;
+				switch (character) {
+					case '"':  append(std::string_view{"\\\""}); break;
+					case '\\': append(std::string_view{"\\\\"}); break;
+					case '\b': append(std::string_view{"\\b"}); break;
+					case '\f': append(std::string_view{"\\f"}); break;
+					case '\n': append(std::string_view{"\\n"}); break;
+					case '\r': append(std::string_view{"\\r"}); break;
+					case '\t': append(std::string_view{"\\t"}); break;
+					default: {
+						const auto code {static_cast<unsigned char> (character)};
+						const char escaped[] {'\\', 'u', '0', '0', HEX_DIGITS[code >> 4], HEX_DIGITS[code & 0xf]};
+						append(std::string_view{escaped, sizeof(escaped)});
+						break;
+					}
+				}
+			}
+			append(string.substr(start));
+		}
+
+
+		/*
+		 * @brief The keys of the members of `T`, escaped and concatenated at compile time
+		 *
+		 * The text of member `i` is `{"name":` for the first one and `,"name":` for the others,
+		 * so writing an object is a sequence of `append(key) ; write(value)` then `}`.
+		 * */
+		template <flex::reflectable T>
+		struct ObjectKeys {
+			static constexpr std::size_t COUNT {flex::reflection_members_count_v<T>};
+			static constexpr auto NAMES {std::apply(
+				[](auto ...names) {return std::array<std::string_view, sizeof...(names)> {std::string_view{names}...};},
+				flex::reflection_members_names_v<T>
+			)};
+
+			static consteval auto computeOffsets() noexcept -> std::array<std::size_t, COUNT + 1> {
+				std::array<std::size_t, COUNT + 1> offsets {};
+				for (std::size_t i {0}; i < COUNT; ++i) {
+					std::size_t size {0};
+					escapeString(NAMES[i], [&size](std::string_view piece) {size += piece.size();});
+					offsets[i + 1] = offsets[i] + size + 4;
+				}
+				return offsets;
+			}
+
+			static constexpr std::array<std::size_t, COUNT + 1> OFFSETS {computeOffsets()};
+
+			static consteval auto computeText() noexcept -> std::array<char, OFFSETS[COUNT]> {
+				std::array<char, OFFSETS[COUNT]> text {};
+				std::size_t position {0};
+				const auto append {[&text, &position](std::string_view piece) {
+					for (char character : piece)
+						text[position++] = character;
+				}};
+				for (std::size_t i {0}; i < COUNT; ++i) {
+					append(i == 0 ? "{\"" : ",\"");
+					escapeString(NAMES[i], append);
+					append("\":");
+				}
+				return text;
+			}
+
+			static constexpr std::array<char, OFFSETS[COUNT]> TEXT {computeText()};
+
+			static constexpr auto get(std::size_t index) noexcept -> std::string_view {
+				return std::string_view{TEXT.data() + OFFSETS[index], OFFSETS[index + 1] - OFFSETS[index]};
+			}
+		};
+
+
+		template <flex::reflectable T>
+		using MembersPerfectHash = flex::__internals::PerfectHash<ObjectKeys<T>::NAMES>;
+
+
+		template <typename T>
+		auto writeValue(std::string &output, const T &value) -> void;
+
+		inline auto writeString(std::string &output, std::string_view string) -> void {
+			output += '"';
+			escapeString(string, [&output](std::string_view piece) {output.append(piece);});
+			output += '"';
+		}
+
+		template <typename T>
+		auto writeNumber(std::string &output, T value) -> void {
+			if constexpr (std::floating_point<T>) {
+				if (value != value || value - value != value - value) {
+					output.append("null");
+					return;
+				}
+			}
+			char buffer[64];
+			const auto result {std::to_chars(buffer, buffer + sizeof(buffer), value)};
+			output.append(buffer, result.ptr);
+		}
+
+		template <flex::reflectable T>
+		auto writeObject(std::string &output, const T &value) -> void {
+			if constexpr (ObjectKeys<T>::COUNT == 0)
+				output.append("{}");
+			else {
+				[&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					((
+						output.append(ObjectKeys<T>::get(INDICES)),
+						writeValue(output, static_cast<const std::tuple_element_t<INDICES, flex::reflection_members_t<T>>&> (
+							flex::reflection_traits<T>::template getMember<INDICES> (value)
+						))
+					), ...);
+				}(std::make_index_sequence<ObjectKeys<T>::COUNT> {});
+				output += '}';
+			}
+		}
+
+		template <typename T>
+		auto writeValue(std::string &output, const T &value) -> void {
+			if constexpr (std::same_as<T, std::nullopt_t> || std::same_as<T, std::nullptr_t>)
+				output.append("null");
+			else if constexpr (std::same_as<T, bool>)
+				output.append(value ? "true" : "false");
+			else if constexpr (flex::string<T>)
+				writeString(output, std::string_view{value});
+			else if constexpr (flex::arithmetic<T>)
+				writeNumber(output, value);
+			else if constexpr (flex::enumeration<T>) {
+				if (const auto name {flex::toString(value)}; name)
+					writeString(output, *name);
+				else
+					writeNumber(output, static_cast<std::underlying_type_t<T>> (value));
+			}
+			else if constexpr (flex::optional<T>) {
+				if (value)
+					writeValue(output, *value);
+				else
+					output.append("null");
+			}
+			else if constexpr (flex::tuple<T> || flex::pair<T>) {
+				output += '[';
+				std::apply([&output](const auto &first, const auto &...others) {
+					writeValue(output, first);
+					((output += ',', writeValue(output, others)), ...);
+				}, value);
+				output += ']';
+			}
+			else if constexpr (string_key_map<T>) {
+				output += '{';
+				bool first {true};
+				for (const auto &[key, mapped] : value) {
+					if (!first)
+						output += ',';
+					first = false;
+					writeString(output, std::string_view{key});
+					output += ':';
+					writeValue(output, mapped);
+				}
+				output += '}';
+			}
+			else if constexpr (std::ranges::input_range<const T>) {
+				output += '[';
+				bool first {true};
+				for (const auto &element : value) {
+					if (!first)
+						output += ',';
+					first = false;
+					writeValue(output, element);
+				}
+				output += ']';
+			}
+			else if constexpr (flex::reflectable<T>)
+				writeObject(output, value);
+			else
+				static_assert(flex::false_v<T>, "T has no JSON representation");
+		}
+
+
+		class Reader final {
+			public:
+				Reader(std::string_view input) noexcept :
+					m_begin {input.data()},
+					m_cursor {input.data()},
+					m_end {input.data() + input.size()},
+					m_error {}
+				{}
+
+				auto skipWhitespaces() noexcept -> void {
+					while (m_cursor != m_end && (*m_cursor == ' ' || *m_cursor == '\n' || *m_cursor == '\r' || *m_cursor == '\t'))
+						++m_cursor;
+				}
+
+				/*
+				 * @brief The next meaningful character, or `\0` at the end of the input
+				 * */
+				auto peek() noexcept -> char {
+					this->skipWhitespaces();
+					return m_cursor == m_end ? '\0' : *m_cursor;
+				}
+
+				auto consume(char expected) noexcept -> bool {
+					this->skipWhitespaces();
+					if (m_cursor == m_end)
+						return this->fail(ErrorCode::eUnexpectedEnd);
+					if (*m_cursor != expected)
+						return this->fail(ErrorCode::eUnexpectedCharacter);
+					++m_cursor;
+					return true;
+				}
+
+				auto consumeLiteral(std::string_view literal) noexcept -> bool {
+					this->skipWhitespaces();
+					if (static_cast<std::size_t> (m_end - m_cursor) < literal.size())
+						return this->fail(ErrorCode::eUnexpectedEnd);
+					if (std::string_view{m_cursor, literal.size()} != literal)
+						return this->fail(ErrorCode::eUnexpectedCharacter);
+					m_cursor += literal.size();
+					return true;
+				}
+
+				/*
+				 * @brief Parse a number with `std::from_chars`, refusing any leftover part of a number
+				 * */
+				template <flex::arithmetic T>
+				auto readNumber(T &value) noexcept -> bool {
+					this->skipWhitespaces();
+					if (m_cursor == m_end)
+						return this->fail(ErrorCode::eUnexpectedEnd);
+					const auto result {std::from_chars(m_cursor, m_end, value)};
+					if (result.ec != std::errc{})
+						return this->fail(ErrorCode::eInvalidNumber);
+					m_cursor = result.ptr;
+					if (m_cursor != m_end && (*m_cursor == '.' || *m_cursor == 'e' || *m_cursor == 'E'))
+						return this->fail(ErrorCode::eInvalidNumber);
+					return true;
+				}
+
+				/*
+				 * @brief Read a string. `string` points into the input when it has no escape sequence,
+				 *        and into `storage` otherwise
+				 * */
+				auto readString(std::string_view &string, std::string &storage) -> bool {
+					if (!this->consume('"'))
+						return false;
+					const char *start {m_cursor};
+					while (m_cursor != m_end && *m_cursor != '"' && *m_cursor != '\\') {
+						if (static_cast<unsigned char> (*m_cursor) < 0x20)
+							return this->fail(ErrorCode::eInvalidString);
+						++m_cursor;
+					}
+					if (m_cursor == m_end)
+						return this->fail(ErrorCode::eUnexpectedEnd);
+					if (*m_cursor == '"') {
+						string = std::string_view{start, m_cursor};
+						++m_cursor;
+						return true;
+					}
+
+					storage.assign(start, m_cursor);
+					if (!this->unescapeRest(storage))
+						return false;
+					string = storage;
+					return true;
+				}
+
+				auto readString(std::string &string) -> bool {
+					std::string_view view {};
+					if (!this->readString(view, string))
+						return false;
+					if (view.data() != string.data())
+						string.assign(view);
+					return true;
+				}
+
+				auto skipValue(std::size_t depth = 0) -> bool;
+
+				auto fail(ErrorCode code) noexcept -> bool {
+					if (!m_error)
+						m_error = Error{code, static_cast<std::size_t> (m_cursor - m_begin)};
+					return false;
+				}
+
+				[[nodiscard]]
+				auto isAtEnd() noexcept -> bool {
+					this->skipWhitespaces();
+					return m_cursor == m_end;
+				}
+
+				[[nodiscard]]
+				auto getError() const noexcept -> std::optional<Error> {return m_error;}
+
+			private:
+				auto readHex4(std::uint32_t &code) noexcept -> bool {
+					if (m_end - m_cursor < 4)
+						return this->fail(ErrorCode::eUnexpectedEnd);
+					code = 0;
+					for (std::size_t i {0}; i < 4; ++i, ++m_cursor) {
+						const char digit {*m_cursor};
+						code <<= 4;
+						if (digit >= '0' && digit <= '9')
+							code |= static_cast<std::uint32_t> (digit - '0');
+						else if (digit >= 'a' && digit <= 'f')
+							code |= static_cast<std::uint32_t> (digit - 'a' + 10);
+						else if (digit >= 'A' && digit <= 'F')
+							code |= static_cast<std::uint32_t> (digit - 'A' + 10);
+						else
+							return this->fail(ErrorCode::eInvalidString);
+					}
+					return true;
+				}
+
+				static auto appendUtf8(std::string &output, std::uint32_t code) -> void {
+					if (code < 0x80)
+						output += static_cast<char> (code);
+					else if (code < 0x800) {
+						output += static_cast<char> (0xc0 | (code >> 6));
+						output += static_cast<char> (0x80 | (code & 0x3f));
+					}
+					else if (code < 0x10000) {
+						output += static_cast<char> (0xe0 | (code >> 12));
+						output += static_cast<char> (0x80 | ((code >> 6) & 0x3f));
+						output += static_cast<char> (0x80 | (code & 0x3f));
+					}
+					else {
+						output += static_cast<char> (0xf0 | (code >> 18));
+						output += static_cast<char> (0x80 | ((code >> 12) & 0x3f));
+						output += static_cast<char> (0x80 | ((code >> 6) & 0x3f));
+						output += static_cast<char> (0x80 | (code & 0x3f));
+					}
+				}
+
+				/*
+				 * @brief Decode the string from the first escape sequence up to its closing quote
+				 * */
+				auto unescapeRest(std::string &output) -> bool {
+					while (m_cursor != m_end) {
+						const char character {*m_cursor++};
+						if (character == '"')
+							return true;
+						if (static_cast<unsigned char> (character) < 0x20)
+							return this->fail(ErrorCode::eInvalidString);
+						if (character != '\\') {
+							output += character;
+							continue;
+						}
+						if (m_cursor == m_end)
+							break;
+						switch (*m_cursor++) {
+							case '"':  output += '"'; break;
+							case '\\': output += '\\'; break;
+							case '/':  output += '/'; break;
+							case 'b':  output += '\b'; break;
+							case 'f':  output += '\f'; break;
+							case 'n':  output += '\n'; break;
+							case 'r':  output += '\r'; break;
+							case 't':  output += '\t'; break;
+							case 'u': {
+								std::uint32_t code {};
+								if (!this->readHex4(code))
+									return false;
+								if (code >= 0xd800 && code < 0xdc00) {
+									std::uint32_t low {};
+									if (!this->consumeLiteral("\\u") || !this->readHex4(low))
+										return false;
+									if (low < 0xdc00 || low >= 0xe000)
+										return this->fail(ErrorCode::eInvalidString);
+									code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+								}
+								appendUtf8(output, code);
+								break;
+							}
+							default:
+								--m_cursor;
+								return this->fail(ErrorCode::eInvalidString);
+						}
+					}
+					return this->fail(ErrorCode::eUnexpectedEnd);
+				}
+
+				const char *m_begin;
+				const char *m_cursor;
+				const char *m_end;
+				std::optional<Error> m_error;
+		};
+
+		inline auto Reader::skipValue(std::size_t depth) -> bool {
+			if (depth > MAX_SKIPPED_DEPTH)
+				return this->fail(ErrorCode::eTooDeep);
+
+			switch (this->peek()) {
+				case '\0':
+					return this->fail(ErrorCode::eUnexpectedEnd);
+				case '"': {
+					std::string storage {};
+					std::string_view string {};
+					return this->readString(string, storage);
+				}
+				case 't': return this->consumeLiteral("true");
+				case 'f': return this->consumeLiteral("false");
+				case 'n': return this->consumeLiteral("null");
+				case '[': {
+					++m_cursor;
+					if (this->peek() == ']') {
+						++m_cursor;
+						return true;
+					}
+					do {
+						if (!this->skipValue(depth + 1))
+							return false;
+					} while (this->peek() == ',' && ++m_cursor);
+					return this->consume(']');
+				}
+				case '{': {
+					++m_cursor;
+					if (this->peek() == '}') {
+						++m_cursor;
+						return true;
+					}
+					do {
+						std::string storage {};
+						std::string_view key {};
+						if (!this->readString(key, storage) || !this->consume(':') || !this->skipValue(depth + 1))
+							return false;
+					} while (this->peek() == ',' && ++m_cursor);
+					return this->consume('}');
+				}
+				default: {
+					double number {};
+					return this->readNumber(number);
+				}
+			}
+		}
+
+
+		template <typename T>
+		auto readValue(Reader &reader, T &value) -> bool;
+
+		/*
+		 * @brief Read a comma separated sequence closed by `close`, calling `readElement` on each element
+		 * */
+		template <typename ReadElement>
+		auto readSequence(Reader &reader, char close, ReadElement &&readElement) -> bool {
+			if (reader.peek() == close)
+				return reader.consume(close);
+			for (;;) {
+				if (!readElement())
+					return false;
+				if (reader.peek() != ',')
+					return reader.consume(close);
+				(void)reader.consume(',');
+			}
+		}
+
+		template <std::size_t INDEX, flex::reflectable T>
+		auto readMember(Reader &reader, T &value) -> bool {
+			using Member = std::remove_cvref_t<std::tuple_element_t<INDEX, flex::reflection_members_t<T>>>;
+			using Access = decltype(flex::reflection_traits<T>::template getMember<INDEX> (value));
+			if constexpr (std::is_lvalue_reference_v<Access>)
+				return readValue(reader, flex::reflection_traits<T>::template getMember<INDEX> (value));
+			else {
+				Member member {};
+				if (!readValue(reader, member))
+					return false;
+				flex::reflection_traits<T>::template getMember<INDEX> (value) = std::move(member);
+				return true;
+			}
+		}
+
+		template <flex::reflectable T>
+		auto readObject(Reader &reader, T &value) -> bool {
+			using MemberReader = bool(*)(Reader&, T&);
+			constexpr std::size_t COUNT {ObjectKeys<T>::COUNT};
+			static constexpr auto MEMBER_READERS {[]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+				return std::array<MemberReader, COUNT> {&readMember<INDICES, T>...};
+			}(std::make_index_sequence<COUNT> {})};
+
+			if (!reader.consume('{'))
+				return false;
+			std::string storage {};
+			return readSequence(reader, '}', [&]() {
+				std::string_view key {};
+				if (!reader.readString(key, storage) || !reader.consume(':'))
+					return false;
+				const std::size_t index {MembersPerfectHash<T>::find(key)};
+				if (index == COUNT)
+					return reader.skipValue();
+				return MEMBER_READERS[index](reader, value);
+			});
+		}
+
+		template <flex::enumeration T>
+		auto readEnum(Reader &reader, T &value) -> bool {
+			if (reader.peek() != '"') {
+				std::underlying_type_t<T> number {};
+				if (!reader.readNumber(number))
+					return false;
+				value = static_cast<T> (number);
+				return true;
+			}
+
+			std::string storage {};
+			std::string_view name {};
+			if (!reader.readString(name, storage))
+				return false;
+			const std::optional<T> member {flex::fromString<T> (name)};
+			if (!member)
+				return reader.fail(ErrorCode::eInvalidEnum);
+			value = *member;
+			return true;
+		}
+
+		template <typename T>
+		auto readValue(Reader &reader, T &value) -> bool {
+			if constexpr (std::same_as<T, bool>) {
+				const char next {reader.peek()};
+				value = next == 't';
+				return reader.consumeLiteral(next == 't' ? "true" : "false");
+			}
+			else if constexpr (std::same_as<T, std::string>)
+				return reader.readString(value);
+			else if constexpr (flex::arithmetic<T>)
+				return reader.readNumber(value);
+			else if constexpr (flex::enumeration<T>)
+				return readEnum(reader, value);
+			else if constexpr (flex::optional<T>) {
+				if (reader.peek() == 'n') {
+					value.reset();
+					return reader.consumeLiteral("null");
+				}
+				return readValue(reader, value.emplace());
+			}
+			else if constexpr (flex::tuple<T> || flex::pair<T>) {
+				if (!reader.consume('['))
+					return false;
+				const bool success {std::apply([&reader](auto &first, auto &...others) {
+					return readValue(reader, first) && ((reader.consume(',') && readValue(reader, others)) && ...);
+				}, value)};
+				return success && reader.consume(']');
+			}
+			else if constexpr (flex::fixed_array<T>) {
+				if (!reader.consume('['))
+					return false;
+				std::size_t index {0};
+				for (auto &element : value) {
+					if ((index++ != 0 && !reader.consume(',')) || !readValue(reader, element))
+						return false;
+				}
+				return reader.consume(']');
+			}
+			else if constexpr (string_key_map<T>) {
+				if (!reader.consume('{'))
+					return false;
+				value.clear();
+				return readSequence(reader, '}', [&]() {
+					typename T::key_type key {};
+					typename T::mapped_type mapped {};
+					if (!reader.readString(key) || !reader.consume(':') || !readValue(reader, mapped))
+						return false;
+					value.emplace(std::move(key), std::move(mapped));
+					return true;
+				});
+			}
+			else if constexpr (requires(std::ranges::range_value_t<T> element) {value.emplace_back(std::move(element));}) {
+				if (!reader.consume('['))
+					return false;
+				value.clear();
+				return readSequence(reader, ']', [&]() {
+					std::ranges::range_value_t<T> element {};
+					if (!readValue(reader, element))
+						return false;
+					value.emplace_back(std::move(element));
+					return true;
+				});
+			}
+			else if constexpr (requires(std::ranges::range_value_t<T> element) {value.emplace(std::move(element));}) {
+				if (!reader.consume('['))
+					return false;
+				value.clear();
+				return readSequence(reader, ']', [&]() {
+					std::ranges::range_value_t<T> element {};
+					if (!readValue(reader, element))
+						return false;
+					value.emplace(std::move(element));
+					return true;
+				});
+			}
+			else if constexpr (flex::reflectable<T>)
+				return readObject(reader, value);
+			else {
+				static_assert(flex::false_v<T>, "T can't be read from JSON");
+				return false;
+			}
+		}
+
+	} // namespace __internals
+
+
+	/*
+	 * @brief Append the compact JSON representation of `value` to `output`
+	 * */
+	template <typename T>
+	auto write(const T &value, std::string &output) -> void {
+		__internals::writeValue(output, value);
+	}
+
+	template <typename T>
+	auto write(const T &value) -> std::string {
+		std::string output {};
+		output.reserve(256);
+		__internals::writeValue(output, value);
+		return output;
+	}
+
+	/*
+	 * @brief Parse `input`, which must hold a single JSON value, into a `T`
+	 * */
+	template <std::default_initializable T>
+	auto read(std::string_view input) -> std::expected<T, Error> {
+		__internals::Reader reader {input};
+		T value {};
+		if (!__internals::readValue(reader, value))
+			return std::unexpected(reader.getError().value_or(Error{ErrorCode::eUnexpectedCharacter, 0}));
+		if (!reader.isAtEnd()) {
+			reader.fail(ErrorCode::eTrailingCharacters);
+			return std::unexpected(*reader.getError());
+		}
+		return value;
+	}
+
+} // namespace flex::json
@@ -1,15 +1,32 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <format>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <optional>
+#include <source_location>
+#include <span>
 #include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "flex/config.hpp"
+#include "flex/logger/binary.hpp"
+#include "flex/logger/deferred.hpp"
+#include "flex/logger/sinks.hpp"
 #include "flex/reflection/reflection.hpp"
 
 
@@ -22,8 +39,170 @@ namespace flex {
 		eFatal
 	};
 
+	static_assert(static_cast<int> (LogLevel::eVerbose) == FLEX_LOG_LEVEL_VERBOSE);
+	static_assert(static_cast<int> (LogLevel::eInfo) == FLEX_LOG_LEVEL_INFO);
+	static_assert(static_cast<int> (LogLevel::eWarning) == FLEX_LOG_LEVEL_WARNING);
+	static_assert(static_cast<int> (LogLevel::eError) == FLEX_LOG_LEVEL_ERROR);
+	static_assert(static_cast<int> (LogLevel::eFatal) == FLEX_LOG_LEVEL_FATAL);
+
+	/*
+	 * @brief What an asynchronous logger does when its ring buffer is full
+	 *
+	 * - `eBlock` : the producer waits until the writer thread frees a slot
+	 * - `eDropNewest` : the record being logged is discarded
+	 * - `eDropOldest` : the oldest record still queued is discarded to make room
+	 * */
+	enum class LogOverflowPolicy {
+		eBlock,
+		eDropNewest,
+		eDropOldest
+	};
+
+	namespace __internals {
+		class LoggerAsyncBackend;
+		class LoggerThreadBuffer;
+
+	} // namespace __internals
+
+
+	/*
+	 * @brief The static descriptor of a log statement written with one of the `FLEX_LOG` macros
+	 *
+	 * Each call site is registered the first time it's reached. From then on, whether it is
+	 * enabled is cached in `state`, so that a disabled call site costs a single branch.
+	 * */
+	struct LogCallSite {
+		enum class State : std::uint8_t {
+			eUnregistered,
+			eEnabled,
+			eDisabled
+		};
+
+		LogLevel level;
+		std::source_location location;
+		std::atomic<State> state {State::eUnregistered};
+		LogCallSite *next {nullptr};
+		/*
+		 * @brief The id of the call site in the binary format and the stream it was last described in
+		 * */
+		mutable std::atomic<std::uint32_t> binaryId {0};
+		mutable std::atomic<std::uint64_t> binaryGeneration {0};
+
+		[[nodiscard]]
+		inline auto isEnabled() noexcept -> bool;
+	};
+
+
+	/*
+	 * @brief The static state of a sampled call site, written with one of the `FLEX_LOG_EVERY_N`,
+	 *        `FLEX_LOG_FIRST_N` or `FLEX_LOG_RATE_LIMITED` macros
+	 *
+	 * The state is a lock-free counter : a suppressed record costs a single relaxed atomic
+	 * increment (plus a read of a coarse clock when rate limited). Suppressed records are counted
+	 * and summarized per call site by `Logger::logSuppressedRecords()`.
+	 * */
+	struct LogSampler {
+		enum class Kind : std::uint8_t {
+			eEveryN,
+			eFirstN,
+			eRateLimit
+		};
+
+		static constexpr std::size_t RATE_LIMIT_COUNT_BITS {24};
+		static constexpr std::uint64_t RATE_LIMIT_COUNT_MASK {(1ull << RATE_LIMIT_COUNT_BITS) - 1};
+
+		Kind kind;
+		/*
+		 * @brief N of every Nth and first N, or the amount of records per second when rate limited
+		 * */
+		std::uint32_t n;
+		const LogCallSite *callSite;
+		/*
+		 * @brief The occurrences count, or the current second and the count in that second when rate limited
+		 * */
+		std::atomic<std::uint64_t> state {0};
+		std::atomic<std::uint64_t> rateLimitedCount {0};
+		std::atomic<bool> registered {false};
+		std::uint64_t reportedCount {0};
+		LogSampler *next {nullptr};
+
+		/*
+		 * @brief Count an occurrence and tell whether it must be logged
+		 * */
+		[[nodiscard]]
+		inline auto sample() noexcept -> bool;
+
+		/*
+		 * @brief The amount of occurrences suppressed since the creation of the sampler
+		 * */
+		[[nodiscard]]
+		auto getSuppressedCount() const noexcept -> std::uint64_t {
+			const std::uint64_t count {state.load(std::memory_order_relaxed)};
+			switch (kind) {
+				case Kind::eEveryN: return count - (count + n - 1) / n;
+				case Kind::eFirstN: return count - std::min<std::uint64_t> (count, n);
+				case Kind::eRateLimit: return rateLimitedCount.load(std::memory_order_relaxed);
+			}
+			return 0;
+		}
+	};
+
+
+	/*
+	 * @brief The format string of the records, see `Logger::setFormatString` for its slots
+	 *
+	 * The color opener and resetter used to be `{2}` and `{3}`, before `{2}` became the origin. A
+	 * string using `{3}` without `{4}` is almost surely written for that numbering, where it would
+	 * now never reset the color, so it's rejected at compile time.
+	 * */
+	class LogFormatString final {
+		using Format = std::format_string<const std::string&, std::string&, std::string&, std::string&, const std::string&>;
+
+		public:
+			template <typename String>
+			requires std::convertible_to<const String&, std::string_view>
+			consteval LogFormatString(const String &string) : m_format {string} {
+				if (usesSlot(string, 3) && !usesSlot(string, 4))
+					FLEX_THROW("The color opener is {3} and must be closed by {4}, {2} is now the origin");
+			}
+
+			[[nodiscard]]
+			constexpr auto get() const noexcept -> const Format& {return m_format;}
+
+		private:
+			static consteval auto usesSlot(std::string_view string, std::size_t slot) noexcept -> bool {
+				std::size_t nextAutomaticSlot {0};
+				for (std::size_t i {0}; i < string.size(); ++i) {
+					if (string[i] != '{')
+						continue;
+					if (i + 1 < string.size() && string[i + 1] == '{') {
+						++i;
+						continue;
+					}
+
+					std::size_t index {0};
+					bool isManual {false};
+					for (; i + 1 < string.size() && string[i + 1] >= '0' && string[i + 1] <= '9'; ++i) {
+						index = index * 10 + static_cast<std::size_t> (string[i + 1] - '0');
+						isManual = true;
+					}
+					if (!isManual)
+						index = nextAutomaticSlot++;
+					if (index == slot)
+						return true;
+				}
+				return false;
+			}
+
+			Format m_format;
+	};
+
+
 	class Logger {
-		using FormatStringType = std::format_string<const std::string&, std::string&, std::string&, const std::string&>;
+		friend class __internals::LoggerAsyncBackend;
+		friend class __internals::LoggerThreadBuffer;
+		friend struct LogSampler;
+		using FormatStringType = LogFormatString;
 
 		public:
 			Logger() noexcept = delete;
@@ -33,29 +212,42 @@ namespace flex {
 			auto operator=(Logger&&) noexcept -> Logger& = delete;
 
 
+			static constexpr LogLevel COMPILE_MIN_LEVEL {static_cast<LogLevel> (FLEX_LOG_COMPILE_MIN_LEVEL)};
+
+			/*
+			 * @brief Whether logs of the given level survive `FLEX_LOG_COMPILE_MIN_LEVEL`
+			 * */
+			static consteval auto isCompiledIn(LogLevel level) noexcept -> bool {return level >= COMPILE_MIN_LEVEL;}
+
+
 			template <typename ...Args>
 			static inline auto verbose(const std::format_string<Args...> &format, Args &&...args) noexcept -> void {
-				log(LogLevel::eVerbose, format, std::forward<Args> (args)...);
+				if constexpr (isCompiledIn(LogLevel::eVerbose))
+					log(LogLevel::eVerbose, format, std::forward<Args> (args)...);
 			}
 
 			template <typename ...Args>
 			static inline auto info(const std::format_string<Args...> &format, Args &&...args) noexcept -> void {
-				log(LogLevel::eInfo, format, std::forward<Args> (args)...);
+				if constexpr (isCompiledIn(LogLevel::eInfo))
+					log(LogLevel::eInfo, format, std::forward<Args> (args)...);
 			}
 
 			template <typename ...Args>
 			static inline auto warning(const std::format_string<Args...> &format, Args &&...args) noexcept -> void {
-				log(LogLevel::eWarning, format, std::forward<Args> (args)...);
+				if constexpr (isCompiledIn(LogLevel::eWarning))
+					log(LogLevel::eWarning, format, std::forward<Args> (args)...);
 			}
 
 			template <typename ...Args>
 			static inline auto error(const std::format_string<Args...> &format, Args &&...args) noexcept -> void {
-				log(LogLevel::eError, format, std::forward<Args> (args)...);
+				if constexpr (isCompiledIn(LogLevel::eError))
+					log(LogLevel::eError, format, std::forward<Args> (args)...);
 			}
 
 			template <typename ...Args>
 			static inline auto fatal(const std::format_string<Args...> &format, Args &&...args) noexcept -> void {
-				log(LogLevel::eFatal, format, std::forward<Args> (args)...);
+				if constexpr (isCompiledIn(LogLevel::eFatal))
+					log(LogLevel::eFatal, format, std::forward<Args> (args)...);
 			}
 
 
@@ -63,65 +255,312 @@ namespace flex {
 			static auto log(LogLevel level, const std::format_string<Args...> &format, Args &&...args) noexcept -> void {
 				if (level < s_minLevel)
 					return;
+				logImpl(level, nullptr, format, std::forward<Args> (args)...);
+			}
 
-				const std::string content {std::format(format, std::forward<Args> (args)...)};
-				std::string levelString {};
-				switch (level) {
-					using enum LogLevel;
-					case eVerbose: levelString = "verbose"; break;
-					case eInfo: levelString = "info"; break;
-					case eWarning: levelString = "warning"; break;
-					case eError: levelString = "error"; break;
-					case eFatal: levelString = "fatal"; break;
-				}
-
-				std::string colorStart {};
-				if (s_colorEnabled) {
-					switch (level) {
-						using enum LogLevel;
-						case eVerbose: colorStart = "\033[90m"; break;
-						case eInfo: colorStart = "\033[34m"; break;
-						case eWarning: colorStart = "\033[33m"; break;
-						case eError: colorStart = "\033[91m"; break;
-						case eFatal: colorStart = "\033[31m"; break;
-					}
-				}
-				const std::string colorEnd {s_colorEnabled ? "\033[m" : ""};
-
-				const std::string result {std::format(s_formatString,
-					content,
-					levelString,
-					colorStart,
-					colorEnd
-				)};
-
-				*s_outputStream << result << std::endl;
+			/*
+			 * @brief Log from a registered call site. Use the `FLEX_LOG` macros rather than calling it directly
+			 * @note The caller is responsible for checking `callSite.isEnabled()`
+			 * */
+			template <typename ...Args>
+			static auto log(const LogCallSite &callSite, const std::format_string<Args...> &format, Args &&...args) noexcept -> void {
+				logImpl(callSite.level, &callSite, format, std::forward<Args> (args)...);
 			}
 
 			/*
 			 * {0} : the content of the log
 			 * {1} : the level of the log
-			 * {2} : the function origin of the log
+			 * {2} : the function origin of the log, empty if the log doesn't come from a `FLEX_LOG` macro
 			 * {3} : the color opener
 			 * {4} : the color resetter
+			 *
+			 * @note A string using `{3}` without `{4}` doesn't compile, see `flex::LogFormatString`
 			 * */
 			static inline auto setFormatString(const FormatStringType &string) noexcept -> void {s_formatString = string;}
 
-			static inline auto setOutputStream(std::ostream &stream, bool colorEnabled = false) noexcept -> void {
-				s_outputStream = &stream;
-				s_colorEnabled = colorEnabled;
-			}
+			/*
+			 * @brief Replace every sink by a single `flex::logger::OStreamSink` writing to `stream`
+			 * */
+			static auto setOutputStream(std::ostream &stream, bool colorEnabled = false) noexcept -> void;
 
-			static inline auto setMinLevel(LogLevel minLevel) noexcept -> void {s_minLevel = minLevel;}
+			/*
+			 * @brief Replace every sink by a single `flex::logger::FileDescriptorSink` writing to `fileDescriptor`
+			 *
+			 * Unlike `setOutputStream`, writing to a file descriptor doesn't take any lock : a chunk of
+			 * records is always handed to the kernel in a single call, which is atomic for regular files
+			 * opened with `O_APPEND` and for pipes when the chunk is smaller than `PIPE_BUF`.
+			 *
+			 * @note Only available on POSIX systems. Elsewhere the logger keeps its current sinks
+			 * */
+			static auto setOutputFileDescriptor(int fileDescriptor, bool colorEnabled = false) noexcept -> void;
+
+			/*
+			 * @brief Replace the destinations of the records
+			 *
+			 * Every record is written to every sink, in order. The list is swapped atomically, so a
+			 * record being written while the sinks change goes either to the old or to the new list,
+			 * and a removed sink is only destroyed once the last write using it returned.
+			 * */
+			static auto setSinks(std::vector<std::shared_ptr<flex::logger::Sink>> sinks, bool colorEnabled = false) noexcept -> void;
+			static auto addSink(std::shared_ptr<flex::logger::Sink> sink) noexcept -> void;
+			static auto removeSink(const std::shared_ptr<flex::logger::Sink> &sink) noexcept -> void;
+
+			/*
+			 * @brief Stage the records of each thread in a thread-local buffer
+			 * @param enabled Whether the thread buffering is enabled
+			 * @param flushThreshold The size in bytes from which a thread buffer is written to the output
+			 *
+			 * A thread buffer only ever holds complete lines and is written in a single chunk, so
+			 * records of different threads never interleave mid-line. Buffers are written when they
+			 * reach `flushThreshold`, when their thread exits and on `Logger::flush()`.
+			 * Without buffering, every record is written and flushed on its own.
+			 *
+			 * @note Has no effect while the logger is asynchronous, as the writer thread already batches records
+			 * */
+			static auto setThreadBuffering(bool enabled, std::size_t flushThreshold = 16 * 1024) noexcept -> void;
+
+			/*
+			 * @brief Set the runtime minimum level. The state of every registered call site is updated
+			 * */
+			static auto setMinLevel(LogLevel minLevel) noexcept -> void;
+
+			/*
+			 * @brief Enable or disable call sites individually
+			 * @param filter Returns whether the given call site is enabled. An empty filter enables everything
+			 *
+			 * The filter is evaluated once per call site, when it gets registered or when the filter
+			 * or the minimum level change. It's never evaluated on the logging path.
+			 * */
+			static auto setCallSiteFilter(std::function<bool(const LogCallSite&)> filter) noexcept -> void;
+
+			/*
+			 * @brief Register a call site and compute its state
+			 * @return Whether the call site is enabled
+			 * */
+			static auto registerCallSite(LogCallSite &callSite) noexcept -> bool;
+
+			/*
+			 * @brief Log, for every sampled call site that suppressed records since the last summary,
+			 *        the amount of suppressed records, at the level and with the origin of the call site
+			 * */
+			static auto logSuppressedRecords() noexcept -> void;
+
+			/*
+			 * @brief Set how often `logSuppressedRecords` is called automatically. Zero disables it
+			 *
+			 * The check is done when a sampled call site lets a record through, never on the
+			 * suppressed path, so a call site that stopped logging is summarized the next time any
+			 * sampled call site logs.
+			 * */
+			static auto setSuppressedRecordsSummaryInterval(std::chrono::seconds interval) noexcept -> void;
+
+
+			/*
+			 * @brief Move the output of the logger to a background writer thread
+			 * @param capacity The amount of records the ring buffer can hold, rounded up to a power of two
+			 * @param overflowPolicy What to do with a record that doesn't fit in the ring buffer
+			 * @param batchSize The maximum amount of records written between two flushes of the output stream
+			 *
+			 * Producers still format their records, but only push them in a bounded lock-free ring
+			 * buffer. The writer thread drains it by batches, so the output stream is flushed once
+			 * per batch instead of once per line.
+			 *
+			 * @return Whether the ring buffer and the writer thread could be created. On failure the
+			 *         logger stays synchronous
+			 *
+			 * @warning Neither `enableAsync` nor `disableAsync` are thread-safe regarding concurrent
+			 *          calls to the logging functions
+			 * */
+			static auto enableAsync(
+				std::size_t capacity = 8192,
+				LogOverflowPolicy overflowPolicy = LogOverflowPolicy::eBlock,
+				std::size_t batchSize = 256
+			) noexcept -> bool;
+			/*
+			 * @brief Write every pending record, stop the writer thread and go back to synchronous logging
+			 * */
+			static auto disableAsync() noexcept -> void;
+			[[nodiscard]]
+			static auto isAsync() noexcept -> bool;
+
+			/*
+			 * @brief Block until every record logged before the call has reached the output stream
+			 * */
+			static auto flush() noexcept -> void;
+
+			/*
+			 * @brief The amount of records discarded by `LogOverflowPolicy::eDropNewest` or
+			 *        `LogOverflowPolicy::eDropOldest` since the last call to `enableAsync`
+			 * */
+			[[nodiscard]]
+			static auto getDroppedRecordsCount() noexcept -> std::size_t;
+
+			/*
+			 * @brief Move the formatting of the records to the writer thread
+			 * @param enabled Whether the deferred formatting is enabled
+			 * @param stagingBufferSize The size in bytes of the per-thread staging buffer
+			 *
+			 * When enabled and when the logger is asynchronous, a call whose arguments are all
+			 * `flex::logger::deferrable_argument` doesn't format anything : its arguments are copied
+			 * as raw bytes in a per-thread staging buffer, along with the format string and a decoder.
+			 * The writer thread rebuilds the arguments and does the formatting.
+			 *
+			 * Calls with non-deferrable arguments, or that don't fit in the staging buffer, fall back
+			 * to the eager path. Records from a same thread stay ordered, but records of different
+			 * threads, or of the deferred and eager paths, may be reordered.
+			 *
+			 * @warning The format string is captured by pointer, so it must have static storage duration,
+			 *          which is always the case of string literals
+			 * */
+			static auto setDeferredFormatting(bool enabled, std::size_t stagingBufferSize = 64 * 1024) noexcept -> void;
+
+			/*
+			 * @brief Write the records in the binary format of `flex/logger/binary.hpp` instead of text
+			 *
+			 * Arguments are encoded by type rather than formatted : reflectable structs member by
+			 * member, ranges element by element, and any other type through its `std::formatter`.
+			 * Call sites and reflectable types are described once per stream, and every change of
+			 * the sinks or new file of a rotating sink starts a new stream. Use `flex_logdecode` to turn the output back into text
+			 * or JSON.
+			 *
+			 * @note Takes precedence over deferred formatting. The format string of the logger and
+			 *       colors don't apply
+			 * */
+			static auto setBinaryFormat(bool enabled) noexcept -> void;
 
 		private:
-			static std::ostream *s_outputStream;
+			/*
+			 * @brief The fixed part of a deferred record. It's followed by the encoded arguments
+			 * */
+			struct DeferredRecordHeader {
+				std::uint32_t size;
+				LogLevel level;
+				const LogCallSite *callSite;
+				std::string_view format;
+				flex::logger::DeferredDecoder decoder;
+			};
+
+			template <typename ...Args>
+			static auto logImpl(LogLevel level, const LogCallSite *callSite, const std::format_string<Args...> &format, Args &&...args) noexcept -> void {
+				if (s_binaryFormat)
+					return logBinary(level, callSite, format.get(), args...);
+				if constexpr ((flex::logger::deferrable_argument<Args> && ...)) {
+					if (s_deferredFormatting && logDeferred<Args...> (level, callSite, format, args...))
+						return;
+				}
+
+				const std::string content {std::format(format, std::forward<Args> (args)...)};
+				write(formatRecord(level, callSite, content));
+			}
+
+			template <typename ...Args>
+			static auto logDeferred(LogLevel level, const LogCallSite *callSite, const std::format_string<Args...> &format, const Args &...args) noexcept -> bool {
+				const std::size_t size {sizeof(DeferredRecordHeader) + flex::logger::getEncodedArgumentsSize(args...)};
+				std::byte *record {reserveDeferredRecord(size)};
+				if (record == nullptr)
+					return false;
+
+				const DeferredRecordHeader header {
+					.size = static_cast<std::uint32_t> (size),
+					.level = level,
+					.callSite = callSite,
+					.format = format.get(),
+					.decoder = flex::logger::deferred_decoder_v<Args...>
+				};
+				std::memcpy(record, &header, sizeof(header));
+				flex::logger::encodeArguments(record + sizeof(header), args...);
+				commitDeferredRecord();
+				return true;
+			}
+
+			template <typename ...Args>
+			static auto logBinary(LogLevel level, const LogCallSite *callSite, std::string_view format, const Args &...args) noexcept -> void {
+				flex::logger::binary::Encoder encoder {beginBinaryRecord(level, callSite, format, sizeof...(Args))};
+				(encoder.encode(args), ...);
+				writeBinaryRecord(encoder);
+			}
+
+			/*
+			 * @brief A monotonic clock in seconds, with the resolution of a scheduler tick but much cheaper
+			 * */
+			static auto getCoarseSeconds() noexcept -> std::uint64_t;
+			/*
+			 * @brief Register the sampler and trigger the periodic summary. Called when a sampled record passes
+			 * */
+			static auto onSampledRecord(LogSampler &sampler) noexcept -> void;
+
+			static auto beginBinaryRecord(LogLevel level, const LogCallSite *callSite, std::string_view format, std::size_t argumentsCount) noexcept
+				-> flex::logger::binary::Encoder;
+			static auto writeBinaryRecord(flex::logger::binary::Encoder &encoder) noexcept -> void;
+			/*
+			 * @brief The stream prologue of the binary format : its header and every description written so far
+			 * */
+			static auto writeBinaryPrologue(std::string &output) noexcept -> void;
+			/*
+			 * @brief The text line of a record, `\n` included
+			 * */
+			static auto formatRecord(LogLevel level, const LogCallSite *callSite, const std::string &content) noexcept -> std::string;
+			/*
+			 * @brief Write a complete record : a text line or a binary chunk
+			 * @param definitions The binary descriptions held by `record`, committed once it reached the sinks
+			 * */
+			static auto write(std::string &&record, flex::logger::binary::PendingDefinitions &&definitions = {}) noexcept -> void;
+			static auto writeToSink(std::span<const std::string_view> chunks) noexcept -> void;
+			static auto reserveDeferredRecord(std::size_t size) noexcept -> std::byte*;
+			static auto commitDeferredRecord() noexcept -> void;
+
 			static FormatStringType s_formatString;
 			static LogLevel s_minLevel;
 			static bool s_colorEnabled;
+			static bool s_deferredFormatting;
+			static bool s_binaryFormat;
 	};
 
 
+	inline auto LogCallSite::isEnabled() noexcept -> bool {
+		const State currentState {state.load(std::memory_order_relaxed)};
+		if (currentState == State::eEnabled) [[likely]]
+			return true;
+		return currentState == State::eUnregistered && Logger::registerCallSite(*this);
+	}
+
+
+	inline auto LogSampler::sample() noexcept -> bool {
+		switch (kind) {
+			case Kind::eEveryN:
+				if (state.fetch_add(1, std::memory_order_relaxed) % n != 0)
+					return false;
+				break;
+
+			case Kind::eFirstN:
+				if (state.fetch_add(1, std::memory_order_relaxed) >= n)
+					return false;
+				break;
+
+			case Kind::eRateLimit: {
+				const std::uint64_t second {Logger::getCoarseSeconds()};
+				std::uint64_t current {state.load(std::memory_order_relaxed)};
+				std::uint64_t desired {};
+				do {
+					// a thread late on the clock counts in the newer second rather than resetting it
+					if ((current >> RATE_LIMIT_COUNT_BITS) < second)
+						desired = (second << RATE_LIMIT_COUNT_BITS) | 1;
+					else if ((current & RATE_LIMIT_COUNT_MASK) < n)
+						desired = current + 1;
+					else {
+						rateLimitedCount.fetch_add(1, std::memory_order_relaxed);
+						return false;
+					}
+				} while (!state.compare_exchange_weak(current, desired, std::memory_order_relaxed));
+				break;
+			}
+		}
+
+		Logger::onSampledRecord(*this);
+		return true;
+	}
+
+
 
 	template <std::integral T>
 	constexpr auto stoi(std::string_view str) -> std::optional<T> {
@@ -162,43 +601,93 @@ namespace flex {
 
 
 	namespace __internals {
-		template <flex::reflectable T, std::size_t INDEX = 0>
-		requires (INDEX < flex::reflection_members_count_v<T>)
-		auto logReflectableMember(std::ostringstream &stream, const T &value, std::size_t width) noexcept -> void {
-			std::string spaces (width, ' ');
-			stream << spaces << std::get<INDEX> (flex::reflection_members_names_v<T>) << ": ";
-
-		#define __FLEX_CURRENT_VALUE static_cast<const std::tuple_element_t<INDEX, flex::reflection_members_t<T>>&> (\
-			flex::reflection_traits<T>::template getMember<INDEX> (value)\
-		)
-			if constexpr (!flex::is_reflectable_v<std::tuple_element_t<INDEX, flex::reflection_members_t<T>>>) {
-				if constexpr (flex::is_string_v<std::tuple_element_t<INDEX, flex::reflection_members_t<T>>>)
-					stream << std::quoted(__FLEX_CURRENT_VALUE);
-				else
-					stream << __FLEX_CURRENT_VALUE;
+		template <typename Out>
+		auto writeQuotedString(Out out, std::string_view string) -> Out {
+			*out++ = '"';
+			for (char character : string) {
+				if (character == '"' || character == '\\')
+					*out++ = '\\';
+				*out++ = character;
 			}
+			*out++ = '"';
+			return out;
+		}
+
+		/*
+		 * @brief Write `value` the way `std::ostream::operator<<` does with default flags (bools as
+		 *        1 / 0, character types as characters, floating points as `%g`), without allocating
+		 * */
+		template <flex::arithmetic T, typename Out>
+		auto writeStreamArithmetic(Out out, T value) -> Out {
+			if constexpr (std::same_as<T, bool>)
+				*out++ = value ? '1' : '0';
+			else if constexpr (std::same_as<T, char> || std::same_as<T, signed char> || std::same_as<T, unsigned char>)
+				*out++ = static_cast<char> (value);
 			else {
-				if (width == 0)
-					stream << std::format("{}", __FLEX_CURRENT_VALUE);
+				std::array<char, 64> buffer {};
+				std::to_chars_result result {};
+				if constexpr (std::floating_point<T>)
+					result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value, std::chars_format::general, 6);
 				else {
-					std::string format {std::format("{{:{}}}", width)};
-					format = std::vformat(format, std::make_format_args(__FLEX_CURRENT_VALUE));
-					for (auto it {format.begin()}; it != format.end(); ++it) {
-						if (*it != '\n')
-							continue;
-						it = format.insert(it+1, width, ' ') + width;
-					}
-					stream << format;
+					using Wide = std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>;
+					result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), static_cast<Wide> (value));
 				}
+				out = std::ranges::copy(buffer.data(), result.ptr, out).out;
+			}
+			return out;
+		}
+
+		template <flex::reflectable T, typename Out>
+		auto formatReflectable(Out out, const T &value, std::size_t width, std::size_t depth) -> Out;
+
+		template <std::size_t INDEX, flex::reflectable T, typename Out>
+		auto formatReflectableMember(Out out, const T &value, std::size_t width, std::size_t depth) -> Out {
+			using Member = std::tuple_element_t<INDEX, flex::reflection_members_t<T>>;
+			const Member &member {flex::reflection_traits<T>::template getMember<INDEX> (value)};
+
+			out = std::ranges::fill_n(out, static_cast<std::ptrdiff_t> (width * (depth + 1)), ' ');
+			out = std::ranges::copy(std::string_view{std::get<INDEX> (flex::reflection_members_names_v<T>)}, out).out;
+			*out++ = ':';
+			*out++ = ' ';
+
+			if constexpr (flex::is_reflectable_v<Member> && requires {typename std::formatter<Member, char>::flex_autogen_formatter;})
+				out = formatReflectable(out, member, width, depth + 1);
+			else if constexpr (flex::is_string_v<Member>)
+				out = writeQuotedString(out, std::string_view{member});
+			else if constexpr (flex::arithmetic<Member>)
+				out = writeStreamArithmetic(out, member);
+			else if constexpr (std::formattable<Member, char>)
+				out = std::format_to(out, "{}", member);
+			else {
+				std::ostringstream stream {};
+				stream << member;
+				out = std::ranges::copy(stream.view(), out).out;
+			}
+
+			if constexpr (INDEX + 1 < flex::reflection_members_count_v<T>) {
+				*out++ = ',';
+				*out++ = ' ';
 			}
+			if (width != 0)
+				*out++ = '\n';
+			return out;
+		}
 
-			if constexpr (INDEX + 1 < reflection_members_count_v<T>)
-				stream << ", ";
+		/*
+		 * @brief Write `value` straight to `out`, members on their own line indented by `width`
+		 *        spaces per level when `width` isn't 0
+		 * */
+		template <flex::reflectable T, typename Out>
+		auto formatReflectable(Out out, const T &value, std::size_t width, std::size_t depth) -> Out {
+			*out++ = '{';
 			if (width != 0)
-				stream << "\n";
-			if constexpr (INDEX + 1 < reflection_members_count_v<T>)
-				logReflectableMember<T, INDEX+1> (stream, value, width);
-		#undef __FLEX_CURRENT_VALUE
+				*out++ = '\n';
+			[&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+				((out = formatReflectableMember<INDICES> (out, value, width, depth)), ...);
+			}(std::make_index_sequence<flex::reflection_members_count_v<T>> {});
+			out = std::ranges::fill_n(out, static_cast<std::ptrdiff_t> (width * depth), ' ');
+			*out++ = '}';
+			return out;
 		}
 
 	} // namespace __internals
@@ -206,36 +695,87 @@ namespace flex {
 } // namespace flex
 
 
+/*
+ * The format spec is an optional width : without it, the struct is written on a single line
+ * `{name: value, ...}`, with it every member goes on its own line, indented by `width` spaces
+ * per nesting level. Strings are quoted, nested reflectables are written recursively.
+ * */
 template <flex::reflectable_autogen_formatter T>
 class std::formatter<T, char> {
 	public:
+		/*
+		 * @brief Lets nested members be written in place instead of through a new format call
+		 * */
+		using flex_autogen_formatter = void;
+
 		constexpr auto parse(std::format_parse_context &ctx) -> std::format_parse_context::iterator {
 			m_width = 0;
 			auto it {ctx.begin()};
-			if (it == ctx.end())
-				return it;
-
-			std::string_view args {ctx.begin(), ctx.end() - 1};
-			if (args.empty())
-				return ctx.end() - 1;
-			std::optional<std::size_t> widthWithError {flex::stoi<std::size_t> (args)};
-			if (!widthWithError)
-				FLEX_THROW(std::format_error("The format part of reflectable must be a number"));
-			m_width = *widthWithError;
-			return ctx.end() - 1;
+			for (; it != ctx.end() && *it != '}'; ++it) {
+				if (*it < '0' || *it > '9')
+					FLEX_THROW(std::format_error("The format part of reflectable must be a number"));
+				m_width = m_width * 10 + static_cast<std::size_t> (*it - '0');
+			}
+			return it;
 		}
 
-
-		auto format(const T &value, std::format_context &ctx) const noexcept -> std::format_context::iterator {
-			std::ostringstream stream {};
-			stream << "{";
-			if (m_width != 0)
-				stream << "\n";
-			flex::__internals::logReflectableMember(stream, value, m_width);
-			stream << "}";
-			return std::ranges::copy(std::move(stream).str(), ctx.out()).out;
-		};
+		auto format(const T &value, std::format_context &ctx) const -> std::format_context::iterator {
+			return flex::__internals::formatReflectable(ctx.out(), value, m_width, 0);
+		}
 
 	private:
 		std::size_t m_width;
 };
+
+
+/*
+ * @brief Log from a call site with a static descriptor
+ *
+ * The statement is removed entirely, arguments evaluation included, when `level` is below
+ * `FLEX_LOG_COMPILE_MIN_LEVEL`. Otherwise the arguments are only evaluated if the call site
+ * is enabled, which costs a single branch. The call site fills the `{2}` slot of the format
+ * string with its origin.
+ *
+ * @param level A constant `flex::LogLevel`
+ * */
+#define FLEX_LOG(level, format, ...) do {\
+	if constexpr (flex::Logger::isCompiledIn(level)) {\
+		static constinit flex::LogCallSite __flexLogCallSite {(level), std::source_location::current()};\
+		if (__flexLogCallSite.isEnabled())\
+			flex::Logger::log(__flexLogCallSite, format __VA_OPT__(,) __VA_ARGS__);\
+	}\
+} while (false)
+
+/*
+ * @brief Log one occurrence out of `n`, starting with the first one
+ * @param n A constant
+ * */
+#define FLEX_LOG_EVERY_N(level, n, format, ...) __FLEX_LOG_SAMPLED(level, flex::LogSampler::Kind::eEveryN, n, format __VA_OPT__(,) __VA_ARGS__)
+
+/*
+ * @brief Log the first `n` occurrences only. Later ones are counted in the suppressed records summary
+ * @param n A constant
+ * */
+#define FLEX_LOG_FIRST_N(level, n, format, ...) __FLEX_LOG_SAMPLED(level, flex::LogSampler::Kind::eFirstN, n, format __VA_OPT__(,) __VA_ARGS__)
+
+/*
+ * @brief Log at most `n` occurrences per second
+ * @param n A constant, lower than 2^24
+ * */
+#define FLEX_LOG_RATE_LIMITED(level, n, format, ...) __FLEX_LOG_SAMPLED(level, flex::LogSampler::Kind::eRateLimit, n, format __VA_OPT__(,) __VA_ARGS__)
+
+#define __FLEX_LOG_SAMPLED(level, kind, n, format, ...) do {\
+	if constexpr (flex::Logger::isCompiledIn(level)) {\
+		static_assert((n) > 0, "The sampling parameter must be strictly positive");\
+		static constinit flex::LogCallSite __flexLogCallSite {(level), std::source_location::current()};\
+		static constinit flex::LogSampler __flexLogSampler {(kind), (n), &__flexLogCallSite};\
+		if (__flexLogCallSite.isEnabled() && __flexLogSampler.sample())\
+			flex::Logger::log(__flexLogCallSite, format __VA_OPT__(,) __VA_ARGS__);\
+	}\
+} while (false)
+
+#define FLEX_LOG_VERBOSE(format, ...) FLEX_LOG(flex::LogLevel::eVerbose, format __VA_OPT__(,) __VA_ARGS__)
+#define FLEX_LOG_INFO(format, ...) FLEX_LOG(flex::LogLevel::eInfo, format __VA_OPT__(,) __VA_ARGS__)
+#define FLEX_LOG_WARNING(format, ...) FLEX_LOG(flex::LogLevel::eWarning, format __VA_OPT__(,) __VA_ARGS__)
+#define FLEX_LOG_ERROR(format, ...) FLEX_LOG(flex::LogLevel::eError, format __VA_OPT__(,) __VA_ARGS__)
+#define FLEX_LOG_FATAL(format, ...) FLEX_LOG(flex::LogLevel::eFatal, format __VA_OPT__(,) __VA_ARGS__)
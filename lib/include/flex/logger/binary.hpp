@@ -0,0 +1,406 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <optional>
+#include <ranges>
+#include <source_location>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "flex/reflection/enums.hpp"
+#include "flex/reflection/reflection.hpp"
+#include "flex/typeTraits.hpp"
+
+
+/*
+ * Binary log format
+ *
+ * A stream is a sequence of chunks, each starting with a `ChunkKind` byte. Integers are unsigned
+ * LEB128 varints (zigzag encoded when signed), strings are a varint size followed by their bytes.
+ *
+ *   eHeader   : MAGIC, u8 VERSION
+ *   eCallSite : id, u8 level, file, line, function, format
+ *   eType     : id, count, count * member name
+ *   eRecord   : u64 little-endian timestamp (nanoseconds since epoch), u8 level, call site id,
+ *               format (only when the call site id is 0), count, count * value
+ *
+ * A value starts with a `ValueTag` byte :
+ *
+ *   eNull                       : nothing
+ *   eBool                       : u8
+ *   eSigned / eUnsigned         : varint
+ *   eFloat                      : u64 little-endian IEEE 754 double
+ *   eString / eFormatted        : string
+ *   eEnum                       : signed varint, name (empty if unknown)
+ *   eStruct                     : type id, count, count * value
+ *   eList                       : count, count * value
+ *
+ * Call sites and reflectable types are described once per stream, before the first record using
+ * them. A description may be repeated and the decoder keeps the last one. A description only
+ * counts as written once its chunk reached the sinks. Every change of the sinks starts a new
+ * stream, and the sinks starting one by themselves write the header and the descriptions known
+ * so far first.
+ *
+ * Zero bytes running from a chunk boundary to the end of the data are not a chunk : they are the
+ * preallocated tail of a rotated segment that was never trimmed, because its process died.
+ * */
+namespace flex::logger::binary {
+	constexpr std::string_view MAGIC {"FLEXLOG"};
+	constexpr std::uint8_t VERSION {1};
+
+	enum class ChunkKind : std::uint8_t {
+		eHeader,
+		eCallSite,
+		eType,
+		eRecord
+	};
+
+	enum class ValueTag : std::uint8_t {
+		eNull,
+		eBool,
+		eSigned,
+		eUnsigned,
+		eFloat,
+		eString,
+		eEnum,
+		eStruct,
+		eList,
+		eFormatted
+	};
+
+
+	namespace __internals {
+		inline auto writeByte(std::string &output, std::uint8_t value) noexcept -> void {
+			output += static_cast<char> (value);
+		}
+
+		inline auto writeVarint(std::string &output, std::uint64_t value) noexcept -> void {
+			while (value >= 0x80) {
+				output += static_cast<char> ((value & 0x7f) | 0x80);
+				value >>= 7;
+			}
+			output += static_cast<char> (value);
+		}
+
+		inline auto writeSigned(std::string &output, std::int64_t value) noexcept -> void {
+			writeVarint(output, (static_cast<std::uint64_t> (value) << 1) ^ static_cast<std::uint64_t> (value >> 63));
+		}
+
+		inline auto writeFixed64(std::string &output, std::uint64_t value) noexcept -> void {
+			if constexpr (std::endian::native == std::endian::big)
+				value = std::byteswap(value);
+			char bytes[sizeof(value)];
+			std::memcpy(bytes, &value, sizeof(value));
+			output.append(bytes, sizeof(value));
+		}
+
+		inline auto writeString(std::string &output, std::string_view value) noexcept -> void {
+			writeVarint(output, value.size());
+			output += value;
+		}
+
+
+		inline constinit std::atomic<std::uint32_t> s_nextTypeId {1};
+
+		template <flex::reflectable T>
+		struct BinaryType {
+			static auto getId() noexcept -> std::uint32_t {
+				static const std::uint32_t id {s_nextTypeId.fetch_add(1, std::memory_order_relaxed)};
+				return id;
+			}
+
+			static inline constinit std::atomic<std::uint64_t> definedGeneration {0};
+		};
+
+	} // namespace __internals
+
+
+	/*
+	 * @brief The descriptions held by a chunk, to mark as written once the chunk reached the sinks
+	 *
+	 * A chunk that never reaches them, dropped by the async logger for example, leaves its
+	 * descriptions unwritten so the next record using them describes them again.
+	 * */
+	class PendingDefinitions final {
+		public:
+			PendingDefinitions() noexcept = default;
+			PendingDefinitions(std::uint64_t generation, std::vector<std::atomic<std::uint64_t>*> &&definedGenerations) noexcept :
+				m_generation {generation},
+				m_definedGenerations {std::move(definedGenerations)}
+			{}
+
+			[[nodiscard]]
+			auto isEmpty() const noexcept -> bool {return m_definedGenerations.empty();}
+
+			auto commit() const noexcept -> void {
+				for (std::atomic<std::uint64_t> *definedGeneration : m_definedGenerations)
+					definedGeneration->store(m_generation, std::memory_order_relaxed);
+			}
+
+		private:
+			std::uint64_t m_generation {0};
+			std::vector<std::atomic<std::uint64_t>*> m_definedGenerations {};
+	};
+
+
+	/*
+	 * @brief Build one chunk of the binary format : the record itself, preceded by the description
+	 *        of every call site and type it uses that wasn't written to the current stream yet
+	 *
+	 * A stream is identified by a generation. The descriptions of the chunk are returned by
+	 * `takeDefinitions`, to be committed once the chunk has been written.
+	 * */
+	class Encoder final {
+		public:
+			Encoder(std::uint64_t generation) noexcept :
+				m_generation {generation},
+				m_definitions {},
+				m_payload {},
+				m_pendingDefinitions {}
+			{
+				m_payload.reserve(128);
+			}
+
+			/*
+			 * @brief Write the stream header if it wasn't written for the current generation
+			 * */
+			auto defineStream(std::atomic<std::uint64_t> &definedGeneration) noexcept -> void {
+				if (!this->shouldDefine(definedGeneration))
+					return;
+				__internals::writeByte(m_definitions, static_cast<std::uint8_t> (ChunkKind::eHeader));
+				m_definitions += MAGIC;
+				__internals::writeByte(m_definitions, VERSION);
+			}
+
+			auto defineCallSite(
+				std::atomic<std::uint64_t> &definedGeneration,
+				std::uint32_t id,
+				std::uint8_t level,
+				const std::source_location &location,
+				std::string_view format
+			) noexcept -> void {
+				if (!this->shouldDefine(definedGeneration))
+					return;
+				__internals::writeByte(m_definitions, static_cast<std::uint8_t> (ChunkKind::eCallSite));
+				__internals::writeVarint(m_definitions, id);
+				__internals::writeByte(m_definitions, level);
+				__internals::writeString(m_definitions, location.file_name());
+				__internals::writeVarint(m_definitions, location.line());
+				__internals::writeString(m_definitions, location.function_name());
+				__internals::writeString(m_definitions, format);
+			}
+
+			/*
+			 * @brief Start the record. Exactly `argumentsCount` values must then be encoded
+			 * @param callSiteId The id of a call site defined with `defineCallSite`, or 0 to store the format inline
+			 * */
+			auto beginRecord(
+				std::uint64_t timestamp,
+				std::uint8_t level,
+				std::uint32_t callSiteId,
+				std::string_view format,
+				std::size_t argumentsCount
+			) noexcept -> void {
+				__internals::writeByte(m_payload, static_cast<std::uint8_t> (ChunkKind::eRecord));
+				__internals::writeFixed64(m_payload, timestamp);
+				__internals::writeByte(m_payload, level);
+				__internals::writeVarint(m_payload, callSiteId);
+				if (callSiteId == 0)
+					__internals::writeString(m_payload, format);
+				__internals::writeVarint(m_payload, argumentsCount);
+			}
+
+			template <typename T>
+			auto encode(const T &value) noexcept -> void;
+
+			[[nodiscard]]
+			auto getGeneration() const noexcept -> std::uint64_t {return m_generation;}
+
+			/*
+			 * @brief The descriptions written in the chunk so far. Only valid until `takeChunk`
+			 * */
+			[[nodiscard]]
+			auto getDefinitions() const noexcept -> std::string_view {return m_definitions;}
+
+			/*
+			 * @brief The complete chunk : descriptions followed by the record
+			 * */
+			[[nodiscard]]
+			auto takeChunk() noexcept -> std::string {
+				if (m_definitions.empty())
+					return std::move(m_payload);
+				m_definitions += m_payload;
+				return std::move(m_definitions);
+			}
+
+			[[nodiscard]]
+			auto takeDefinitions() noexcept -> PendingDefinitions {
+				return PendingDefinitions{m_generation, std::move(m_pendingDefinitions)};
+			}
+
+
+		private:
+			auto shouldDefine(std::atomic<std::uint64_t> &definedGeneration) noexcept -> bool {
+				if (definedGeneration.load(std::memory_order_relaxed) == m_generation)
+					return false;
+				if (std::ranges::find(m_pendingDefinitions, &definedGeneration) != m_pendingDefinitions.end())
+					return false;
+				m_pendingDefinitions.push_back(&definedGeneration);
+				return true;
+			}
+
+			template <flex::reflectable T>
+			auto encodeStruct(const T &value) noexcept -> void;
+
+			std::uint64_t m_generation;
+			std::string m_definitions;
+			std::string m_payload;
+			std::vector<std::atomic<std::uint64_t>*> m_pendingDefinitions;
+	};
+
+
+	template <typename T>
+	auto Encoder::encode(const T &value) noexcept -> void {
+		using Type = std::remove_cvref_t<T>;
+		using namespace __internals;
+
+		if constexpr (std::same_as<Type, std::nullptr_t> || std::same_as<Type, std::nullopt_t>)
+			writeByte(m_payload, static_cast<std::uint8_t> (ValueTag::eNull));
+		else if constexpr (std::same_as<Type, bool>) {
+			writeByte(m_payload, static_cast<std::uint8_t> (ValueTag::eBool));
+			writeByte(m_payload, value ? 1 : 0);
+		}
+		else if constexpr (std::same_as<Type, char>) {
+			writeByte(m_payload, static_cast<std::uint8_t> (ValueTag::eString));
+			writeString(m_payload, std::string_view{&value, 1});
+		}
+		else if constexpr (flex::string<Type>) {
+			writeByte(m_payload, static_cast<std::uint8_t> (ValueTag::eString));
+			writeString(m_payload, std::string_view{value});
+		}
+		else if constexpr (std::signed_integral<Type>) {
+			writeByte(m_payload, static_cast<std::uint8_t> (ValueTag::eSigned));
+			writeSigned(m_payload, static_cast<std::int64_t> (value));
+		}
+		else if constexpr (std::unsigned_integral<Type>) {
+			writeByte(m_payload, static_cast<std::uint8_t> (ValueTag::eUnsigned));
+			writeVarint(m_payload, static_cast<std::uint64_t> (value));
+		}
+		else if constexpr (std::floating_point<Type>) {
+			writeByte(m_payload, static_cast<std::uint8_t> (ValueTag::eFloat));
+			writeFixed64(m_payload, std::bit_cast<std::uint64_t> (static_cast<double> (value)));
+		}
+		else if constexpr (flex::enumeration<Type>) {
+			writeByte(m_payload, static_cast<std::uint8_t> (ValueTag::eEnum));
+			writeSigned(m_payload, static_cast<std::int64_t> (value));
+			writeString(m_payload, flex::toString(value).value_or(""));
+		}
+		else if constexpr (flex::optional<Type>) {
+			if (!value)
+				writeByte(m_payload, static_cast<std::uint8_t> (ValueTag::eNull));
+			else
+				this->encode(*value);
+		}
+		else if constexpr (std::ranges::sized_range<const Type>) {
+			writeByte(m_payload, static_cast<std::uint8_t> (ValueTag::eList));
+			writeVarint(m_payload, static_cast<std::uint64_t> (std::ranges::size(value)));
+			for (const auto &element : value)
+				this->encode(element);
+		}
+		else if constexpr (flex::reflectable<Type>)
+			this->encodeStruct(value);
+		else {
+			writeByte(m_payload, static_cast<std::uint8_t> (ValueTag::eFormatted));
+			writeString(m_payload, std::format("{}", value));
+		}
+	}
+
+	template <flex::reflectable T>
+	auto Encoder::encodeStruct(const T &value) noexcept -> void {
+		using namespace __internals;
+		constexpr std::size_t MEMBERS_COUNT {flex::reflection_members_count_v<T>};
+		const std::uint32_t id {BinaryType<T>::getId()};
+
+		if (this->shouldDefine(BinaryType<T>::definedGeneration)) {
+			writeByte(m_definitions, static_cast<std::uint8_t> (ChunkKind::eType));
+			writeVarint(m_definitions, id);
+			writeVarint(m_definitions, MEMBERS_COUNT);
+			std::apply([this](const auto &...names) {
+				(writeString(m_definitions, names), ...);
+			}, flex::reflection_members_names_v<T>);
+		}
+
+		writeByte(m_payload, static_cast<std::uint8_t> (ValueTag::eStruct));
+		writeVarint(m_payload, id);
+		writeVarint(m_payload, MEMBERS_COUNT);
+		[this, &value]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+			(this->encode(static_cast<const std::tuple_element_t<INDICES, flex::reflection_members_t<T>>&> (
+				flex::reflection_traits<T>::template getMember<INDICES> (value)
+			)), ...);
+		}(std::make_index_sequence<MEMBERS_COUNT> {});
+	}
+
+
+	enum class DecodeResult {
+		eSuccess = 0,
+		eInvalidHeader,
+		eUnsupportedVersion,
+		eTruncated,
+		eInvalidChunk,
+		eInvalidValue
+	};
+
+	enum class DecodeOutputFormat {
+		eText,
+		eJson
+	};
+
+	/*
+	 * @brief Turn a binary stream back into one line of text or one JSON object per record
+	 *
+	 * The descriptions of call sites and types are kept between calls to `decode`, so the
+	 * segments of a rotated log can be decoded one after the other.
+	 * */
+	class Decoder final {
+		public:
+			Decoder(DecodeOutputFormat outputFormat) noexcept :
+				m_outputFormat {outputFormat},
+				m_callSites {},
+				m_types {}
+			{}
+
+			/*
+			 * @brief Decode `data`, appending the result to `output`
+			 *
+			 * The records decoded before an error are kept in `output`.
+			 * */
+			auto decode(std::span<const std::byte> data, std::string &output) noexcept -> DecodeResult;
+
+		private:
+			struct CallSite {
+				std::uint8_t level;
+				std::string file;
+				std::uint64_t line;
+				std::string function;
+				std::string format;
+			};
+
+			DecodeOutputFormat m_outputFormat;
+			std::unordered_map<std::uint32_t, CallSite> m_callSites;
+			std::unordered_map<std::uint32_t, std::vector<std::string>> m_types;
+	};
+
+} // namespace flex::logger::binary
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include "flex/typeTraits.hpp"
+
+
+namespace flex::logger {
+	/*
+	 * @brief Opt-in for the trivially copyable types whose bytes are their whole value, without any
+	 *        pointer, reference or view to other data, so that they can be deferred
+	 * */
+	template <typename T>
+	struct is_deferrable_pod : std::false_type {};
+
+	template <typename T>
+	constexpr auto is_deferrable_pod_v = is_deferrable_pod<T>::value;
+
+	/*
+	 * @brief An argument that can be captured as raw bytes and formatted later, on another thread
+	 *
+	 * Strings are captured by content. Arithmetic types, enums and the types of
+	 * `is_deferrable_pod` are captured by a `memcpy`. Anything else, like spans, iterators or
+	 * structs holding pointers, may refer to data gone by the time the writer thread formats it,
+	 * so it's formatted right away.
+	 * */
+	template <typename T>
+	concept deferrable_argument = flex::string<std::remove_cvref_t<T>>
+		|| flex::arithmetic<std::remove_cvref_t<T>>
+		|| std::is_enum_v<std::remove_cvref_t<T>>
+		|| (is_deferrable_pod_v<std::remove_cvref_t<T>> && std::is_trivially_copyable_v<std::remove_cvref_t<T>>);
+
+
+	template <deferrable_argument T>
+	struct deferred_argument : flex::type_constant<std::remove_cvref_t<T>> {};
+
+	template <deferrable_argument T>
+	requires flex::string<std::remove_cvref_t<T>>
+	struct deferred_argument<T> : flex::type_constant<std::string_view> {};
+
+	/*
+	 * @brief The type an argument is rebuilt as on the consumer side
+	 * */
+	template <deferrable_argument T>
+	using deferred_argument_t = typename deferred_argument<T>::type;
+
+
+	/*
+	 * @brief Signature of the function that rebuilds the arguments captured by `encodeArguments`
+	 *        and formats them with the given format string
+	 * */
+	using DeferredDecoder = auto (*)(std::string_view format, const std::byte *arguments) -> std::string;
+
+
+	namespace __internals {
+		template <typename T>
+		constexpr auto toStringView(const T &string) noexcept -> std::string_view {
+			if constexpr (std::is_pointer_v<T> || std::is_array_v<T>)
+				return std::string_view{string};
+			else
+				return string;
+		}
+
+
+		template <deferrable_argument T>
+		constexpr auto getArgumentSize(const T &argument) noexcept -> std::size_t {
+			if constexpr (flex::string<std::remove_cvref_t<T>>)
+				return sizeof(std::uint32_t) + toStringView(argument).size();
+			else
+				return sizeof(T);
+		}
+
+		template <deferrable_argument T>
+		auto encodeArgument(std::byte *output, const T &argument) noexcept -> std::byte* {
+			if constexpr (flex::string<std::remove_cvref_t<T>>) {
+				const std::string_view string {toStringView(argument)};
+				const auto size {static_cast<std::uint32_t> (string.size())};
+				std::memcpy(output, &size, sizeof(size));
+				std::memcpy(output + sizeof(size), string.data(), size);
+				return output + sizeof(size) + size;
+			}
+			else {
+				std::memcpy(output, &argument, sizeof(T));
+				return output + sizeof(T);
+			}
+		}
+
+		template <typename T>
+		auto decodeArgument(const std::byte *&input) noexcept -> T {
+			if constexpr (std::same_as<T, std::string_view>) {
+				std::uint32_t size {};
+				std::memcpy(&size, input, sizeof(size));
+				const std::string_view string {reinterpret_cast<const char*> (input + sizeof(size)), size};
+				input += sizeof(size) + size;
+				return string;
+			}
+			else {
+				T value;
+				std::memcpy(&value, input, sizeof(T));
+				input += sizeof(T);
+				return value;
+			}
+		}
+
+		template <typename ...Stored>
+		auto decodeAndFormat(std::string_view format, [[maybe_unused]] const std::byte *arguments) -> std::string {
+			// braced initialization guarantees the left-to-right evaluation of the decoding
+			std::tuple<Stored...> values {decodeArgument<Stored> (arguments)...};
+			return std::apply([format](auto &...decoded) {
+				return std::vformat(format, std::make_format_args(decoded...));
+			}, values);
+		}
+
+	} // namespace __internals
+
+
+	/*
+	 * @brief The amount of bytes `encodeArguments` needs to capture `args`
+	 * */
+	template <deferrable_argument ...Args>
+	constexpr auto getEncodedArgumentsSize(const Args &...args) noexcept -> std::size_t {
+		return (0uz + ... + __internals::getArgumentSize(args));
+	}
+
+	/*
+	 * @brief Capture `args` into `output`, which must hold at least `getEncodedArgumentsSize(args...)` bytes
+	 * */
+	template <deferrable_argument ...Args>
+	auto encodeArguments([[maybe_unused]] std::byte *output, const Args &...args) noexcept -> void {
+		((output = __internals::encodeArgument(output, args)), ...);
+	}
+
+	/*
+	 * @brief The decoder able to rebuild and format arguments captured from `Args...`
+	 * */
+	template <deferrable_argument ...Args>
+	constexpr DeferredDecoder deferred_decoder_v {&__internals::decodeAndFormat<deferred_argument_t<Args>...>};
+
+} // namespace flex::logger
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "flex/config.hpp"
+
+
+namespace flex::logger {
+	/*
+	 * @brief A destination of the records of the logger
+	 *
+	 * A sink receives chunks of complete lines, each ending with `\n`. `write` can be called from
+	 * several threads at once, so implementations must be thread-safe.
+	 * */
+	class Sink {
+		public:
+			Sink() noexcept = default;
+			virtual ~Sink() = default;
+
+			Sink(const Sink&) = delete;
+			auto operator=(const Sink&) -> Sink& = delete;
+			Sink(Sink&&) = delete;
+			auto operator=(Sink&&) -> Sink& = delete;
+
+			virtual auto write(std::span<const std::string_view> chunks) noexcept -> void = 0;
+			virtual auto flush() noexcept -> void {}
+
+			using StreamPrologue = auto (*) (std::string &output) noexcept -> void;
+
+			/*
+			 * @brief Set what a sink writes first in every new stream it starts by itself, like the
+			 *        files of a rotating sink, so that each of them can be read on its own
+			 *
+			 * The binary format of the logger uses it for its header and descriptions.
+			 * */
+			static auto setStreamPrologue(StreamPrologue prologue) noexcept -> void {
+				s_streamPrologue.store(prologue, std::memory_order_release);
+			}
+
+		protected:
+			[[nodiscard]]
+			static auto getStreamPrologue() noexcept -> std::string {
+				std::string output {};
+				if (const StreamPrologue prologue {s_streamPrologue.load(std::memory_order_acquire)}; prologue != nullptr)
+					prologue(output);
+				return output;
+			}
+
+		private:
+			static inline constinit std::atomic<StreamPrologue> s_streamPrologue {nullptr};
+	};
+
+
+	/*
+	 * @brief Write to a `std::ostream`, taking a lock per call and flushing after it
+	 * */
+	class OStreamSink final : public Sink {
+		public:
+			OStreamSink(std::ostream &stream) noexcept : m_stream {stream}, m_mutex {} {}
+			~OStreamSink() override = default;
+
+			auto write(std::span<const std::string_view> chunks) noexcept -> void override;
+			auto flush() noexcept -> void override;
+
+		private:
+			std::ostream &m_stream;
+			std::mutex m_mutex;
+	};
+
+
+	/*
+	 * @brief Write straight to a file descriptor with `write(2)` / `writev(2)`, without any lock
+	 *
+	 * A call to `write` hands all its chunks to the kernel in a single `writev(2)`, which is atomic
+	 * for regular files opened with `O_APPEND` and for pipes below `PIPE_BUF`.
+	 *
+	 * @note Only available on POSIX systems. Elsewhere the records are discarded
+	 * */
+	class FileDescriptorSink final : public Sink {
+		public:
+			FileDescriptorSink(int fileDescriptor) noexcept : m_fileDescriptor {fileDescriptor} {}
+			~FileDescriptorSink() override = default;
+
+			auto write(std::span<const std::string_view> chunks) noexcept -> void override;
+
+		private:
+			int m_fileDescriptor;
+	};
+
+
+	/*
+	 * @brief Keep the last `capacity` lines in memory
+	 * */
+	class MemoryRingSink final : public Sink {
+		public:
+			MemoryRingSink(std::size_t capacity) noexcept;
+			~MemoryRingSink() override = default;
+
+			auto write(std::span<const std::string_view> chunks) noexcept -> void override;
+
+			/*
+			 * @brief A copy of the kept lines, from the oldest to the newest, without their trailing `\n`
+			 * */
+			[[nodiscard]]
+			auto getLines() const noexcept -> std::vector<std::string>;
+
+		private:
+			std::vector<std::string> m_lines;
+			std::size_t m_next;
+			std::size_t m_count;
+			mutable std::mutex m_mutex;
+	};
+
+
+	/*
+	 * @brief Write to a set of rotating files, through memory mappings of preallocated segments
+	 *
+	 * Each file is a segment of `segmentSize` bytes, preallocated with `fallocate(2)` (or extended
+	 * with `ftruncate(2)` where it's not available) and mapped in memory, so writing a chunk is a
+	 * `memcpy` and never a syscall. A background thread always keeps the next segment ready,
+	 * finalizes the retired ones (truncation to their used size, unmapping, retention) and rotates
+	 * the segments that outlived `rotationInterval`, so the rotation itself is a swap of mappings.
+	 *
+	 * Files are named `<path>.<index>`, `index` starting after the highest one already on disk. The
+	 * files already on disk count in `maxFilesCount`, so the retention holds across restarts. Every
+	 * file but the first starts with the stream prologue, see `Sink::setStreamPrologue`.
+	 *
+	 * @note Only available on POSIX systems. Elsewhere the records are discarded
+	 * */
+	class RotatingFileSink final : public Sink {
+		public:
+			struct CreateInfo {
+				std::filesystem::path path;
+				std::size_t segmentSize {64 * 1024 * 1024};
+				/*
+				 * @brief Rotate when a segment is older than this. Zero disables time-based rotation
+				 * */
+				std::chrono::seconds rotationInterval {0};
+				/*
+				 * @brief The amount of files to keep on disk. Zero keeps every file
+				 * */
+				std::size_t maxFilesCount {0};
+			};
+
+			RotatingFileSink(const CreateInfo &createInfo) noexcept;
+			~RotatingFileSink() override;
+
+			auto write(std::span<const std::string_view> chunks) noexcept -> void override;
+			auto flush() noexcept -> void override;
+
+			/*
+			 * @brief Whether the sink managed to open its first segment
+			 * */
+			[[nodiscard]]
+			auto isValid() const noexcept -> bool;
+
+		private:
+			struct Segment {
+				std::filesystem::path path;
+				int fileDescriptor;
+				std::byte *data;
+				std::size_t used;
+				std::size_t prologueSize;
+				std::chrono::steady_clock::time_point deadline;
+			};
+
+			auto makeSegmentPath(std::size_t index) const noexcept -> std::filesystem::path;
+			auto openSegment(const std::filesystem::path &path) noexcept -> std::optional<Segment>;
+			auto closeSegment(Segment &segment) noexcept -> void;
+			/*
+			 * @brief Take the oldest files out of the retention list, the lock being held
+			 * */
+			auto popExpiredFiles() noexcept -> std::vector<std::filesystem::path>;
+			auto rotate(std::unique_lock<std::mutex> &lock) noexcept -> bool;
+			auto runMaintenance(std::stop_token stopToken) noexcept -> void;
+
+			CreateInfo m_createInfo;
+			std::size_t m_nextIndex;
+			bool m_openFailed;
+			mutable std::mutex m_mutex;
+			std::condition_variable_any m_condition;
+			std::optional<Segment> m_current;
+			std::optional<Segment> m_next;
+			std::vector<Segment> m_retired;
+			/*
+			 * @brief The finished files still on disk, those of the previous runs included, and the
+			 *        current one, from the oldest
+			 * */
+			std::deque<std::filesystem::path> m_files;
+			std::jthread m_maintenanceThread;
+	};
+
+} // namespace flex::logger
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "flex/compare.hpp"
+#include "flex/reflection/layout.hpp"
+#include "flex/reflection/reflection.hpp"
+#include "flex/serialization.hpp"
+
+
+/*
+ * Patches
+ *
+ * A patch holds the members of a reflectable object that changed since a previous state of it.
+ * It uses the binary encoding of `flex::serialize`, so both ends must agree on `T`.
+ *
+ *   patch        : LEB128 varint count of changed members, then for each of them in order
+ *                    LEB128 varint gap since the previous changed index (the first one counts from -1)
+ *                    the member as a patch if it's a reflectable itself, its full encoding otherwise
+ *
+ * An unchanged object is a single byte.
+ * */
+namespace flex {
+	namespace __internals {
+		/*
+		 * @brief The types patched member by member instead of being sent whole
+		 * */
+		template <typename T>
+		concept patchable = flex::reflectable<T>
+			&& !custom_serialization<T>
+			&& !std::ranges::range<T>
+			&& !tuple_like<T>
+			&& (flex::reflection_members_count_v<T> != 0);
+
+
+		template <serialization::buffer Buffer, patchable T>
+		auto writePatch(serialization::Writer<Buffer> &writer, const T &previous, const T &current) -> void {
+			const auto changes {flex::diff(previous, current)};
+			writer.writeVarint(static_cast<std::uint64_t> (changes.count()));
+			if (changes.none())
+				return;
+
+			std::size_t nextIndex {0};
+			[&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+				([&]() {
+					if (!changes.test(INDICES))
+						return;
+					writer.writeVarint(static_cast<std::uint64_t> (INDICES - nextIndex));
+					nextIndex = INDICES + 1;
+
+					using Member = reflection_member_value_t<INDICES, T>;
+					if constexpr (patchable<Member>)
+						writePatch(writer, getMemberValue<INDICES> (previous), getMemberValue<INDICES> (current));
+					else
+						serializeValue(writer, getMemberValue<INDICES> (current));
+				}(), ...);
+			}(std::make_index_sequence<flex::reflection_members_count_v<T>> {});
+		}
+
+
+		template <patchable T>
+		auto readPatch(serialization::Reader &reader, T &value) -> bool;
+
+		template <std::size_t INDEX, patchable T>
+		auto readPatchMember(serialization::Reader &reader, T &value) -> bool {
+			using Member = reflection_member_value_t<INDEX, T>;
+			const auto readMember {[&reader](Member &member) {
+				if constexpr (patchable<Member>)
+					return readPatch(reader, member);
+				else
+					return deserializeValue(reader, member);
+			}};
+
+			using Access = decltype(flex::reflection_traits<T>::template getMember<INDEX> (value));
+			if constexpr (std::is_lvalue_reference_v<Access>)
+				return readMember(flex::reflection_traits<T>::template getMember<INDEX> (value));
+			else {
+				// getter / setter pair : patch a copy of the current value and hand it to the setter
+				Member member {static_cast<Member> (flex::reflection_traits<T>::template getMember<INDEX> (value))};
+				if (!readMember(member))
+					return false;
+				flex::reflection_traits<T>::template getMember<INDEX> (value) = std::move(member);
+				return true;
+			}
+		}
+
+		template <patchable T>
+		auto readPatch(serialization::Reader &reader, T &value) -> bool {
+			constexpr std::size_t COUNT {flex::reflection_members_count_v<T>};
+			std::uint64_t changesCount {};
+			if (!reader.readVarint(changesCount))
+				return false;
+			if (changesCount > COUNT)
+				return reader.fail(DeserializeError::eInvalidValue);
+
+			std::size_t nextIndex {0};
+			for (std::uint64_t i {0}; i < changesCount; ++i) {
+				std::uint64_t gap {};
+				if (!reader.readVarint(gap))
+					return false;
+				if (gap >= COUNT - nextIndex)
+					return reader.fail(DeserializeError::eInvalidValue);
+				const std::size_t index {nextIndex + static_cast<std::size_t> (gap)};
+				nextIndex = index + 1;
+
+				const bool success {[&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					bool result {false};
+					((index == INDICES ? (result = readPatchMember<INDICES> (reader, value), true) : false) || ...);
+					return result;
+				}(std::make_index_sequence<COUNT> {})};
+				if (!success)
+					return false;
+			}
+			return true;
+		}
+
+	} // namespace __internals
+
+
+	/*
+	 * @brief Append to `buffer` the patch turning `previous` into `current`
+	 * */
+	template <__internals::patchable T, serialization::buffer Buffer>
+	auto makePatch(const T &previous, const T &current, Buffer &buffer) -> void {
+		serialization::Writer<Buffer> writer {buffer};
+		__internals::writePatch(writer, previous, current);
+	}
+
+	template <__internals::patchable T>
+	[[nodiscard]]
+	auto makePatch(const T &previous, const T &current) -> std::vector<std::byte> {
+		std::vector<std::byte> buffer {};
+		makePatch(previous, current, buffer);
+		return buffer;
+	}
+
+	/*
+	 * @brief Apply a patch that spans the whole of `patch` to `value`
+	 *
+	 * On failure `value` may have been partially patched, the members before the faulty one being
+	 * already updated.
+	 * */
+	template <__internals::patchable T>
+	auto applyPatch(T &value, std::span<const std::byte> patch) -> std::expected<void, DeserializeError> {
+		serialization::Reader reader {patch};
+		if (!__internals::readPatch(reader, value))
+			return std::unexpected(reader.getError().value_or(DeserializeError::eInvalidValue));
+		if (reader.getRemainingSize() != 0)
+			return std::unexpected(DeserializeError::eTrailingBytes);
+		return {};
+	}
+
+} // namespace flex
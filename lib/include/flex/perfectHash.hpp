@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+
+namespace flex::__internals {
+	constexpr auto hashKey(std::string_view key, std::uint32_t seed) noexcept -> std::uint32_t {
+		std::uint32_t hash {2166136261u ^ seed};
+		for (char character : key) {
+			hash ^= static_cast<std::uint8_t> (character);
+			hash *= 16777619u;
+		}
+		return hash ^ (hash >> 15);
+	}
+
+	/*
+	 * @brief A perfect hash of the distinct strings of `KEYS`, searched at compile time
+	 *
+	 * Every key lands in its own slot of a power of two table, so a lookup is a hash, a mask and a
+	 * single string comparison.
+	 * */
+	template <const auto &KEYS>
+	struct PerfectHash {
+		static constexpr std::size_t COUNT {std::size(KEYS)};
+		static constexpr std::size_t EMPTY_SLOT {COUNT};
+
+		struct Table {
+			std::uint32_t seed;
+			std::size_t size;
+		};
+
+		static consteval auto trySeed(std::uint32_t seed, std::size_t size) noexcept -> bool {
+			std::vector<bool> used (size, false);
+			for (std::string_view key : KEYS) {
+				const std::size_t slot {hashKey(key, seed) & (size - 1)};
+				if (used[slot])
+					return false;
+				used[slot] = true;
+			}
+			return true;
+		}
+
+		static consteval auto findTable() noexcept -> Table {
+			for (std::size_t size {std::bit_ceil(std::max<std::size_t> (COUNT * 2, 1))}; ; size *= 2) {
+				for (std::uint32_t seed {0}; seed < 64; ++seed) {
+					if (trySeed(seed, size))
+						return {seed, size};
+				}
+			}
+		}
+
+		static constexpr Table TABLE {findTable()};
+
+		static consteval auto computeSlots() noexcept -> std::array<std::size_t, TABLE.size> {
+			std::array<std::size_t, TABLE.size> slots {};
+			slots.fill(EMPTY_SLOT);
+			for (std::size_t i {0}; i < COUNT; ++i)
+				slots[hashKey(KEYS[i], TABLE.seed) & (TABLE.size - 1)] = i;
+			return slots;
+		}
+
+		static constexpr std::array<std::size_t, TABLE.size> SLOTS {computeSlots()};
+
+		/*
+		 * @brief The index of `key` in `KEYS`, or `COUNT` if it's not one of them
+		 * */
+		static constexpr auto find(std::string_view key) noexcept -> std::size_t {
+			const std::size_t index {SLOTS[hashKey(key, TABLE.seed) & (TABLE.size - 1)]};
+			if (index == EMPTY_SLOT || KEYS[index] != key)
+				return COUNT;
+			return index;
+		}
+	};
+
+} // namespace flex::__internals
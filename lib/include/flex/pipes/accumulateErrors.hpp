@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "flex/errorType.hpp"
+#include "flex/pipes/pipes.hpp"
+
+
+namespace flex::pipes {
+	/*
+	 * @brief The error recorded for a failed element, `std::monostate` for the error types without
+	 *        payload like `std::optional`
+	 * */
+	template <flex::error_type T>
+	struct accumulated_error {
+		using type = std::monostate;
+	};
+
+	template <flex::error_type_with_error T>
+	struct accumulated_error<T> {
+		using type = flex::error_type_error_t<T>;
+	};
+
+	template <flex::error_type T>
+	using accumulated_error_t = typename accumulated_error<T>::type;
+
+
+	/*
+	 * @brief Gathers the failures of a batch, with the position of the failing element
+	 *
+	 * The storage is allocated once at construction. Once `capacity` failures are stored, the next
+	 * ones are only counted, so recording a failure never allocates. Not thread-safe, `par` reports
+	 * the failed indices by itself.
+	 * */
+	template <typename Error>
+	class ErrorAccumulator final {
+		public:
+			struct Failure {
+				std::size_t index;
+				Error error;
+			};
+
+			ErrorAccumulator(std::size_t capacity) :
+				m_failures {},
+				m_processedCount {0},
+				m_droppedCount {0}
+			{
+				m_failures.reserve(capacity);
+			}
+			~ErrorAccumulator() = default;
+
+			ErrorAccumulator(const ErrorAccumulator&) = delete;
+			auto operator=(const ErrorAccumulator&) -> ErrorAccumulator& = delete;
+
+			template <typename Entry>
+			requires flex::error_type<std::remove_cvref_t<Entry>>
+			auto record(const Entry &entry) noexcept(std::is_nothrow_copy_constructible_v<Error>) -> void {
+				using Traits = flex::error_type_traits<std::remove_cvref_t<Entry>>;
+				const std::size_t index {m_processedCount++};
+				if (Traits::hasValue(entry))
+					return;
+				if (m_failures.size() == m_failures.capacity()) {
+					++m_droppedCount;
+					return;
+				}
+				if constexpr (flex::error_type_with_error<std::remove_cvref_t<Entry>>)
+					m_failures.push_back(Failure{index, Error{Traits::getError(entry)}});
+				else
+					m_failures.push_back(Failure{index, Error{}});
+			}
+
+			auto clear() noexcept -> void {
+				m_failures.clear();
+				m_processedCount = 0;
+				m_droppedCount = 0;
+			}
+
+			auto getFailures() const noexcept -> std::span<const Failure> {return m_failures;}
+			auto getProcessedCount() const noexcept -> std::size_t {return m_processedCount;}
+			/*
+			 * @brief The number of failures that didn't fit in the capacity
+			 * */
+			auto getDroppedCount() const noexcept -> std::size_t {return m_droppedCount;}
+			auto hasFailed() const noexcept -> bool {return !m_failures.empty() || m_droppedCount != 0;}
+
+
+		private:
+			std::vector<Failure> m_failures;
+			std::size_t m_processedCount;
+			std::size_t m_droppedCount;
+	};
+
+
+	/*
+	 * @brief Records the failures of the error types going through it in an `ErrorAccumulator`, and
+	 *        lets them through untouched
+	 *
+	 * The index of a failure is the number of elements that went through the accumulator before it,
+	 * so `range | ... | accumulate_errors(errors)` reports the position of the element in `range`.
+	 * */
+	template <typename Error>
+	class AccumulateErrorsPipe final : public flex::pipes::BasicPipeObject<AccumulateErrorsPipe<Error>> {
+		public:
+			constexpr AccumulateErrorsPipe(ErrorAccumulator<Error> &accumulator) noexcept : m_accumulator {&accumulator} {}
+			constexpr ~AccumulateErrorsPipe() = default;
+
+			template <typename Entry>
+			requires flex::error_type<std::remove_cvref_t<Entry>>
+				&& std::same_as<accumulated_error_t<std::remove_cvref_t<Entry>>, Error>
+			[[nodiscard]]
+			constexpr auto operator()(Entry &&entry) noexcept(std::is_nothrow_copy_constructible_v<Error>) -> std::remove_cvref_t<Entry> {
+				m_accumulator->record(entry);
+				return std::forward<Entry> (entry);
+			}
+
+		private:
+			ErrorAccumulator<Error> *m_accumulator;
+	};
+
+	template <typename Error>
+	AccumulateErrorsPipe(ErrorAccumulator<Error> &accumulator) -> AccumulateErrorsPipe<Error>;
+
+
+	constexpr flex::pipes::TemplatedPipeAdaptator<AccumulateErrorsPipe> accumulate_errors {};
+
+} // namespace flex::pipes
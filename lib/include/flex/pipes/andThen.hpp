@@ -6,16 +6,16 @@
 
 namespace flex::pipes {
 	template <typename Callback>
-	class AndThenPipe final {
+	class AndThenPipe final : public flex::pipes::BasicPipeObject<AndThenPipe<Callback>> {
 		public:
 			constexpr AndThenPipe(Callback &&callback) noexcept : m_callback {std::forward<Callback> (callback)} {}
 			constexpr ~AndThenPipe() = default;
 
-			template <typename Optional>
-			requires flex::optional<std::remove_cvref_t<Optional>>
+			template <typename Entry>
+			requires flex::error_type<std::remove_cvref_t<Entry>>
 			[[nodiscard]]
-			constexpr auto operator()(Optional &&optional) noexcept {
-				return optional.and_then(m_callback);
+			constexpr auto operator()(Entry &&entry) noexcept {
+				return __internals::bindErrorType(std::forward<Entry> (entry), m_callback);
 			}
 
 		private:
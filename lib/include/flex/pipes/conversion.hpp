@@ -9,7 +9,7 @@
 
 namespace flex::pipes {
 	template <typename T>
-	class StaticCastToPipe final {
+	class StaticCastToPipe final : public flex::pipes::BasicPipeObject<StaticCastToPipe<T>> {
 		public:
 			constexpr StaticCastToPipe() noexcept = default;
 			constexpr ~StaticCastToPipe() = default;
@@ -20,13 +20,13 @@ namespace flex::pipes {
 				return static_cast<T> (value);
 			}
 
-			template <typename Optional>
-			requires flex::optional<std::remove_cvref_t<Optional>>
+			template <typename Entry>
+			requires flex::rebindable_error_type<std::remove_cvref_t<Entry>>
 			[[nodiscard]]
-			constexpr auto operator()(Optional &&optional) noexcept -> std::optional<T> {
-				if (!optional)
-					return std::nullopt;
-				return (*this)(*optional);
+			constexpr auto operator()(Entry &&entry) noexcept {
+				return __internals::mapErrorType(std::forward<Entry> (entry), [this](auto &&value) {
+					return (*this)(std::forward<decltype(value)> (value));
+				});
 			}
 	};
 
@@ -35,7 +35,7 @@ namespace flex::pipes {
 
 
 	template <typename T>
-	class ReinterpretCastToPipe final {
+	class ReinterpretCastToPipe final : public flex::pipes::BasicPipeObject<ReinterpretCastToPipe<T>> {
 		public:
 			constexpr ReinterpretCastToPipe() noexcept = default;
 			constexpr ~ReinterpretCastToPipe() = default;
@@ -46,13 +46,13 @@ namespace flex::pipes {
 				return reinterpret_cast<T> (value);
 			}
 
-			template <typename Optional>
-			requires flex::optional<std::remove_cvref_t<Optional>>
+			template <typename Entry>
+			requires flex::rebindable_error_type<std::remove_cvref_t<Entry>>
 			[[nodiscard]]
-			constexpr auto operator()(Optional &&optional) noexcept -> std::optional<T> {
-				if (!optional)
-					return std::nullopt;
-				return (*this)(*optional);
+			constexpr auto operator()(Entry &&entry) noexcept {
+				return __internals::mapErrorType(std::forward<Entry> (entry), [this](auto &&value) {
+					return (*this)(std::forward<decltype(value)> (value));
+				});
 			}
 	};
 
@@ -61,7 +61,7 @@ namespace flex::pipes {
 
 
 	template <typename T>
-	class DynamicCastToPipe final {
+	class DynamicCastToPipe final : public flex::pipes::BasicPipeObject<DynamicCastToPipe<T>> {
 		using ReturnType = std::conditional_t<flex::reference<T>,
 			flex::Reference<std::remove_reference_t<T>>,
 			T
@@ -92,13 +92,13 @@ namespace flex::pipes {
 					return res;
 			}
 
-			template <typename Optional>
-			requires flex::optional<std::remove_cvref_t<Optional>>
+			template <typename Entry>
+			requires flex::rebindable_error_type<std::remove_cvref_t<Entry>>
 			[[nodiscard]]
-			constexpr auto operator()(Optional &&optional) noexcept -> std::optional<ReturnType> {
-				if (!optional)
-					return std::nullopt;
-				return (*this)(*optional);
+			constexpr auto operator()(Entry &&entry) noexcept {
+				return __internals::chainErrorType(std::forward<Entry> (entry), [this](auto &&value) {
+					return (*this)(std::forward<decltype(value)> (value));
+				});
 			}
 	};
 
@@ -107,7 +107,7 @@ namespace flex::pipes {
 
 
 	template <typename T>
-	class AnyCastToPipe final {
+	class AnyCastToPipe final : public flex::pipes::BasicPipeObject<AnyCastToPipe<T>> {
 		public:
 			constexpr AnyCastToPipe() noexcept = default;
 			constexpr ~AnyCastToPipe() = default;
@@ -123,14 +123,14 @@ namespace flex::pipes {
 				return std::any_cast<T> (any);
 			}
 
-			template <typename Optional>
-			requires flex::optional<std::remove_cvref_t<Optional>>
-				&& std::same_as<std::remove_cvref_t<typename std::remove_cvref_t<Optional>::value_type>, std::any>
+			template <typename Entry>
+			requires flex::rebindable_error_type<std::remove_cvref_t<Entry>>
+				&& std::same_as<std::remove_cvref_t<flex::error_type_value_t<std::remove_cvref_t<Entry>>>, std::any>
 			[[nodiscard]]
-			constexpr auto operator()(Optional &&optional) noexcept -> std::optional<T> {
-				if (!optional)
-					return std::nullopt;
-				return (*this)(*optional);
+			constexpr auto operator()(Entry &&entry) noexcept {
+				return __internals::chainErrorType(std::forward<Entry> (entry), [this](auto &&value) {
+					return (*this)(std::forward<decltype(value)> (value));
+				});
 			}
 	};
 
@@ -140,7 +140,7 @@ namespace flex::pipes {
 
 
 	template <flex::no_cv_reference T>
-	class ConstructToPipe final {
+	class ConstructToPipe final : public flex::pipes::BasicPipeObject<ConstructToPipe<T>> {
 		public:
 			constexpr ConstructToPipe() noexcept = default;
 			constexpr ~ConstructToPipe() = default;
@@ -151,13 +151,13 @@ namespace flex::pipes {
 				return T{value};
 			};
 
-			template <typename Optional>
-			requires flex::optional<std::remove_cvref_t<Optional>>
+			template <typename Entry>
+			requires flex::rebindable_error_type<std::remove_cvref_t<Entry>>
 			[[nodiscard]]
-			constexpr auto operator()(Optional &&optional) noexcept -> std::optional<T> {
-				if (!optional)
-					return std::nullopt;
-				return (*this)(*optional);
+			constexpr auto operator()(Entry &&entry) noexcept {
+				return __internals::mapErrorType(std::forward<Entry> (entry), [this](auto &&value) {
+					return (*this)(std::forward<decltype(value)> (value));
+				});
 			}
 	};
 
@@ -5,16 +5,16 @@
 
 
 namespace flex::pipes {
-	class HasValuePipe final {
+	class HasValuePipe final : public flex::pipes::BasicPipeObject<HasValuePipe> {
 		public:
 			constexpr HasValuePipe() noexcept = default;
 			constexpr ~HasValuePipe() = default;
 
-			template <typename Optional>
-			requires flex::optional<std::remove_cvref_t<Optional>>
+			template <typename Entry>
+			requires flex::error_type<std::remove_cvref_t<Entry>>
 			[[nodiscard]]
-			constexpr auto operator()(Optional &&optional) noexcept {
-				return optional.has_value();
+			constexpr auto operator()(Entry &&entry) noexcept -> bool {
+				return flex::error_type_traits<std::remove_cvref_t<Entry>>::hasValue(entry);
 			}
 	};
 
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <vector>
+
+#include "flex/errorType.hpp"
+#include "flex/pipes/pipes.hpp"
+#include "flex/threadPool.hpp"
+
+
+namespace flex::pipes {
+	/*
+	 * @brief The ordered results of a parallel pipe, with the ascending indices of the elements
+	 *        whose result holds an error when the pipe yields an error type
+	 * */
+	template <typename Result>
+	struct ParallelResults {
+		std::vector<Result> results;
+		std::vector<std::size_t> failedIndices;
+	};
+
+
+	namespace __internals {
+		/*
+		 * @brief The part of the range still owned by a thread, which takes chunks from its front
+		 *        while the other threads steal halves from its back
+		 *
+		 * Both bounds are packed in a single atomic so each side needs a single CAS.
+		 * */
+		class alignas(64) StealableRange final {
+			public:
+				struct Bounds {
+					std::uint32_t begin;
+					std::uint32_t end;
+				};
+
+				auto reset(Bounds bounds) noexcept -> void {
+					m_bounds.store(pack(bounds), std::memory_order_release);
+				}
+
+				auto takeFront(std::uint32_t count) noexcept -> Bounds {
+					std::uint64_t packed {m_bounds.load(std::memory_order_acquire)};
+					while (true) {
+						const Bounds bounds {unpack(packed)};
+						if (bounds.begin >= bounds.end)
+							return {0, 0};
+						const std::uint32_t end {bounds.end - bounds.begin > count ? bounds.begin + count : bounds.end};
+						if (m_bounds.compare_exchange_weak(packed, pack({end, bounds.end}), std::memory_order_acq_rel))
+							return {bounds.begin, end};
+					}
+				}
+
+				auto stealBack() noexcept -> Bounds {
+					std::uint64_t packed {m_bounds.load(std::memory_order_acquire)};
+					while (true) {
+						const Bounds bounds {unpack(packed)};
+						if (bounds.begin >= bounds.end)
+							return {0, 0};
+						const std::uint32_t middle {bounds.begin + (bounds.end - bounds.begin) / 2};
+						if (m_bounds.compare_exchange_weak(packed, pack({bounds.begin, middle}), std::memory_order_acq_rel))
+							return {middle, bounds.end};
+					}
+				}
+
+			private:
+				static constexpr auto pack(Bounds bounds) noexcept -> std::uint64_t {
+					return (static_cast<std::uint64_t> (bounds.begin) << 32) | bounds.end;
+				}
+
+				static constexpr auto unpack(std::uint64_t packed) noexcept -> Bounds {
+					return {static_cast<std::uint32_t> (packed >> 32), static_cast<std::uint32_t> (packed)};
+				}
+
+				std::atomic<std::uint64_t> m_bounds {0};
+		};
+
+
+		/*
+		 * @brief The duration a chunk aims for. Long enough to amortize the CAS and the clock, short
+		 *        enough for the last chunks to balance between threads
+		 * */
+		constexpr std::chrono::nanoseconds PARALLEL_CHUNK_DURATION {std::chrono::microseconds(50)};
+		constexpr std::uint32_t PARALLEL_MAX_CHUNK_SIZE {1 << 16};
+
+		/*
+		 * @brief Calls `process(threadIndex, begin, end)` over `[0, size)` on every thread of
+		 *        `pool`, with work stealing and chunks sized from the measured cost per element
+		 * */
+		template <typename Process>
+		auto parallelFor(ThreadPool &pool, std::uint32_t size, Process &&process) -> void {
+			const std::size_t threadsCount {pool.getThreadsCount()};
+			const std::unique_ptr<StealableRange[]> ranges {std::make_unique<StealableRange[]> (threadsCount)};
+			for (std::size_t i {0}; i < threadsCount; ++i) {
+				ranges[i].reset({
+					static_cast<std::uint32_t> (size * i / threadsCount),
+					static_cast<std::uint32_t> (size * (i + 1) / threadsCount)
+				});
+			}
+
+			pool.run([&](std::size_t threadIndex) {
+				std::uint32_t chunkSize {1};
+				StealableRange &ownRange {ranges[threadIndex]};
+				while (true) {
+					const auto chunk {ownRange.takeFront(chunkSize)};
+					if (chunk.begin == chunk.end) {
+						bool hasStolen {false};
+						for (std::size_t i {1}; !hasStolen && i < threadsCount; ++i) {
+							const auto stolen {ranges[(threadIndex + i) % threadsCount].stealBack()};
+							if (stolen.begin != stolen.end) {
+								ownRange.reset(stolen);
+								hasStolen = true;
+							}
+						}
+						if (!hasStolen)
+							return;
+						continue;
+					}
+
+					const auto start {std::chrono::steady_clock::now()};
+					process(threadIndex, chunk.begin, chunk.end);
+					const auto duration {std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now() - start)};
+
+					const auto nanosecondsPerElement {std::max<std::int64_t> (duration.count() / (chunk.end - chunk.begin), 1)};
+					chunkSize = static_cast<std::uint32_t> (std::clamp<std::int64_t> (
+						PARALLEL_CHUNK_DURATION.count() / nanosecondsPerElement, 1, PARALLEL_MAX_CHUNK_SIZE
+					));
+				}
+			});
+		}
+
+	} // namespace __internals
+
+
+	/*
+	 * @brief Applies a *PipeObject* to every element of a random access range on a `ThreadPool`
+	 *
+	 * The result is a `ParallelResults`, in the order of the range. With `UNSEQUENCED`, the pipe
+	 * promises that the elements of a chunk can be processed in any order, which lets the compiler
+	 * vectorize the loop of a chunk.
+	 * */
+	template <typename PipeObject, bool UNSEQUENCED>
+	class ParallelPipe final : public flex::pipes::BasicPipeObject<ParallelPipe<PipeObject, UNSEQUENCED>> {
+		public:
+			constexpr ParallelPipe(PipeObject pipeObject, ThreadPool &pool = ThreadPool::getDefault()) noexcept :
+				m_pipeObject {std::move(pipeObject)},
+				m_pool {&pool}
+			{}
+			constexpr ~ParallelPipe() = default;
+
+			template <std::ranges::random_access_range Range>
+			requires std::ranges::sized_range<Range>
+			[[nodiscard]]
+			auto operator()(Range &&range) const {
+				using Result = std::remove_cvref_t<decltype(std::declval<PipeObject&> ()(*std::ranges::begin(range)))>;
+				static_assert(std::default_initializable<Result>, "The results of a parallel pipe are built in place, so they must be default initializable");
+
+				ParallelResults<Result> output {};
+				const auto size {static_cast<std::size_t> (std::ranges::size(range))};
+				output.results.resize(size);
+				std::vector<std::vector<std::size_t>> threadsFailedIndices (m_pool->getThreadsCount());
+
+				const auto process {[&](std::size_t threadIndex, std::size_t offset, std::uint32_t begin, std::uint32_t end) {
+					PipeObject pipeObject {m_pipeObject};
+					auto iterator {std::ranges::begin(range) + static_cast<std::ranges::range_difference_t<Range>> (offset + begin)};
+					Result *results {output.results.data() + offset};
+					if constexpr (UNSEQUENCED && !flex::error_type<Result>) {
+					#if defined(__GNUC__) && !defined(__clang__)
+						#pragma GCC ivdep
+					#endif
+						for (std::uint32_t i {begin}; i < end; ++i)
+							results[i] = pipeObject(iterator[i - begin]);
+					}
+					else {
+						for (std::uint32_t i {begin}; i < end; ++i, ++iterator) {
+							results[i] = pipeObject(*iterator);
+							if constexpr (flex::error_type<Result>) {
+								if (!flex::error_type_traits<Result>::hasValue(results[i]))
+									threadsFailedIndices[threadIndex].push_back(offset + i);
+							}
+						}
+					}
+				}};
+
+				// the bounds of the stealable ranges are 32 bits wide, bigger ranges go in several passes
+				constexpr std::size_t MAX_PASS_SIZE {std::numeric_limits<std::uint32_t>::max()};
+				for (std::size_t offset {0}; offset < size; offset += MAX_PASS_SIZE) {
+					const auto passSize {static_cast<std::uint32_t> (std::min(size - offset, MAX_PASS_SIZE))};
+					__internals::parallelFor(*m_pool, passSize, [&](std::size_t threadIndex, std::uint32_t begin, std::uint32_t end) {
+						process(threadIndex, offset, begin, end);
+					});
+				}
+
+				for (const auto &failedIndices : threadsFailedIndices)
+					output.failedIndices.insert(output.failedIndices.end(), failedIndices.begin(), failedIndices.end());
+				std::ranges::sort(output.failedIndices);
+				return output;
+			}
+
+		private:
+			PipeObject m_pipeObject;
+			ThreadPool *m_pool;
+	};
+
+
+	template <pipe_object PipeObject>
+	[[nodiscard]]
+	constexpr auto par(PipeObject &&pipeObject, ThreadPool &pool = ThreadPool::getDefault()) noexcept {
+		return ParallelPipe<std::remove_cvref_t<PipeObject>, false> {std::forward<PipeObject> (pipeObject), pool};
+	}
+
+	template <pipe_object PipeObject>
+	[[nodiscard]]
+	constexpr auto par_unseq(PipeObject &&pipeObject, ThreadPool &pool = ThreadPool::getDefault()) noexcept {
+		return ParallelPipe<std::remove_cvref_t<PipeObject>, true> {std::forward<PipeObject> (pipeObject), pool};
+	}
+
+} // namespace flex::pipes
@@ -1,9 +1,14 @@
 #pragma once
 
 #include <concepts>
+#include <iterator>
+#include <ranges>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
+#include "flex/errorType.hpp"
+
 
 namespace flex::pipes {
 	/**
@@ -46,8 +51,19 @@ namespace flex::pipes {
 	 * */
 
 
+	/**
+	 * @brief The base of every *PipeObject* of flex, which is what allows two of them to be
+	 *        composed into a `Pipeline` with `operator|`
+	 * */
 	template <typename PipeObject>
-	class BasicPipeObject;
+	class BasicPipeObject {};
+
+	/**
+	 * @brief A concept for the types deriving from `BasicPipeObject`
+	 * */
+	template <typename T>
+	concept pipe_object = std::derived_from<std::remove_cvref_t<T>, BasicPipeObject<std::remove_cvref_t<T>>>;
+
 
 	namespace __internals {
 		template <typename PipeObject, typename EntryType>
@@ -55,6 +71,66 @@ namespace flex::pipes {
 			pipe(entry);
 		};
 
+
+		/*
+		 * @brief The value of the error type `entry`, with the value category of `Entry`
+		 * */
+		template <typename Entry>
+		constexpr auto forwardValue(std::remove_reference_t<Entry> &entry) noexcept -> decltype(auto) {
+			auto &value {flex::error_type_traits<std::remove_cvref_t<Entry>>::getValue(entry)};
+			using Value = std::remove_reference_t<decltype(value)>;
+			if constexpr (std::is_lvalue_reference_v<Entry>)
+				return static_cast<Value&> (value);
+			else
+				return static_cast<Value&&> (value);
+		}
+
+		/*
+		 * @brief Wraps the result of `function` on the value of `entry` in the same kind of error type
+		 *        as `entry`, or carries the failure of `entry` untouched
+		 * */
+		template <typename Entry, typename Function>
+		requires flex::rebindable_error_type<std::remove_cvref_t<Entry>>
+		constexpr auto mapErrorType(Entry &&entry, Function &&function) {
+			using Traits = flex::error_type_traits<std::remove_cvref_t<Entry>>;
+			using Value = std::remove_cvref_t<decltype(function(forwardValue<Entry> (entry)))>;
+			using Result = typename Traits::template Rebind<Value>;
+			if (!Traits::hasValue(entry))
+				return flex::error_type_traits<Result>::fromErrorOf(std::forward<Entry> (entry));
+			return Result{function(forwardValue<Entry> (entry))};
+		}
+
+		/*
+		 * @brief The result of `function` on the value of `entry`, which must itself be an error type
+		 *        able to carry the failure of `entry`
+		 * */
+		template <typename Entry, typename Function>
+		requires flex::error_type<std::remove_cvref_t<Entry>>
+		constexpr auto bindErrorType(Entry &&entry, Function &&function) {
+			using Traits = flex::error_type_traits<std::remove_cvref_t<Entry>>;
+			using Result = std::remove_cvref_t<decltype(function(forwardValue<Entry> (entry)))>;
+			static_assert(flex::rebindable_error_type<Result>, "The callback must return an error type");
+			if (!Traits::hasValue(entry))
+				return flex::error_type_traits<Result>::fromErrorOf(std::forward<Entry> (entry));
+			return Result{function(forwardValue<Entry> (entry))};
+		}
+
+		/*
+		 * @brief Applies a `function` that can fail itself to the value of `entry`
+		 *
+		 * Two failures without payload, like `std::optional`, are merged into one. Otherwise the
+		 * result of `function` is wrapped with `mapErrorType`, so a payload is never dropped.
+		 * */
+		template <typename Entry, typename Function>
+		requires flex::rebindable_error_type<std::remove_cvref_t<Entry>>
+		constexpr auto chainErrorType(Entry &&entry, Function &&function) {
+			using Result = std::remove_cvref_t<decltype(function(forwardValue<Entry> (entry)))>;
+			if constexpr (flex::error_type_without_error<std::remove_cvref_t<Entry>> && flex::error_type_without_error<Result> && flex::rebindable_error_type<Result>)
+				return bindErrorType(std::forward<Entry> (entry), std::forward<Function> (function));
+			else
+				return mapErrorType(std::forward<Entry> (entry), std::forward<Function> (function));
+		}
+
 	} // namespace __internals
 
 
@@ -74,13 +150,114 @@ namespace flex::pipes {
 	/**
 	 * @ingroup PipeObject
 	 * @brief An overloading of pipe operator for incomplete pipe, that is pipe with only operator()
+	 * @note Views are only piped into flex *PipeObject*, so that the range adaptors of the
+	 *       standard keep working on the views of `lazy`
 	 * */
-	template <typename EntryType, __internals::incomplete_pipe<EntryType> PipeObject>
+	template <typename EntryType, typename PipeObject>
+	requires (!pipe_object<EntryType>)
+		&& (pipe_object<PipeObject> || !std::ranges::view<std::remove_cvref_t<EntryType>>)
+		&& __internals::incomplete_pipe<PipeObject, EntryType>
 	constexpr auto operator|(EntryType &&entry, PipeObject &&pipeObject) noexcept {
 		return pipeObject(std::forward<EntryType> (entry));
 	}
 
 
+	/**
+	 * @ingroup PipeObject
+	 * @brief A *PipeObject* made of other ones, applied in order within a single call
+	 *
+	 * It's built by `operator|` between two *PipeObject*, like `to_number<int> () | value_or(0)`,
+	 * and is applied like any of them, or to whole ranges with `lazy` and `apply_into`.
+	 * */
+	template <typename ...Pipes>
+	class Pipeline final : public BasicPipeObject<Pipeline<Pipes...>> {
+		static_assert(sizeof...(Pipes) != 0, "A pipeline needs at least one pipe");
+
+		public:
+			constexpr Pipeline(std::tuple<Pipes...> pipes) noexcept : m_pipes {std::move(pipes)} {}
+			constexpr ~Pipeline() = default;
+
+			template <typename EntryType>
+			[[nodiscard]]
+			constexpr auto operator()(EntryType &&entry) noexcept {
+				return this->applyFrom<0> (std::forward<EntryType> (entry));
+			}
+
+			constexpr auto getPipes() const & noexcept -> const std::tuple<Pipes...>& {return m_pipes;}
+			constexpr auto getPipes() && noexcept -> std::tuple<Pipes...>&& {return std::move(m_pipes);}
+
+		private:
+			template <std::size_t INDEX, typename EntryType>
+			constexpr auto applyFrom(EntryType &&entry) noexcept {
+				if constexpr (INDEX + 1 == sizeof...(Pipes))
+					return std::get<INDEX> (m_pipes)(std::forward<EntryType> (entry));
+				else
+					return this->applyFrom<INDEX + 1> (std::get<INDEX> (m_pipes)(std::forward<EntryType> (entry)));
+			}
+
+			std::tuple<Pipes...> m_pipes;
+	};
+
+
+	namespace __internals {
+		template <typename T>
+		struct is_pipeline : std::false_type {};
+
+		template <typename ...Pipes>
+		struct is_pipeline<Pipeline<Pipes...>> : std::true_type {};
+
+		template <pipe_object PipeObject>
+		constexpr auto getPipelineStages(PipeObject &&pipeObject) noexcept {
+			if constexpr (is_pipeline<std::remove_cvref_t<PipeObject>>::value)
+				return std::forward<PipeObject> (pipeObject).getPipes();
+			else
+				return std::tuple<std::remove_cvref_t<PipeObject>> {std::forward<PipeObject> (pipeObject)};
+		}
+
+		template <typename ...Pipes>
+		constexpr auto makePipeline(std::tuple<Pipes...> &&pipes) noexcept -> Pipeline<Pipes...> {
+			return Pipeline<Pipes...> {std::move(pipes)};
+		}
+
+	} // namespace __internals
+
+
+	/**
+	 * @ingroup PipeObject
+	 * @brief Composes two *PipeObject* into a `Pipeline`, flattening the pipelines among them
+	 * */
+	template <pipe_object Lhs, pipe_object Rhs>
+	constexpr auto operator|(Lhs &&lhs, Rhs &&rhs) noexcept {
+		return __internals::makePipeline(std::tuple_cat(
+			__internals::getPipelineStages(std::forward<Lhs> (lhs)),
+			__internals::getPipelineStages(std::forward<Rhs> (rhs))
+		));
+	}
+
+
+	/**
+	 * @brief A view applying `pipeObject` to each element of `range` when it's read
+	 * */
+	template <std::ranges::viewable_range Range, pipe_object PipeObject>
+	[[nodiscard]]
+	constexpr auto lazy(Range &&range, PipeObject &&pipeObject) {
+		return std::views::transform(std::forward<Range> (range), std::forward<PipeObject> (pipeObject));
+	}
+
+	/**
+	 * @brief Applies `pipeObject` to each element of `range`, writing the results to `output`
+	 * @return The iterator past the last written result
+	 * */
+	template <std::ranges::input_range Range, pipe_object PipeObject, std::weakly_incrementable Output>
+	constexpr auto apply_into(Range &&range, PipeObject &&pipeObject, Output output) -> Output {
+		for (auto &&element : range) {
+			*output = pipeObject(std::forward<decltype(element)> (element));
+			++output;
+		}
+		return output;
+	}
+
+
 	/**
 	 * @brief A wrapper type that allow the construction of *PipeObject*
 	 * @sa PipeObject
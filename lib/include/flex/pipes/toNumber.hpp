@@ -1,8 +1,20 @@
 #pragma once
 
+#include <bit>
 #include <charconv>
+#include <cstdint>
 #include <cstring>
+#include <expected>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <system_error>
 #include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+	#include <immintrin.h>
+#endif
 
 #include "flex/pipes/pipes.hpp"
 #include "flex/typeTraits.hpp"
@@ -10,7 +22,7 @@
 
 namespace flex::pipes {
 	template <flex::arithmetic T>
-	class ToNumberPipe final {
+	class ToNumberPipe final : public flex::pipes::BasicPipeObject<ToNumberPipe<T>> {
 		static constexpr auto COND {std::integral<T>};
 		using Args = std::conditional_t<COND, int, std::chars_format>;
 		static constexpr auto DEFAULT_ARGS {flex::conditional_value_v<COND, 10, std::chars_format{}>};
@@ -31,7 +43,7 @@ namespace flex::pipes {
 				}
 				else {
 					start = string;
-					end = std::strlen(string);
+					end = start + std::strlen(string);
 				}
 				T number {};
 				[[maybe_unused]]
@@ -41,13 +53,13 @@ namespace flex::pipes {
 				return number;
 			}
 
-			template <typename Optional>
-			requires flex::optional<std::remove_cvref_t<Optional>>
+			template <typename Entry>
+			requires flex::rebindable_error_type<std::remove_cvref_t<Entry>>
 			[[nodiscard]]
-			constexpr auto operator()(Optional &&optional) noexcept -> std::optional<T> {
-				if (!optional)
-					return std::nullopt;
-				return (*this)(*optional);
+			constexpr auto operator()(Entry &&entry) noexcept {
+				return __internals::chainErrorType(std::forward<Entry> (entry), [this](auto &&value) {
+					return (*this)(std::forward<decltype(value)> (value));
+				});
 			}
 
 		private:
@@ -60,4 +72,200 @@ namespace flex::pipes {
 	template <typename T>
 	constexpr flex::pipes::PipeAdaptator<ToNumberPipe<T>> to_number {};
 
+
+	/*
+	 * @brief The first failure of `to_numbers`
+	 *
+	 * `code` is `std::errc::invalid_argument` for a field that isn't a number, `std::errc::result_out_of_range`
+	 * for a number that doesn't fit in `T` and `std::errc::value_too_large` when the output is full.
+	 * `position` is the offset in the input of the field at fault.
+	 * */
+	struct ToNumbersError {
+		std::errc code;
+		std::size_t position;
+
+		constexpr auto operator==(const ToNumbersError&) const noexcept -> bool = default;
+	};
+
+
+	namespace __internals {
+		/*
+		 * @brief The first occurrence of `character` in `[begin, end)`, or `end`
+		 * */
+		inline auto findCharacter(const char *begin, const char *end, char character) noexcept -> const char* {
+		#if defined(__AVX2__)
+			const __m256i pattern {_mm256_set1_epi8(character)};
+			for (; end - begin >= 32; begin += 32) {
+				const __m256i block {_mm256_loadu_si256(reinterpret_cast<const __m256i*> (begin))};
+				const auto mask {static_cast<std::uint32_t> (_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)))};
+				if (mask != 0)
+					return begin + std::countr_zero(mask);
+			}
+		#endif
+		#if defined(__SSE2__) || defined(_M_X64)
+			const __m128i smallPattern {_mm_set1_epi8(character)};
+			for (; end - begin >= 16; begin += 16) {
+				const __m128i block {_mm_loadu_si128(reinterpret_cast<const __m128i*> (begin))};
+				const auto mask {static_cast<std::uint32_t> (_mm_movemask_epi8(_mm_cmpeq_epi8(block, smallPattern)))};
+				if (mask != 0)
+					return begin + std::countr_zero(mask);
+			}
+		#endif
+			for (; begin != end; ++begin) {
+				if (*begin == character)
+					return begin;
+			}
+			return end;
+		}
+
+		/*
+		 * @brief The number of occurrences of `character` in `[begin, end)`
+		 * */
+		inline auto countCharacter(const char *begin, const char *end, char character) noexcept -> std::size_t {
+			std::size_t count {0};
+		#if defined(__AVX2__)
+			const __m256i pattern {_mm256_set1_epi8(character)};
+			for (; end - begin >= 32; begin += 32) {
+				const __m256i block {_mm256_loadu_si256(reinterpret_cast<const __m256i*> (begin))};
+				count += static_cast<std::size_t> (std::popcount(static_cast<std::uint32_t> (_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)))));
+			}
+		#endif
+		#if defined(__SSE2__) || defined(_M_X64)
+			const __m128i smallPattern {_mm_set1_epi8(character)};
+			for (; end - begin >= 16; begin += 16) {
+				const __m128i block {_mm_loadu_si128(reinterpret_cast<const __m128i*> (begin))};
+				count += static_cast<std::size_t> (std::popcount(static_cast<std::uint32_t> (_mm_movemask_epi8(_mm_cmpeq_epi8(block, smallPattern)))));
+			}
+		#endif
+			for (; begin != end; ++begin)
+				count += *begin == character;
+			return count;
+		}
+
+
+		/*
+		 * @brief Whether the 8 bytes of `chunk` are all ASCII digits
+		 * */
+		constexpr auto isEightDigits(std::uint64_t chunk) noexcept -> bool {
+			return (((chunk & 0xf0f0f0f0f0f0f0f0) | (((chunk + 0x0606060606060606) & 0xf0f0f0f0f0f0f0f0) >> 4)) == 0x3333333333333333);
+		}
+
+		/*
+		 * @brief The value of 8 ASCII digits loaded in little-endian order, computed as pairs,
+		 *        then quads, then the whole chunk
+		 * */
+		constexpr auto parseEightDigits(std::uint64_t chunk) noexcept -> std::uint32_t {
+			chunk = ((chunk & 0x0f0f0f0f0f0f0f0f) * 2561) >> 8;
+			chunk = ((chunk & 0x00ff00ff00ff00ff) * 6553601) >> 16;
+			return static_cast<std::uint32_t> (((chunk & 0x0000ffff0000ffff) * 42949672960001) >> 32);
+		}
+
+		/*
+		 * @brief Parses the field `[begin, end)` as an integer, 8 digits at a time while possible.
+		 *        Fields too long for the fast path go through `std::from_chars`
+		 * */
+		template <std::integral T>
+		auto parseInteger(const char *begin, const char *end, T &value) noexcept -> std::errc {
+			constexpr std::size_t MAX_FAST_DIGITS {std::numeric_limits<std::uint64_t>::digits10};
+
+			const char *digits {begin};
+			bool negative {false};
+			if constexpr (std::signed_integral<T>) {
+				if (digits != end && *digits == '-') {
+					negative = true;
+					++digits;
+				}
+			}
+			if (digits == end || static_cast<std::size_t> (end - digits) > MAX_FAST_DIGITS) {
+				const auto [ptr, err] {std::from_chars(begin, end, value)};
+				if (err == std::errc{} && ptr != end)
+					return std::errc::invalid_argument;
+				return err;
+			}
+
+			std::uint64_t magnitude {0};
+			if constexpr (std::endian::native == std::endian::little) {
+				for (; end - digits >= 8; digits += 8) {
+					std::uint64_t chunk {};
+					std::memcpy(&chunk, digits, sizeof(chunk));
+					if (!isEightDigits(chunk))
+						return std::errc::invalid_argument;
+					magnitude = magnitude * 100'000'000 + parseEightDigits(chunk);
+				}
+			}
+			for (; digits != end; ++digits) {
+				const auto digit {static_cast<std::uint8_t> (*digits - '0')};
+				if (digit > 9)
+					return std::errc::invalid_argument;
+				magnitude = magnitude * 10 + digit;
+			}
+
+			using Unsigned = std::make_unsigned_t<T>;
+			constexpr auto MAX {static_cast<std::uint64_t> (std::numeric_limits<T>::max())};
+			if (magnitude > MAX + negative)
+				return std::errc::result_out_of_range;
+			value = negative
+				? static_cast<T> (Unsigned{0} - static_cast<Unsigned> (magnitude))
+				: static_cast<T> (magnitude);
+			return std::errc{};
+		}
+
+	} // namespace __internals
+
+
+	/*
+	 * @brief Parses the `delimiter` separated numbers of `input` into `output`
+	 * @return The count of parsed numbers, or the first failure. An empty input holds no number,
+	 *         while an empty field is invalid
+	 * */
+	template <flex::arithmetic T>
+	requires (!std::same_as<T, bool>)
+	auto to_numbers(std::string_view input, char delimiter, std::span<T> output) noexcept -> std::expected<std::size_t, ToNumbersError> {
+		if (input.empty())
+			return 0;
+
+		const char *const begin {input.data()};
+		const char *const end {begin + input.size()};
+		std::size_t count {0};
+		for (const char *field {begin}; ; ++field) {
+			const char *const fieldEnd {__internals::findCharacter(field, end, delimiter)};
+			const auto position {static_cast<std::size_t> (field - begin)};
+			if (count == output.size())
+				return std::unexpected(ToNumbersError{std::errc::value_too_large, position});
+
+			std::errc err {};
+			if constexpr (std::integral<T>)
+				err = __internals::parseInteger(field, fieldEnd, output[count]);
+			else {
+				const auto [ptr, fromCharsErr] {std::from_chars(field, fieldEnd, output[count])};
+				err = fromCharsErr == std::errc{} && ptr != fieldEnd ? std::errc::invalid_argument : fromCharsErr;
+			}
+			if (err != std::errc{} || field == fieldEnd)
+				return std::unexpected(ToNumbersError{field == fieldEnd ? std::errc::invalid_argument : err, position});
+
+			++count;
+			if (fieldEnd == end)
+				return count;
+			field = fieldEnd;
+		}
+	}
+
+	/*
+	 * @brief Appends the `delimiter` separated numbers of `input` to `output`, which is left
+	 *        untouched on failure
+	 * */
+	template <flex::arithmetic T, typename Allocator>
+	requires (!std::same_as<T, bool>)
+	auto to_numbers(std::string_view input, char delimiter, std::vector<T, Allocator> &output) -> std::expected<std::size_t, ToNumbersError> {
+		if (input.empty())
+			return 0;
+
+		const std::size_t previousSize {output.size()};
+		output.resize(previousSize + __internals::countCharacter(input.data(), input.data() + input.size(), delimiter) + 1);
+		const auto result {to_numbers<T> (input, delimiter, std::span<T> {output}.subspan(previousSize))};
+		if (!result)
+			output.resize(previousSize);
+		return result;
+	}
+
 } // namespace flex::pipes
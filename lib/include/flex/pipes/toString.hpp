@@ -1,17 +1,81 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <charconv>
 #include <format>
+#include <iterator>
+#include <limits>
 #include <locale>
-#include <vector>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
 
+#include "flex/inplaceString.hpp"
 #include "flex/pipes/pipes.hpp"
 #include "flex/reflection/enums.hpp"
 #include "flex/typeTraits.hpp"
 
 
 namespace flex::pipes {
-	class ToStringPipe {
+	namespace __internals {
+		constexpr auto countDigits(std::size_t value) noexcept -> std::size_t {
+			std::size_t count {1};
+			for (; value >= 10; value /= 10)
+				++count;
+			return count;
+		}
+
+		/*
+		 * @brief An upper bound of the size `std::to_chars` needs for any `T`, that is its digits and
+		 *        sign, plus the point and the exponent of the scientific form for floating points
+		 * */
+		template <flex::arithmetic T>
+		constexpr std::size_t to_chars_max_size_v {[]() -> std::size_t {
+			using Limits = std::numeric_limits<T>;
+			if constexpr (std::same_as<T, bool>)
+				return std::string_view{"false"}.size();
+			else if constexpr (std::integral<T>)
+				return static_cast<std::size_t> (Limits::digits10) + 1 + Limits::is_signed;
+			else
+				return static_cast<std::size_t> (Limits::max_digits10) + std::string_view{"-.e-"}.size()
+					+ countDigits(static_cast<std::size_t> (std::max(Limits::max_exponent10, Limits::max_digits10 - Limits::min_exponent10)));
+		}()};
+
+		/*
+		 * @brief Writes `value` in `[begin, end)`, returns the end of the written characters or
+		 *        `nullptr` if they don't fit
+		 * */
+		template <flex::arithmetic T>
+		constexpr auto writeNumber(char *begin, char *end, T value) noexcept -> char* {
+			if constexpr (std::same_as<T, bool>) {
+				const std::string_view text {value ? "true" : "false"};
+				if (static_cast<std::size_t> (end - begin) < text.size())
+					return nullptr;
+				return std::ranges::copy(text, begin).out;
+			}
+			else {
+				const auto [ptr, err] {std::to_chars(begin, end, value)};
+				if (err != std::errc{})
+					return nullptr;
+				return ptr;
+			}
+		}
+
+	} // namespace __internals
+
+
+	/*
+	 * @brief A string large enough for any `T`, living on the stack
+	 * */
+	template <flex::arithmetic T>
+	using NumberString = flex::InplaceString<__internals::to_chars_max_size_v<T>>;
+
+
+	class ToStringPipe : public flex::pipes::BasicPipeObject<ToStringPipe> {
 		public:
 			constexpr ToStringPipe(std::optional<std::locale> locale = std::nullopt) noexcept : m_locale {locale} {}
 			constexpr ~ToStringPipe() = default;
@@ -22,17 +86,8 @@ namespace flex::pipes {
 				using T = std::remove_cvref_t<Stringifyable>;
 				if constexpr (flex::arithmetic<T>) {
 					if (!m_locale) {
-						constexpr std::size_t chunkSize {16};
-						std::vector<char> buffer {};
-						std::errc err {};
-						char *ptr {nullptr};
-						do {
-							buffer.resize(buffer.size() + chunkSize);
-							const auto [_ptr, _err] {std::to_chars(buffer.data(), buffer.data() + buffer.size(), stringifyable)};
-							err = _err;
-							ptr = _ptr;
-						} while (err == std::errc::value_too_large);
-						return std::string{buffer.data(), ptr};
+						std::array<char, __internals::to_chars_max_size_v<T>> buffer {};
+						return std::string{buffer.data(), __internals::writeNumber(buffer.data(), buffer.data() + buffer.size(), stringifyable)};
 					}
 					else
 						return std::format(*m_locale, "{}", stringifyable);
@@ -53,15 +108,13 @@ namespace flex::pipes {
 					return flex::toString(stringifyable);
 			}
 
-			template <typename Optional>
-			requires flex::optional<std::remove_cvref_t<Optional>>
+			template <typename Entry>
+			requires flex::rebindable_error_type<std::remove_cvref_t<Entry>>
 			[[nodiscard]]
-			constexpr auto operator()(Optional &&optional) noexcept {
-				using Result = decltype((*this)(*optional));
-				using OptionalResult = std::conditional_t<flex::optional<Result>, Result, std::optional<Result>>;
-				if (!optional)
-					return OptionalResult{std::nullopt};
-				return OptionalResult{(*this)(*optional)};
+			constexpr auto operator()(Entry &&entry) noexcept {
+				return __internals::chainErrorType(std::forward<Entry> (entry), [this](auto &&value) {
+					return (*this)(std::forward<decltype(value)> (value));
+				});
 			}
 
 		private:
@@ -71,4 +124,157 @@ namespace flex::pipes {
 
 	constexpr flex::pipes::PipeAdaptator<ToStringPipe> to_string {};
 
+
+	/*
+	 * @brief Converts numbers into a `NumberString`, without any allocation
+	 * */
+	class ToInplaceStringPipe final : public flex::pipes::BasicPipeObject<ToInplaceStringPipe> {
+		public:
+			constexpr ToInplaceStringPipe() noexcept = default;
+			constexpr ~ToInplaceStringPipe() = default;
+
+			template <flex::arithmetic T>
+			[[nodiscard]]
+			constexpr auto operator()(T value) const noexcept -> NumberString<T> {
+				NumberString<T> string {};
+				string.resize(static_cast<std::size_t> (__internals::writeNumber(string.data(), string.data() + string.capacity(), value) - string.data()));
+				return string;
+			}
+
+			template <typename Entry>
+			requires flex::rebindable_error_type<std::remove_cvref_t<Entry>>
+			[[nodiscard]]
+			constexpr auto operator()(Entry &&entry) const noexcept {
+				return __internals::mapErrorType(std::forward<Entry> (entry), [this](auto &&value) {
+					return (*this)(std::forward<decltype(value)> (value));
+				});
+			}
+	};
+
+	constexpr flex::pipes::PipeAdaptator<ToInplaceStringPipe> to_inplace_string {};
+
+
+	/*
+	 * @brief Converts numbers into a caller-provided output, without any allocation
+	 *
+	 * With a `std::span<char>` the result is the written part, or `std::nullopt` if the span is too
+	 * small. With a `flex::InplaceString<N>&` the number is appended, with the same result. With an
+	 * output iterator, the result is the iterator past the written characters.
+	 * */
+	template <typename Output>
+	class ToStringIntoPipe final : public flex::pipes::BasicPipeObject<ToStringIntoPipe<Output>> {
+		public:
+			constexpr ToStringIntoPipe(Output output) noexcept : m_output {output} {}
+			constexpr ~ToStringIntoPipe() = default;
+
+			template <flex::arithmetic T>
+			[[nodiscard]]
+			constexpr auto operator()(T value) noexcept {
+				if constexpr (std::same_as<Output, std::span<char>>) {
+					char *const end {__internals::writeNumber(m_output.data(), m_output.data() + m_output.size(), value)};
+					if (end == nullptr)
+						return std::optional<std::string_view> {};
+					return std::optional<std::string_view> {std::string_view{m_output.data(), end}};
+				}
+				else if constexpr (requires {m_output.capacity(); m_output.resize(0uz);}) {
+					const std::size_t size {m_output.size()};
+					char *const end {__internals::writeNumber(m_output.data() + size, m_output.data() + m_output.capacity(), value)};
+					if (end == nullptr)
+						return std::optional<std::string_view> {};
+					m_output.resize(static_cast<std::size_t> (end - m_output.data()));
+					return std::optional<std::string_view> {std::string_view{m_output.data() + size, end}};
+				}
+				else {
+					std::array<char, __internals::to_chars_max_size_v<T>> buffer {};
+					char *const end {__internals::writeNumber(buffer.data(), buffer.data() + buffer.size(), value)};
+					return std::ranges::copy(buffer.data(), end, m_output).out;
+				}
+			}
+
+			template <typename Entry>
+			requires flex::rebindable_error_type<std::remove_cvref_t<Entry>>
+			[[nodiscard]]
+			constexpr auto operator()(Entry &&entry) noexcept {
+				return __internals::chainErrorType(std::forward<Entry> (entry), [this](auto &&value) {
+					return (*this)(std::forward<decltype(value)> (value));
+				});
+			}
+
+		private:
+			Output m_output;
+	};
+
+	template <std::size_t N>
+	ToStringIntoPipe(flex::InplaceString<N> &string) -> ToStringIntoPipe<flex::InplaceString<N>&>;
+
+	template <typename Buffer>
+	requires (std::convertible_to<Buffer&&, std::span<char>> && !flex::string<std::remove_cvref_t<Buffer>>)
+	ToStringIntoPipe(Buffer &&buffer) -> ToStringIntoPipe<std::span<char>>;
+
+	template <std::output_iterator<char> Iterator>
+	ToStringIntoPipe(Iterator iterator) -> ToStringIntoPipe<Iterator>;
+
+	constexpr flex::pipes::TemplatedPipeAdaptator<ToStringIntoPipe> to_string_into {};
+
+
+	/*
+	 * @brief Writes the `delimiter` separated numbers of `numbers` into `output`
+	 * @return The written part of `output`, or `std::nullopt` if it's too small
+	 * */
+	template <std::ranges::input_range Range>
+	requires flex::arithmetic<std::ranges::range_value_t<Range>>
+	constexpr auto to_strings(Range &&numbers, char delimiter, std::span<char> output) noexcept -> std::optional<std::string_view> {
+		char *current {output.data()};
+		char *const end {output.data() + output.size()};
+		bool first {true};
+		for (const auto &number : numbers) {
+			if (!std::exchange(first, false)) {
+				if (current == end)
+					return std::nullopt;
+				*current++ = delimiter;
+			}
+			current = __internals::writeNumber(current, end, number);
+			if (current == nullptr)
+				return std::nullopt;
+		}
+		return std::string_view{output.data(), current};
+	}
+
+	/*
+	 * @brief Writes the `delimiter` separated numbers of `numbers` to an output iterator
+	 * */
+	template <std::ranges::input_range Range, std::output_iterator<char> Iterator>
+	requires flex::arithmetic<std::ranges::range_value_t<Range>>
+	constexpr auto to_strings(Range &&numbers, char delimiter, Iterator output) -> Iterator {
+		using T = std::ranges::range_value_t<Range>;
+		std::array<char, __internals::to_chars_max_size_v<T>> buffer {};
+		bool first {true};
+		for (const auto &number : numbers) {
+			if (!std::exchange(first, false))
+				*output++ = delimiter;
+			char *const end {__internals::writeNumber(buffer.data(), buffer.data() + buffer.size(), number)};
+			output = std::ranges::copy(buffer.data(), end, output).out;
+		}
+		return output;
+	}
+
+	/*
+	 * @brief Appends the `delimiter` separated numbers of `numbers` to `output`, which grows at
+	 *        most once when `numbers` is sized
+	 * */
+	template <std::ranges::input_range Range>
+	requires flex::arithmetic<std::ranges::range_value_t<Range>>
+	auto to_strings(Range &&numbers, char delimiter, std::string &output) -> void {
+		using T = std::ranges::range_value_t<Range>;
+		if constexpr (std::ranges::sized_range<Range>) {
+			const std::size_t previousSize {output.size()};
+			const auto count {static_cast<std::size_t> (std::ranges::size(numbers))};
+			output.resize(previousSize + count * (__internals::to_chars_max_size_v<T> + 1));
+			const auto written {to_strings(numbers, delimiter, std::span{output}.subspan(previousSize))};
+			output.resize(previousSize + written->size());
+		}
+		else
+			to_strings(numbers, delimiter, std::back_inserter(output));
+	}
+
 } // namespace flex::pipes
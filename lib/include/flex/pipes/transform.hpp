@@ -6,7 +6,7 @@
 
 namespace flex::pipes {
 	template <typename Callback>
-	class TransformPipe final {
+	class TransformPipe final : public flex::pipes::BasicPipeObject<TransformPipe<Callback>> {
 		public:
 			constexpr TransformPipe(Callback &&callback) noexcept : m_callback {std::forward<Callback> (callback)} {}
 			constexpr ~TransformPipe() = default;
@@ -18,11 +18,11 @@ namespace flex::pipes {
 				return m_callback(std::forward<EntryType> (entry));
 			}
 
-			template <typename Optional>
-			requires flex::optional<std::remove_cvref_t<Optional>>
+			template <typename Entry>
+			requires flex::rebindable_error_type<std::remove_cvref_t<Entry>>
 			[[nodiscard]]
-			constexpr auto operator()(Optional &&optional) noexcept {
-				return optional.transform(m_callback);
+			constexpr auto operator()(Entry &&entry) noexcept {
+				return __internals::mapErrorType(std::forward<Entry> (entry), m_callback);
 			};
 
 
@@ -6,16 +6,16 @@
 
 namespace flex::pipes {
 	template <typename T>
-	class ValueOrPipe final {
+	class ValueOrPipe final : public flex::pipes::BasicPipeObject<ValueOrPipe<T>> {
 		public:
 			constexpr ValueOrPipe(T &&value) noexcept : m_value {std::forward<T> (value)} {}
 			constexpr ~ValueOrPipe() = default;
 
-			template <typename Optional>
-			requires flex::optional<std::remove_cvref_t<Optional>>
+			template <typename Entry>
+			requires flex::error_type<std::remove_cvref_t<Entry>>
 			[[nodiscard]]
-			constexpr auto operator()(Optional &&optional) noexcept {
-				return optional.value_or(m_value);
+			constexpr auto operator()(Entry &&entry) noexcept {
+				return flex::error_type_traits<std::remove_cvref_t<Entry>>::getValueOr(std::forward<Entry> (entry), m_value);
 			}
 
 		private:
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <source_location>
 #include <string_view>
+#include <utility>
 
 #include "flex/reflection/autogen/aggregateMembersTuple.hpp"
 #include "flex/reflection/aggregateMembersCount.hpp"
@@ -27,7 +28,7 @@ namespace flex::reflection {
 
 		template <std::size_t N, flex::aggregate T>
 		consteval auto makePointer() noexcept {
-			auto &member {std::get<N> (flex::reflection::makeAggregateMembersTuple(fakeObject<T>))};
+			auto &member {flex::reflection::getAggregateMember<N> (flex::reflection::makeAggregateMembersReferences(fakeObject<T>))};
 			return PointerWrapper<std::remove_reference_t<decltype(member)>> {&member};
 		}
 
@@ -63,19 +64,17 @@ namespace flex::reflection {
 	};
 
 
-	template <flex::aggregate T, std::size_t N = 0, std::size_t COUNT = flex::reflection::aggregate_members_count_v<T>>
-	struct aggregate_members_names {
-		static constexpr std::tuple value {std::tuple_cat(
-			std::make_tuple(getAggregateMemberName<N, T> ()),
-			aggregate_members_names<T, N+1, COUNT>::value
-		)};
-		using value_type = decltype(value);
-	};
+	/*
+	 * @brief The names of the members of `T`, expanded from an index sequence into an array so that
+	 *        wide aggregates don't pay for a `std::tuple` of hundreds of elements
+	 * */
+	template <flex::aggregate T, typename Indices = std::make_index_sequence<flex::reflection::aggregate_members_count_v<T>>>
+	struct aggregate_members_names;
 
-	template <flex::aggregate T, std::size_t COUNT>
-	struct aggregate_members_names<T, COUNT, COUNT> {
-		using value_type = std::tuple<>;
-		static constexpr std::tuple<> value {};
+	template <flex::aggregate T, std::size_t ...INDICES>
+	struct aggregate_members_names<T, std::index_sequence<INDICES...>> {
+		using value_type = std::array<std::string_view, sizeof...(INDICES)>;
+		static constexpr value_type value {getAggregateMemberName<INDICES, T> ()...};
 	};
 
 	template <flex::aggregate T>
@@ -84,10 +83,25 @@ namespace flex::reflection {
 
 	template <flex::aggregate T>
 	struct aggregate_members {
-		using type = flex::remove_tuple_reference_t<decltype(flex::reflection::makeAggregateMembersTuple(flex::reflection::__internals::fakeObject<T>))>;
+		using type = typename decltype(flex::reflection::makeAggregateMembersReferences(flex::reflection::__internals::fakeObject<T>))::Types;
 	};
 
 	template <flex::aggregate T>
 	using aggregate_members_t = typename aggregate_members<T>::type;
 
+
+	/*
+	 * @brief A `std::tie` of the members of `value`. The reflection itself goes through
+	 *        `makeAggregateMembersReferences`, which is much cheaper to compile for wide aggregates
+	 * */
+	template <flex::aggregate T>
+	constexpr auto makeAggregateMembersTuple(const T &value) noexcept {
+		return flex::reflection::makeAggregateMembersReferences(value).toTuple();
+	}
+
+	template <flex::aggregate T>
+	constexpr auto makeAggregateMembersTuple(T &value) noexcept {
+		return flex::reflection::makeAggregateMembersReferences(value).toTuple();
+	}
+
 } // namespace flex::reflection
@@ -2,18 +2,68 @@
 
 #include <cstddef>
 #include <type_traits>
+#include <utility>
 
 #include "flex/typeTraits.hpp"
 
 
 namespace flex::reflection {
-	template <flex::aggregate T, typename = void, typename ...Placeholders>
-	struct aggregate_members_count : std::integral_constant<std::size_t, sizeof...(Placeholders)> {};
+	namespace __internals {
+		template <std::size_t>
+		using indexed_placeholder_t = flex::AnyTypePlaceholder;
 
-	template <flex::aggregate T, typename ...Placeholders>
-	struct aggregate_members_count<T,
-		std::void_t<decltype(T{std::declval<Placeholders> ()..., std::declval<flex::AnyTypePlaceholder> ()})>
-	, Placeholders...> : aggregate_members_count<T, void, Placeholders..., flex::AnyTypePlaceholder> {};
+		template <typename T, typename Indices>
+		struct is_brace_constructible_from_placeholders : std::false_type {};
+
+		template <typename T, std::size_t ...INDICES>
+		requires requires {T{std::declval<indexed_placeholder_t<INDICES>> ()...};}
+		struct is_brace_constructible_from_placeholders<T, std::index_sequence<INDICES...>> : std::true_type {};
+
+		/*
+		 * @brief Whether `T` can be brace initialized from `COUNT` values of any type
+		 * */
+		template <typename T, std::size_t COUNT>
+		constexpr bool is_brace_constructible_from_v = is_brace_constructible_from_placeholders<T, std::make_index_sequence<COUNT>>::value;
+
+
+		/*
+		 * @brief The largest count in `[LOW, HIGH]` `T` can be brace initialized from, knowing `LOW` works
+		 * */
+		template <typename T, std::size_t LOW, std::size_t HIGH>
+		consteval auto searchAggregateMembersCount() noexcept -> std::size_t {
+			if constexpr (LOW == HIGH)
+				return LOW;
+			else {
+				constexpr std::size_t MIDDLE {LOW + (HIGH - LOW + 1) / 2};
+				if constexpr (is_brace_constructible_from_v<T, MIDDLE>)
+					return searchAggregateMembersCount<T, MIDDLE, HIGH> ();
+				else
+					return searchAggregateMembersCount<T, LOW, MIDDLE - 1> ();
+			}
+		}
+
+		/*
+		 * @brief Doubles the count until `T` can't be brace initialized from it anymore, then binary
+		 *        searches the last count that works. This takes O(log N) probes instead of N, without
+		 *        needing an upper bound
+		 * */
+		template <typename T, std::size_t BOUND = 1>
+		consteval auto findAggregateMembersCount() noexcept -> std::size_t {
+			if constexpr (is_brace_constructible_from_v<T, BOUND>)
+				return findAggregateMembersCount<T, BOUND * 2> ();
+			else
+				return searchAggregateMembersCount<T, BOUND / 2, BOUND - 1> ();
+		}
+
+	} // namespace __internals
+
+
+	/*
+	 * @brief The number of initializers `T` accepts, which is its members count as long as the members
+	 *        don't rely on brace elision (C arrays) and can all be default initialized
+	 * */
+	template <flex::aggregate T>
+	struct aggregate_members_count : std::integral_constant<std::size_t, __internals::findAggregateMembersCount<T> ()> {};
 
 	template <flex::aggregate T>
 	constexpr auto aggregate_members_count_v = aggregate_members_count<T>::value;
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace flex::reflection {
+	namespace __internals {
+		template <std::size_t INDEX, typename Member>
+		struct AggregateMemberReference {
+			Member &reference;
+		};
+
+	} // namespace __internals
+
+
+	/*
+	 * @brief References to the members of an aggregate
+	 *
+	 * Each reference is a base of its own, so building one and getting a member out of it doesn't go
+	 * through the recursive constructors and constraints of `std::tuple`, which get very slow to
+	 * compile past a few dozens of members.
+	 * */
+	template <typename Indices, typename ...Members>
+	struct AggregateMembersReferences;
+
+	template <std::size_t ...INDICES, typename ...Members>
+	struct AggregateMembersReferences<std::index_sequence<INDICES...>, Members...> : __internals::AggregateMemberReference<INDICES, Members>... {
+		using Types = std::tuple<Members...>;
+		static constexpr std::size_t COUNT {sizeof...(Members)};
+
+		static constexpr auto make(Members &...members) noexcept -> AggregateMembersReferences {
+			return AggregateMembersReferences{__internals::AggregateMemberReference<INDICES, Members> {members}...};
+		}
+
+		constexpr auto toTuple() const noexcept -> std::tuple<Members&...> {
+			return std::tuple<Members&...> {static_cast<const __internals::AggregateMemberReference<INDICES, Members>&> (*this).reference...};
+		}
+	};
+
+
+	/*
+	 * @brief The member `INDEX` out of `AggregateMembersReferences`
+	 * */
+	template <std::size_t INDEX, typename Member>
+	constexpr auto getAggregateMember(const __internals::AggregateMemberReference<INDEX, Member> &member) noexcept -> Member& {
+		return member.reference;
+	}
+
+
+	namespace __internals {
+		template <typename ...Members>
+		constexpr auto bindAggregateMembers(Members &...members) noexcept {
+			return AggregateMembersReferences<std::index_sequence_for<Members...>, Members...>::make(members...);
+		}
+
+	} // namespace __internals
+
+} // namespace flex::reflection
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <optional>
 #include <ranges>
 #include <string_view>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 #ifdef __cpp_impl_reflection
 	#include <meta>
@@ -47,9 +50,21 @@ namespace flex {
 	} // namespace __internals
 
 
+	/*
+	 * @brief The inclusive range of indices probed to find the enumerators of `T`. Each index is
+	 *        turned into a candidate value by `enum_value_generator<T>`, so for plain enums it's
+	 *        the range of the values, negative ones included
+	 * */
+	template <enumeration T>
+	struct FLEX_REFLECTION_DEPRECATION enum_range {
+		static constexpr std::int64_t min {0};
+		static constexpr std::int64_t max {static_cast<std::int64_t> (enum_max_size_v<T>) - 1};
+	};
+
+
 	template <enumeration T>
 	struct FLEX_REFLECTION_DEPRECATION enum_value_generator {
-		static constexpr auto value {[](std::size_t val) constexpr {return static_cast<T> (val);}};
+		static constexpr auto value {[](std::int64_t val) constexpr {return static_cast<T> (val);}};
 		using value_type = decltype(value);
 	};
 
@@ -74,46 +89,60 @@ namespace flex {
 
 
 	namespace __internals {
-		template <
-			enumeration T,
-			std::size_t INDEX = 0,
-			bool IS_MEMBER = is_enum_member_v<T, enum_value_generator_v<T> (INDEX)>,
-			std::size_t MAX_INDEX = enum_max_size_v<T>
-		>
-		struct enum_members_generator {
-			static constexpr std::tuple value {std::tuple_cat(
-				std::make_tuple(PackedEnumName<T> {enum_value_generator_v<T> (INDEX), *__internals::getEnumName<T, enum_value_generator_v<T> (INDEX)> ()}),
-				enum_members_generator<T, INDEX+1>::value
-			)};
-			using value_type = decltype(value);
-		};
+		/*
+		 * @brief The number of candidates probed by a single pack expansion. Probing in batches keeps
+		 *        the packs small while needing one instantiation per batch instead of per candidate
+		 * */
+		constexpr std::size_t ENUM_PROBE_BATCH_SIZE {64};
 
-		template <enumeration T, std::size_t INDEX, std::size_t MAX_INDEX>
-		struct enum_members_generator<T, INDEX, false, MAX_INDEX> {
-			static constexpr std::tuple value {enum_members_generator<T, INDEX+1>::value};
-			using value_type = decltype(value);
-		};
+		template <enumeration T>
+		constexpr std::size_t enum_candidates_count_v {[]() -> std::size_t {
+			static_assert(enum_range<T>::min <= enum_range<T>::max, "The range of an enum can't be empty");
+			return static_cast<std::size_t> (enum_range<T>::max - enum_range<T>::min) + 1;
+		}()};
 
-		template <enumeration T, std::size_t MAX_INDEX>
-		struct enum_members_generator<T, MAX_INDEX-1, true, MAX_INDEX> {
-			static constexpr std::tuple value {};
-			using value_type = decltype(value);
-		};
+		template <enumeration T>
+		consteval auto getEnumCandidate(std::size_t candidate) noexcept -> T {
+			return enum_value_generator_v<T> (enum_range<T>::min + static_cast<std::int64_t> (candidate));
+		}
+
+		template <enumeration T, std::size_t FIRST, std::size_t ...OFFSETS>
+		consteval auto probeEnumBatch(
+			std::array<std::optional<std::string_view>, enum_candidates_count_v<T>> &names,
+			std::index_sequence<OFFSETS...>
+		) noexcept -> void {
+			((names[FIRST + OFFSETS] = getEnumName<T, getEnumCandidate<T> (FIRST + OFFSETS)> ()), ...);
+		}
 
-		template <enumeration T, std::size_t MAX_INDEX>
-		struct enum_members_generator<T, MAX_INDEX-1, false, MAX_INDEX> {
-			static constexpr std::tuple value {};
-			using value_type = decltype(value);
-		};
-		
 		template <enumeration T>
-		constexpr auto enum_members_generator_v = enum_members_generator<T>::value;
+		consteval auto probeEnumNames() noexcept {
+			constexpr std::size_t CANDIDATES_COUNT {enum_candidates_count_v<T>};
+			std::array<std::optional<std::string_view>, CANDIDATES_COUNT> names {};
+			[&names]<std::size_t ...BATCHES>(std::index_sequence<BATCHES...>) consteval {
+				(probeEnumBatch<T, BATCHES * ENUM_PROBE_BATCH_SIZE> (
+					names,
+					std::make_index_sequence<std::min(ENUM_PROBE_BATCH_SIZE, CANDIDATES_COUNT - BATCHES * ENUM_PROBE_BATCH_SIZE)> {}
+				), ...);
+			}(std::make_index_sequence<(CANDIDATES_COUNT + ENUM_PROBE_BATCH_SIZE - 1) / ENUM_PROBE_BATCH_SIZE> {});
+			return names;
+		}
 
+		template <enumeration T>
+		struct enum_probe {
+			static constexpr auto NAMES {probeEnumNames<T> ()};
+			static constexpr std::size_t COUNT {static_cast<std::size_t> (std::ranges::count_if(NAMES, [](const auto &name) {return !!name;}))};
+		};
 
 		template <enumeration T>
-		constexpr auto enumTupleToArray() {
-			constexpr auto getArray {[](auto &&...values) constexpr {return std::array{std::forward<decltype(values)> (values)...};}};
-			return std::apply(getArray, enum_members_generator_v<T>);
+		consteval auto getProbedEnumMembers() noexcept {
+			using Probe = enum_probe<T>;
+			std::array<PackedEnumName<T>, Probe::COUNT> results {};
+			std::size_t i {0};
+			for (std::size_t candidate {0}; candidate < Probe::NAMES.size(); ++candidate) {
+				if (Probe::NAMES[candidate])
+					results[i++] = PackedEnumName<T> {getEnumCandidate<T> (candidate), *Probe::NAMES[candidate]};
+			}
+			return results;
 		}
 
 	#ifdef __cpp_impl_reflection
@@ -141,7 +170,7 @@ namespace flex {
 	#ifdef __cpp_impl_reflection
 		static constexpr auto value {__internals::getEnumMembers<T> ()};
 	#else
-		static constexpr auto value {__internals::enumTupleToArray<T> ()};
+		static constexpr auto value {__internals::getProbedEnumMembers<T> ()};
 	#endif
 		using value_type = decltype(value);
 	};
@@ -154,20 +183,46 @@ namespace flex {
 	constexpr auto enum_members_count_v = enum_members_v<T>.size();
 
 
+	/*
+	 * @brief The position of `value` in `enum_members_v<T>`, or `enum_members_count_v<T>` if it's
+	 *        not an enumerator. Constant time when the values of the enumerators are dense
+	 * */
+	template <enumeration T>
+	constexpr auto enum_index(T value) noexcept -> std::size_t;
+
+	template <enumeration T, T VALUE>
+		requires (enum_index(VALUE) != enum_members_count_v<T>)
+	constexpr auto enum_index_v = enum_index(VALUE);
+
+
+	/*
+	 * @brief The name of `value`, through `enum_index`
+	 * */
 	template <enumeration T>
 	constexpr auto toString(T value) noexcept -> std::optional<std::string_view>;
 
+	/*
+	 * @brief The enumerator named `name`, found through a perfect hash of the names of `T`
+	 * */
+	template <enumeration T>
+	constexpr auto fromString(std::string_view name) noexcept -> std::optional<T>;
+
 
 } // namespace flex
 
 
 #define FLEX_MAKE_ENUM_BITFLAG(name) template <>\
 	struct flex::enum_value_generator<name> {\
-		static constexpr auto value {[](std::size_t index) constexpr {return (name)((std::underlying_type_t<name>)(1) << index);}};\
+		static constexpr auto value {[](std::int64_t index) constexpr {return (name)((std::underlying_type_t<name>)(1) << index);}};\
 		using value_type = decltype(value);\
 	}
 #define FLEX_SET_MAX_ENUM_SIZE(name, value) template <>\
 	struct flex::enum_max_size<name> : std::integral_constant<std::size_t, value> {}
+#define FLEX_SET_ENUM_RANGE(name, minValue, maxValue) template <>\
+	struct flex::enum_range<name> {\
+		static constexpr std::int64_t min {minValue};\
+		static constexpr std::int64_t max {maxValue};\
+	}
 
 
 #ifdef __cpp_impl_reflection
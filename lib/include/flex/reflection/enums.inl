@@ -2,8 +2,13 @@
 
 #include "flex/reflection/enums.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <source_location>
 
+#include "flex/perfectHash.hpp"
+
 
 namespace flex {
 	namespace __internals {
@@ -60,16 +65,123 @@ namespace flex {
 
 			return name;
 		}
+
+
+		/*
+		 * @brief The distance between two values of `T`, `value` being at least `min`
+		 * */
+		template <enumeration T>
+		constexpr auto getEnumValueDistance(T value, T min) noexcept -> std::uint64_t {
+			using Underlying = std::underlying_type_t<T>;
+			return static_cast<std::uint64_t> (static_cast<Underlying> (value)) - static_cast<std::uint64_t> (static_cast<Underlying> (min));
+		}
+
+		template <enumeration T>
+		struct enum_lookup {
+			static constexpr std::size_t COUNT {enum_members_count_v<T>};
+
+			static constexpr auto NAMES {[]() {
+				std::array<std::string_view, COUNT> names {};
+				for (std::size_t i {0}; i < COUNT; ++i)
+					names[i] = enum_members_v<T>[i].name;
+				return names;
+			}()};
+
+			static constexpr T MIN_VALUE {[]() {
+				T min {};
+				for (std::size_t i {0}; i < COUNT; ++i) {
+					if (i == 0 || enum_members_v<T>[i].value < min)
+						min = enum_members_v<T>[i].value;
+				}
+				return min;
+			}()};
+
+			static constexpr std::uint64_t RANGE_SIZE {[]() -> std::uint64_t {
+				std::uint64_t size {0};
+				for (const auto &member : enum_members_v<T>)
+					size = std::max(size, getEnumValueDistance(member.value, MIN_VALUE) + 1);
+				return size;
+			}()};
+
+			/*
+			 * @brief Whether the values are dense enough to index a table with them
+			 * */
+			static constexpr bool IS_DENSE {RANGE_SIZE <= 2 * COUNT + 8};
+
+			/*
+			 * @brief The index of each value of the range starting at `MIN_VALUE`, `COUNT` for holes
+			 * */
+			static constexpr auto DENSE_INDICES {[]() {
+				std::array<std::size_t, IS_DENSE ? RANGE_SIZE : 0> indices {};
+				if constexpr (IS_DENSE) {
+					indices.fill(COUNT);
+					for (std::size_t i {COUNT}; i-- > 0;)
+						indices[getEnumValueDistance(enum_members_v<T>[i].value, MIN_VALUE)] = i;
+				}
+				return indices;
+			}()};
+
+			/*
+			 * @brief The indices sorted by value, for a binary search when the values are sparse
+			 * */
+			static constexpr auto SORTED_INDICES {[]() {
+				std::array<std::size_t, IS_DENSE ? 0 : COUNT> indices {};
+				if constexpr (!IS_DENSE) {
+					for (std::size_t i {0}; i < COUNT; ++i)
+						indices[i] = i;
+					std::ranges::sort(indices, [](std::size_t lhs, std::size_t rhs) {
+						const T lhsValue {enum_members_v<T>[lhs].value};
+						const T rhsValue {enum_members_v<T>[rhs].value};
+						return lhsValue < rhsValue || (lhsValue == rhsValue && lhs < rhs);
+					});
+				}
+				return indices;
+			}()};
+		};
+
+	} // namespace __internals
+
+
+	template <enumeration T>
+	constexpr auto enum_index(T value) noexcept -> std::size_t {
+		using Lookup = __internals::enum_lookup<T>;
+		if constexpr (Lookup::COUNT == 0)
+			return Lookup::COUNT;
+		else if constexpr (Lookup::IS_DENSE) {
+			if (value < Lookup::MIN_VALUE)
+				return Lookup::COUNT;
+			const std::uint64_t distance {__internals::getEnumValueDistance(value, Lookup::MIN_VALUE)};
+			if (distance >= Lookup::DENSE_INDICES.size())
+				return Lookup::COUNT;
+			return Lookup::DENSE_INDICES[distance];
+		}
+		else {
+			const auto index {std::ranges::lower_bound(Lookup::SORTED_INDICES, value, {},
+				[](std::size_t index) {return enum_members_v<T>[index].value;}
+			)};
+			if (index == Lookup::SORTED_INDICES.end() || enum_members_v<T>[*index].value != value)
+				return Lookup::COUNT;
+			return *index;
+		}
 	}
 
 
 	template <enumeration T>
 	constexpr auto toString(T value) noexcept -> std::optional<std::string_view> {
-		for (const auto &member : enum_members_v<T>) {
-			if (member.value == value)
-				return member.name;
-		}
-		return std::nullopt;
+		const std::size_t index {enum_index(value)};
+		if (index == enum_members_count_v<T>)
+			return std::nullopt;
+		return enum_members_v<T>[index].name;
+	}
+
+
+	template <enumeration T>
+	constexpr auto fromString(std::string_view name) noexcept -> std::optional<T> {
+		using Hash = __internals::PerfectHash<__internals::enum_lookup<T>::NAMES>;
+		const std::size_t index {Hash::find(name)};
+		if (index == Hash::COUNT)
+			return std::nullopt;
+		return enum_members_v<T>[index].value;
 	}
 
 } // namespace flex
@@ -0,0 +1,330 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "flex/reflection/reflection.hpp"
+
+
+namespace flex {
+	namespace __internals {
+		/*
+		 * @brief Whether two `T` are equal exactly when their bytes are. Views are excluded, their bytes
+		 *        are the address of what they look at
+		 * */
+		template <typename T>
+		constexpr auto is_trivially_comparable_v = std::is_trivially_copyable_v<T>
+			&& std::has_unique_object_representations_v<T>
+			&& !std::ranges::view<T>;
+
+		template <typename T>
+		concept trivially_comparable_range = std::ranges::contiguous_range<const T>
+			&& std::ranges::sized_range<const T>
+			&& is_trivially_comparable_v<std::ranges::range_value_t<const T>>;
+
+
+		template <typename Members>
+		struct members_layout;
+
+		template <typename ...Members>
+		struct members_layout<std::tuple<Members...>> {
+			static constexpr bool HAS_REFERENCE {(std::is_reference_v<Members> || ...)};
+			static constexpr std::array<std::size_t, sizeof...(Members)> SIZES {sizeof(std::remove_cvref_t<Members>)...};
+			static constexpr std::array<std::size_t, sizeof...(Members)> ALIGNMENTS {alignof(std::remove_cvref_t<Members>)...};
+			static constexpr std::array<bool, sizeof...(Members)> ARE_TRIVIALLY_COMPARABLE {is_trivially_comparable_v<std::remove_cvref_t<Members>>...};
+		};
+
+
+		/*
+		 * @brief The offsets of the members of a standard layout aggregate, guessed from their sizes and
+		 *        alignments, or nothing if the layout can't be deduced that way. `alignas` and
+		 *        `[[no_unique_address]]` members are not seen, so these offsets are only a guess
+		 * */
+		template <flex::autogen_reflection T>
+		consteval auto guessAggregateMembersOffsets() noexcept -> std::optional<std::array<std::size_t, flex::reflection_members_count_v<T>>> {
+			using Layout = members_layout<flex::reflection_members_t<T>>;
+			constexpr std::size_t COUNT {flex::reflection_members_count_v<T>};
+			if (!std::is_standard_layout_v<T> || COUNT == 0 || Layout::HAS_REFERENCE)
+				return std::nullopt;
+
+			std::array<std::size_t, COUNT> offsets {};
+			std::size_t end {0};
+			for (std::size_t i {0}; i < COUNT; ++i) {
+				offsets[i] = (end + Layout::ALIGNMENTS[i] - 1) / Layout::ALIGNMENTS[i] * Layout::ALIGNMENTS[i];
+				end = offsets[i] + Layout::SIZES[i];
+			}
+			if ((end + alignof(T) - 1) / alignof(T) * alignof(T) != sizeof(T))
+				return std::nullopt;
+			return offsets;
+		}
+
+
+		/*
+		 * @brief Members `[first, last)` of a reflectable type : either a single member, or a block of
+		 *        `size` bytes made of trivially comparable members that should have no gap between them
+		 *
+		 * The blocks come from the offsets guessed by `guessAggregateMembersOffsets`, which `alignas` or
+		 * `[[no_unique_address]]` members get wrong, so they must go through `isContiguousBlock` first.
+		 * */
+		struct MembersSegment {
+			std::size_t first;
+			std::size_t last;
+			std::size_t size;
+			bool isBlock;
+		};
+
+		template <flex::reflectable T>
+		consteval auto getMembersSegments() noexcept {
+			using Layout = members_layout<flex::reflection_members_t<T>>;
+			constexpr std::size_t COUNT {flex::reflection_members_count_v<T>};
+			std::optional<std::array<std::size_t, COUNT>> offsets {};
+			if constexpr (flex::autogen_reflection<T>)
+				offsets = guessAggregateMembersOffsets<T> ();
+
+			std::array<MembersSegment, COUNT> segments {};
+			std::size_t count {0};
+			for (std::size_t i {0}; i < COUNT; ++i) {
+				const bool isBlock {offsets.has_value() && Layout::ARE_TRIVIALLY_COMPARABLE[i]};
+				if (isBlock && count != 0 && segments[count - 1].isBlock
+					&& (*offsets)[segments[count - 1].first] + segments[count - 1].size == (*offsets)[i]
+				) {
+					segments[count - 1].last = i + 1;
+					segments[count - 1].size += Layout::SIZES[i];
+				}
+				else
+					segments[count++] = MembersSegment{i, i + 1, Layout::SIZES[i], isBlock};
+			}
+			return std::pair{segments, count};
+		}
+
+		/*
+		 * @brief The members of `T` split in segments, so the blocks can be hashed or compared at once
+		 * */
+		template <flex::reflectable T>
+		struct members_segments {
+			static constexpr auto SEGMENTS {getMembersSegments<T> ().first};
+			static constexpr std::size_t COUNT {getMembersSegments<T> ().second};
+		};
+
+
+		template <std::size_t INDEX, flex::reflectable T>
+		using reflection_member_value_t = std::remove_cvref_t<std::tuple_element_t<INDEX, flex::reflection_members_t<T>>>;
+
+		/*
+		 * @brief A const reference to the member `INDEX` of `value`, or a copy of it for the getter /
+		 *        setter members
+		 * */
+		template <std::size_t INDEX, flex::reflectable T>
+		constexpr auto getMemberValue(const T &value) noexcept -> decltype(auto) {
+			using Member = reflection_member_value_t<INDEX, T>;
+			using Access = decltype(flex::reflection_traits<T>::template getMember<INDEX> (value));
+			if constexpr (std::is_lvalue_reference_v<Access>)
+				return static_cast<const Member&> (flex::reflection_traits<T>::template getMember<INDEX> (value));
+			else
+				return static_cast<Member> (flex::reflection_traits<T>::template getMember<INDEX> (value));
+		}
+
+
+		/*
+		 * @brief Whether the members of the block `SEGMENT` of `value` really follow each other without
+		 *        any padding. The addresses are known to the compiler, so this folds to a constant
+		 * */
+		template <MembersSegment SEGMENT, flex::reflectable T>
+		constexpr auto isContiguousBlock(const T &value) noexcept -> bool {
+			using Layout = members_layout<flex::reflection_members_t<T>>;
+			const auto *first {reinterpret_cast<const std::byte*> (std::addressof(getMemberValue<SEGMENT.first> (value)))};
+			std::size_t offset {0};
+			return [&]<std::size_t ...OFFSETS>(std::index_sequence<OFFSETS...>) {
+				return ((
+					reinterpret_cast<const std::byte*> (std::addressof(getMemberValue<SEGMENT.first + OFFSETS> (value))) == first + offset
+					&& (offset += Layout::SIZES[SEGMENT.first + OFFSETS], true)
+				) && ...);
+			}(std::make_index_sequence<SEGMENT.last - SEGMENT.first> {});
+		}
+
+
+		/*
+		 * @brief Calls `function.template operator()<SEGMENT> ()` for each segment of `T`, in order,
+		 *        until one returns `false`
+		 * */
+		template <flex::reflectable T, typename Function>
+		constexpr auto forEachMembersSegment(Function &&function) -> bool {
+			return [&]<std::size_t ...SEGMENTS>(std::index_sequence<SEGMENTS...>) {
+				return (function.template operator()<members_segments<T>::SEGMENTS[SEGMENTS]> () && ...);
+			}(std::make_index_sequence<members_segments<T>::COUNT> {});
+		}
+
+
+		/*
+		 * @brief Whether the offsets of the members of `T` can be measured by `bit_cast`ing bytes into
+		 *        it : a non empty, trivially copyable and standard layout aggregate made, down to its
+		 *        scalars, of integers, floating points and scoped enums. Bytes that are all 0 or 1 are
+		 *        a valid value for each of them, and their first byte is never padding
+		 * */
+		template <typename T>
+		consteval auto isOffsetMeasurable() noexcept -> bool {
+			if constexpr (std::is_volatile_v<T> || std::is_reference_v<T> || std::is_same_v<std::remove_cv_t<T>, long double>)
+				return false;
+			else if constexpr (std::is_integral_v<T> || std::is_floating_point_v<T> || std::is_scoped_enum_v<T>)
+				return true;
+			else if constexpr (!std::is_class_v<T> || !std::is_standard_layout_v<T> || !std::is_trivially_copyable_v<T> || std::is_empty_v<T>)
+				return false;
+			else if constexpr (!flex::autogen_reflection<T>)
+				return false;
+			else {
+				return []<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					return (isOffsetMeasurable<std::tuple_element_t<INDICES, flex::reflection_members_t<T>>> () && ...);
+				}(std::make_index_sequence<flex::reflection_members_count_v<T>> {});
+			}
+		}
+
+		/*
+		 * @brief The offsets of the members of `T`, read from the object : bit `n` of the offset of a
+		 *        member is its first byte once `T` is made of bytes holding bit `n` of their own offset
+		 * */
+		template <flex::autogen_reflection T>
+		requires (isOffsetMeasurable<T> ())
+		consteval auto measureAggregateMembersOffsets() noexcept -> std::array<std::size_t, flex::reflection_members_count_v<T>> {
+			std::array<std::size_t, flex::reflection_members_count_v<T>> offsets {};
+			for (std::size_t bit {0}; (std::size_t{1} << bit) < sizeof(T); ++bit) {
+				std::array<unsigned char, sizeof(T)> bytes {};
+				for (std::size_t i {0}; i < sizeof(T); ++i)
+					bytes[i] = static_cast<unsigned char> ((i >> bit) & 1);
+				const T object {std::bit_cast<T> (bytes)};
+
+				[&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					((offsets[INDICES] |= static_cast<std::size_t> (std::bit_cast<std::array<unsigned char, sizeof(reflection_member_value_t<INDICES, T>)>> (
+						flex::reflection_traits<T>::template getMember<INDICES> (object)
+					)[0]) << bit), ...);
+				}(std::make_index_sequence<flex::reflection_members_count_v<T>> {});
+			}
+			return offsets;
+		}
+
+
+		/*
+		 * @brief The smallest size of `T` with its members reordered, and that order, found by laying
+		 *        out the members by decreasing alignment. When the measured layout of `T` isn't the one
+		 *        its members' alignments give, some of them are over-aligned or overlap and the order
+		 *        of declaration is kept
+		 * */
+		template <flex::autogen_reflection T>
+		consteval auto getPackedMembersOrder() noexcept {
+			using Layout = members_layout<flex::reflection_members_t<T>>;
+			constexpr std::size_t COUNT {flex::reflection_members_count_v<T>};
+			std::array<std::size_t, COUNT> order {};
+			for (std::size_t i {0}; i < COUNT; ++i)
+				order[i] = i;
+			if (guessAggregateMembersOffsets<T> () != measureAggregateMembersOffsets<T> ())
+				return std::pair{order, sizeof(T)};
+
+			std::ranges::sort(order, [](std::size_t lhs, std::size_t rhs) {
+				if (Layout::ALIGNMENTS[lhs] != Layout::ALIGNMENTS[rhs])
+					return Layout::ALIGNMENTS[lhs] > Layout::ALIGNMENTS[rhs];
+				return lhs < rhs;
+			});
+
+			std::size_t end {0};
+			for (const std::size_t index : order)
+				end = (end + Layout::ALIGNMENTS[index] - 1) / Layout::ALIGNMENTS[index] * Layout::ALIGNMENTS[index] + Layout::SIZES[index];
+			return std::pair{order, (end + alignof(T) - 1) / alignof(T) * alignof(T)};
+		}
+
+	} // namespace __internals
+
+
+	/*
+	 * @brief The types whose offsets of members can be measured at compile time, see
+	 *        `__internals::isOffsetMeasurable`
+	 * */
+	template <typename T>
+	concept layout_reflectable = flex::autogen_reflection<T> && __internals::isOffsetMeasurable<T> ();
+
+
+	/*
+	 * @brief The offset in bytes of each member of `T`, in declaration order
+	 *
+	 * The addresses of the members of `fakeObject` can't be subtracted in a constant expression, so
+	 * the offsets are measured by `bit_cast`ing bytes into `T` and reading back the first byte of each
+	 * member. They are exact, `alignas` and `[[no_unique_address]]` members included.
+	 * */
+	template <layout_reflectable T>
+	constexpr auto reflection_member_offsets_v = __internals::measureAggregateMembersOffsets<T> ();
+
+
+	struct ReflectionMemberLayout {
+		std::string_view name;
+		std::size_t offset;
+		std::size_t size;
+		std::size_t alignment;
+		/*
+		 * @brief The padding bytes between this member and the next one, or the end of the object
+		 * */
+		std::size_t padding;
+	};
+
+	template <std::size_t COUNT>
+	struct ReflectionLayout {
+		std::array<ReflectionMemberLayout, COUNT> members;
+		std::size_t size;
+		std::size_t alignment;
+		/*
+		 * @brief The total of the padding bytes, the ones at the end of the object included
+		 * */
+		std::size_t paddingBytes;
+		/*
+		 * @brief The declaration order of the members that minimizes the padding, and the size of `T`
+		 *        declared that way. Types with over-aligned or overlapping members keep their order
+		 * */
+		std::array<std::size_t, COUNT> suggestedOrder;
+		std::size_t suggestedSize;
+	};
+
+
+	namespace __internals {
+		template <layout_reflectable T>
+		consteval auto makeReflectionLayout() noexcept {
+			using Layout = members_layout<flex::reflection_members_t<T>>;
+			constexpr std::size_t COUNT {flex::reflection_members_count_v<T>};
+			constexpr auto OFFSETS {reflection_member_offsets_v<T>};
+			constexpr auto NAMES {std::apply([](const auto &...names) {
+				return std::array<std::string_view, COUNT> {std::string_view{names}...};
+			}, flex::reflection_members_names_v<T>)};
+
+			ReflectionLayout<COUNT> layout {};
+			layout.size = sizeof(T);
+			layout.alignment = alignof(T);
+			for (std::size_t i {0}; i < COUNT; ++i) {
+				const std::size_t next {i + 1 == COUNT ? sizeof(T) : OFFSETS[i + 1]};
+				layout.members[i] = ReflectionMemberLayout{NAMES[i], OFFSETS[i], Layout::SIZES[i], Layout::ALIGNMENTS[i], next - OFFSETS[i] - Layout::SIZES[i]};
+				layout.paddingBytes += layout.members[i].padding;
+			}
+			std::tie(layout.suggestedOrder, layout.suggestedSize) = getPackedMembersOrder<T> ();
+			return layout;
+		}
+
+	} // namespace __internals
+
+
+	/*
+	 * @brief The layout report of `T` : offset, size, alignment and trailing padding of each member,
+	 *        the wasted bytes, and the order of the members that would waste the least
+	 *
+	 * `static_assert(flex::is_reflection_layout_optimal_v<T>)` keeps a type dense over time.
+	 * */
+	template <layout_reflectable T>
+	constexpr auto reflection_layout_v = __internals::makeReflectionLayout<T> ();
+
+	template <layout_reflectable T>
+	constexpr auto is_reflection_layout_optimal_v = reflection_layout_v<T>.size == reflection_layout_v<T>.suggestedSize;
+
+} // namespace flex
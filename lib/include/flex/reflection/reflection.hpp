@@ -1,8 +1,11 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <string_view>
 #include <tuple>
 
+#include "flex/fixedString.hpp"
 #include "flex/reflection/aggregate.hpp"
 #include "flex/reflection/aggregateMembersCount.hpp"
 #include "flex/reflection/metadata.hpp"
@@ -27,19 +30,19 @@ namespace flex {
 		using type = std::remove_cvref_t<T>;
 		static constexpr bool IS_REFLECTABLE {true};
 		static constexpr std::size_t MEMBERS_COUNT {flex::reflection::aggregate_members_count_v<type>};
-		static constexpr std::tuple MEMBERS_NAMES {flex::reflection::aggregate_members_names_v<type>};
+		static constexpr std::array<std::string_view, MEMBERS_COUNT> MEMBERS_NAMES {flex::reflection::aggregate_members_names_v<type>};
 		using MembersTypes = flex::reflection::aggregate_members_t<type>;
 
 		template <std::size_t N>
 		static constexpr auto getMember(std::add_lvalue_reference_t<type> instance) noexcept
 			-> std::add_lvalue_reference_t<std::tuple_element_t<N, MembersTypes>> {
-			return std::get<N> (flex::reflection::makeAggregateMembersTuple(instance));
+			return flex::reflection::getAggregateMember<N> (flex::reflection::makeAggregateMembersReferences(instance));
 		}
 
 		template <std::size_t N>
 		static constexpr auto getMember(std::add_lvalue_reference_t<std::add_const_t<type>> instance) noexcept
 			-> std::add_lvalue_reference_t<std::add_const_t<std::tuple_element_t<N, MembersTypes>>> {
-			return std::get<N> (flex::reflection::makeAggregateMembersTuple(instance));
+			return flex::reflection::getAggregateMember<N> (flex::reflection::makeAggregateMembersReferences(instance));
 		}
 	};
 
@@ -48,7 +51,9 @@ namespace flex {
 		using type = std::remove_cvref_t<T>;
 		static constexpr bool IS_REFLECTABLE {true};
 		static constexpr std::size_t MEMBERS_COUNT {std::tuple_size_v<decltype(T::FlexMetadata::MEMBERS)>};
-		static constexpr std::tuple MEMBERS_NAMES {flex::reflection::custom_members_names_v<type>};
+		static constexpr std::array<std::string_view, MEMBERS_COUNT> MEMBERS_NAMES {std::apply([](auto ...names) {
+			return std::array<std::string_view, sizeof...(names)> {names...};
+		}, flex::reflection::custom_members_names_v<type>)};
 		using MembersTypes = flex::reflection::custom_members_t<type>;
 
 		template <std::size_t N>
@@ -86,4 +91,21 @@ namespace flex {
 	template <reflectable T>
 	using reflection_members_t = typename reflection_traits<T>::MembersTypes;
 
+
+	/*
+	 * @brief The index of the member of `T` named `name`, or its members count if there is none
+	 * */
+	template <reflectable T>
+	consteval auto getReflectionMemberIndex(std::string_view name) noexcept -> std::size_t {
+		return std::apply([name](const auto &...names) {
+			std::size_t index {0};
+			((std::string_view{names} == name ? false : (++index, true)) && ...);
+			return index;
+		}, reflection_members_names_v<T>);
+	}
+
+	template <reflectable T, flex::FixedString NAME>
+	requires (getReflectionMemberIndex<T> (NAME.view()) < reflection_members_count_v<T>)
+	constexpr auto reflection_member_index_v = getReflectionMemberIndex<T> (NAME.view());
+
 } // namespace flex
@@ -0,0 +1,470 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "flex/reflection/enums.hpp"
+#include "flex/reflection/reflection.hpp"
+#include "flex/typeTraits.hpp"
+
+
+/*
+ * Binary serialization
+ *
+ * The encoding has no tags nor names : both ends must agree on `T`.
+ *
+ *   bool                        : u8, 0 or 1
+ *   arithmetic / enum           : little-endian, `sizeof(T)` bytes
+ *   std::optional               : u8 presence, then the value if present
+ *   std::pair / std::tuple      : the elements in order
+ *   std::array / C array        : the elements in order
+ *   other ranges                : LEB128 varint count, then the elements
+ *   reflectable                 : the members in order
+ *
+ * Types whose bytes already are their encoding (arithmetic, enums, padding-free aggregates and
+ * arrays of them, on a little-endian host) are copied with a single `memcpy`, and so are the
+ * contiguous containers of such types.
+ * */
+namespace flex {
+	enum class DeserializeError {
+		eTruncated,
+		eInvalidValue,
+		eTrailingBytes
+	};
+
+
+	namespace serialization {
+		template <typename T>
+		concept buffer = requires(T buffer, std::size_t size) {
+			{buffer.size()} -> std::convertible_to<std::size_t>;
+			buffer.resize(size);
+			{buffer.data()} -> std::convertible_to<const void*>;
+		} && sizeof(std::ranges::range_value_t<T>) == 1;
+
+
+		template <buffer Buffer>
+		class Writer final {
+			public:
+				Writer(Buffer &buffer) noexcept : m_buffer {buffer} {}
+
+				auto writeBytes(const void *data, std::size_t size) -> void {
+					if (size == 0)
+						return;
+					const std::size_t offset {static_cast<std::size_t> (m_buffer.size())};
+					m_buffer.resize(offset + size);
+					std::memcpy(static_cast<void*> (m_buffer.data() + offset), data, size);
+				}
+
+				auto writeVarint(std::uint64_t value) -> void {
+					std::array<std::uint8_t, 10> bytes {};
+					std::size_t size {0};
+					while (value >= 0x80) {
+						bytes[size++] = static_cast<std::uint8_t> ((value & 0x7f) | 0x80);
+						value >>= 7;
+					}
+					bytes[size++] = static_cast<std::uint8_t> (value);
+					this->writeBytes(bytes.data(), size);
+				}
+
+			private:
+				Buffer &m_buffer;
+		};
+
+
+		class Reader final {
+			public:
+				Reader(std::span<const std::byte> data) noexcept : m_data {data}, m_error {} {}
+
+				auto readBytes(void *output, std::size_t size) noexcept -> bool {
+					if (size > m_data.size())
+						return this->fail(DeserializeError::eTruncated);
+					if (size != 0)
+						std::memcpy(output, m_data.data(), size);
+					m_data = m_data.subspan(size);
+					return true;
+				}
+
+				auto readVarint(std::uint64_t &value) noexcept -> bool {
+					value = 0;
+					for (std::size_t shift {0}; shift < 64; shift += 7) {
+						if (m_data.empty())
+							return this->fail(DeserializeError::eTruncated);
+						const auto byte {static_cast<std::uint8_t> (m_data.front())};
+						m_data = m_data.subspan(1);
+						value |= static_cast<std::uint64_t> (byte & 0x7f) << shift;
+						if ((byte & 0x80) == 0)
+							return true;
+					}
+					return this->fail(DeserializeError::eInvalidValue);
+				}
+
+				/*
+				 * @brief Read the count of a range, rejecting counts that can't fit in the remaining bytes
+				 *        before anything gets allocated
+				 * */
+				auto readSize(std::size_t &size, std::size_t minElementSize) noexcept -> bool {
+					std::uint64_t value {};
+					if (!this->readVarint(value))
+						return false;
+					if (minElementSize != 0 && value > m_data.size() / minElementSize)
+						return this->fail(DeserializeError::eTruncated);
+					size = static_cast<std::size_t> (value);
+					return true;
+				}
+
+				auto fail(DeserializeError error) noexcept -> bool {
+					if (!m_error)
+						m_error = error;
+					return false;
+				}
+
+				[[nodiscard]]
+				auto getRemainingSize() const noexcept -> std::size_t {return m_data.size();}
+				[[nodiscard]]
+				auto getError() const noexcept -> std::optional<DeserializeError> {return m_error;}
+
+			private:
+				std::span<const std::byte> m_data;
+				std::optional<DeserializeError> m_error;
+		};
+
+	} // namespace serialization
+
+
+	/*
+	 * @brief Customization point for the types the default encoding doesn't fit
+	 *
+	 * A specialization sets `IS_CUSTOM` and provides
+	 *   `template <serialization::buffer Buffer> static auto serialize(serialization::Writer<Buffer>&, const T&) -> void`
+	 *   `static auto deserialize(serialization::Reader&, T&) -> bool`
+	 * */
+	template <typename T>
+	struct serialization_traits {
+		static constexpr bool IS_CUSTOM {false};
+	};
+
+	template <typename T>
+	concept custom_serialization = serialization_traits<T>::IS_CUSTOM;
+
+
+	namespace __internals {
+		template <typename T>
+		concept tuple_like = flex::tuple<T> || flex::pair<T>;
+
+		template <typename T>
+		concept resizable_contiguous_range = std::ranges::contiguous_range<T>
+			&& std::ranges::sized_range<T>
+			&& requires(T range, std::size_t size) {range.resize(size);};
+
+		template <typename T>
+		concept back_insertable_range = std::ranges::sized_range<T>
+			&& requires(T range, std::ranges::range_value_t<T> value) {range.emplace_back(std::move(value));};
+
+		template <typename T>
+		concept map_like_range = std::ranges::sized_range<T>
+			&& requires(T range, typename T::key_type key, typename T::mapped_type value) {range.emplace(std::move(key), std::move(value));};
+
+		template <typename T>
+		concept set_like_range = std::ranges::sized_range<T>
+			&& !map_like_range<T>
+			&& requires(T range, typename T::key_type key) {range.emplace(std::move(key));};
+
+
+		/*
+		 * @brief The type an element of `T` is read into, without the `const` key of maps
+		 * */
+		template <typename T>
+		struct deserialized_element : flex::type_constant<std::ranges::range_value_t<T>> {};
+
+		template <map_like_range T>
+		struct deserialized_element<T> : flex::type_constant<std::pair<typename T::key_type, typename T::mapped_type>> {};
+
+
+		template <typename T, typename = void>
+		struct is_bulk_serializable : std::false_type {};
+
+		/*
+		 * @brief Whether the bytes of `T` in memory are exactly its encoding
+		 * */
+		template <typename T>
+		constexpr auto is_bulk_serializable_v = std::endian::native == std::endian::little
+			&& !custom_serialization<T>
+			&& is_bulk_serializable<std::remove_cv_t<T>>::value;
+
+		template <typename T>
+		requires (flex::arithmetic<T> && !std::same_as<T, bool>) || flex::enumeration<T>
+		struct is_bulk_serializable<T> : std::true_type {};
+
+		template <typename T, std::size_t N>
+		struct is_bulk_serializable<T[N]> : std::bool_constant<is_bulk_serializable_v<T>> {};
+
+		template <typename T, std::size_t N>
+		struct is_bulk_serializable<std::array<T, N>> : std::bool_constant<is_bulk_serializable_v<T> && sizeof(std::array<T, N>) == sizeof(T) * N> {};
+
+		template <typename T, typename Members = flex::reflection_members_t<T>>
+		constexpr auto isPaddingFreeAggregate() noexcept -> bool {
+			return []<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+				return (is_bulk_serializable_v<std::tuple_element_t<INDICES, Members>> && ...)
+					&& (sizeof(std::tuple_element_t<INDICES, Members>) + ... + 0) == sizeof(T);
+			}(std::make_index_sequence<std::tuple_size_v<Members>> {});
+		}
+
+		template <typename T>
+		requires flex::autogen_reflection<T>
+			&& (!flex::fixed_array<T>)
+			&& std::is_trivially_copyable_v<T>
+			&& (flex::reflection_members_count_v<T> != 0)
+		struct is_bulk_serializable<T> : std::bool_constant<isPaddingFreeAggregate<T> ()> {};
+
+
+		/*
+		 * @brief The contiguous containers read with a single `memcpy` once resized
+		 * */
+		template <typename T>
+		concept bulk_resizable_range = resizable_contiguous_range<T> && is_bulk_serializable_v<std::ranges::range_value_t<T>>;
+
+
+		/*
+		 * @brief The least amount of bytes an encoded `T` takes, used to reject absurd counts early.
+		 *        0 for the custom encodings, which may take none
+		 * */
+		template <typename T>
+		constexpr auto getMinEncodedSize() noexcept -> std::size_t {
+			if constexpr (custom_serialization<T>)
+				return 0;
+			else if constexpr (is_bulk_serializable_v<T> || flex::arithmetic<T> || flex::enumeration<T>)
+				return std::same_as<T, bool> ? 1 : sizeof(T);
+			else if constexpr (flex::optional<T>)
+				return 1;
+			else if constexpr (tuple_like<T>) {
+				return []<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					return (getMinEncodedSize<std::remove_cv_t<std::tuple_element_t<INDICES, T>>> () + ... + 0);
+				}(std::make_index_sequence<std::tuple_size_v<T>> {});
+			}
+			else if constexpr (flex::is_std_array_v<T>)
+				return std::tuple_size_v<T> * getMinEncodedSize<typename T::value_type> ();
+			else if constexpr (std::is_bounded_array_v<T>)
+				return std::extent_v<T> * getMinEncodedSize<std::remove_extent_t<T>> ();
+			else if constexpr (std::ranges::sized_range<T>)
+				return 1;
+			else if constexpr (flex::reflectable<T>) {
+				return []<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					return (getMinEncodedSize<std::remove_cvref_t<std::tuple_element_t<INDICES, flex::reflection_members_t<T>>>> () + ... + 0);
+				}(std::make_index_sequence<flex::reflection_members_count_v<T>> {});
+			}
+			else
+				return 0;
+		}
+
+		/*
+		 * @brief The most bytes of elements reserved up front while reading a range : the count is
+		 *        bounded by the remaining input, but an element may take much more memory than bytes
+		 * */
+		constexpr std::size_t MAX_RESERVED_SIZE {64 * 1024};
+
+
+		template <serialization::buffer Buffer, typename T>
+		auto serializeValue(serialization::Writer<Buffer> &writer, const T &value) -> void;
+
+		template <typename T>
+		auto deserializeValue(serialization::Reader &reader, T &value) -> bool;
+
+
+		template <serialization::buffer Buffer, flex::reflectable T>
+		auto serializeMembers(serialization::Writer<Buffer> &writer, const T &value) -> void {
+			[&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+				(serializeValue(writer, static_cast<const std::tuple_element_t<INDICES, flex::reflection_members_t<T>>&> (
+					flex::reflection_traits<T>::template getMember<INDICES> (value)
+				)), ...);
+			}(std::make_index_sequence<flex::reflection_members_count_v<T>> {});
+		}
+
+		template <std::size_t INDEX, flex::reflectable T>
+		auto deserializeMember(serialization::Reader &reader, T &value) -> bool {
+			using Member = std::remove_cvref_t<std::tuple_element_t<INDEX, flex::reflection_members_t<T>>>;
+			using Access = decltype(flex::reflection_traits<T>::template getMember<INDEX> (value));
+			if constexpr (std::is_lvalue_reference_v<Access>)
+				return deserializeValue(reader, flex::reflection_traits<T>::template getMember<INDEX> (value));
+			else {
+				// getter / setter pair : read into a temporary and hand it to the setter
+				Member member {};
+				if (!deserializeValue(reader, member))
+					return false;
+				flex::reflection_traits<T>::template getMember<INDEX> (value) = std::move(member);
+				return true;
+			}
+		}
+
+		template <flex::reflectable T>
+		auto deserializeMembers(serialization::Reader &reader, T &value) -> bool {
+			return [&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+				return (deserializeMember<INDICES> (reader, value) && ...);
+			}(std::make_index_sequence<flex::reflection_members_count_v<T>> {});
+		}
+
+
+		template <serialization::buffer Buffer, typename T>
+		auto serializeValue(serialization::Writer<Buffer> &writer, const T &value) -> void {
+			if constexpr (custom_serialization<T>)
+				serialization_traits<T>::serialize(writer, value);
+			else if constexpr (is_bulk_serializable_v<T>)
+				writer.writeBytes(&value, sizeof(T));
+			else if constexpr (std::same_as<T, bool>) {
+				const std::uint8_t byte {value ? std::uint8_t{1} : std::uint8_t{0}};
+				writer.writeBytes(&byte, 1);
+			}
+			else if constexpr (flex::arithmetic<T> || flex::enumeration<T>) {
+				// big-endian host
+				auto bytes {std::bit_cast<std::array<std::byte, sizeof(T)>> (value)};
+				std::ranges::reverse(bytes);
+				writer.writeBytes(bytes.data(), bytes.size());
+			}
+			else if constexpr (flex::optional<T>) {
+				serializeValue(writer, value.has_value());
+				if (value)
+					serializeValue(writer, *value);
+			}
+			else if constexpr (tuple_like<T>)
+				std::apply([&writer](const auto &...elements) {(serializeValue(writer, elements), ...);}, value);
+			else if constexpr (flex::fixed_array<T>) {
+				for (const auto &element : value)
+					serializeValue(writer, element);
+			}
+			else if constexpr (std::ranges::sized_range<const T>) {
+				using Element = std::ranges::range_value_t<T>;
+				writer.writeVarint(static_cast<std::uint64_t> (std::ranges::size(value)));
+				if constexpr (std::ranges::contiguous_range<const T> && is_bulk_serializable_v<Element>)
+					writer.writeBytes(std::ranges::data(value), std::ranges::size(value) * sizeof(Element));
+				else {
+					for (const auto &element : value)
+						serializeValue(writer, element);
+				}
+			}
+			else if constexpr (flex::reflectable<T>)
+				serializeMembers(writer, value);
+			else
+				static_assert(flex::false_v<T>, "T can't be serialized, specialize flex::serialization_traits<T>");
+		}
+
+
+		template <typename T>
+		auto deserializeValue(serialization::Reader &reader, T &value) -> bool {
+			if constexpr (custom_serialization<T>)
+				return serialization_traits<T>::deserialize(reader, value);
+			else if constexpr (is_bulk_serializable_v<T>)
+				return reader.readBytes(&value, sizeof(T));
+			else if constexpr (std::same_as<T, bool>) {
+				std::uint8_t byte {};
+				if (!reader.readBytes(&byte, 1))
+					return false;
+				if (byte > 1)
+					return reader.fail(DeserializeError::eInvalidValue);
+				value = byte == 1;
+				return true;
+			}
+			else if constexpr (flex::arithmetic<T> || flex::enumeration<T>) {
+				std::array<std::byte, sizeof(T)> bytes {};
+				if (!reader.readBytes(bytes.data(), bytes.size()))
+					return false;
+				std::ranges::reverse(bytes);
+				value = std::bit_cast<T> (bytes);
+				return true;
+			}
+			else if constexpr (flex::optional<T>) {
+				bool hasValue {};
+				if (!deserializeValue(reader, hasValue))
+					return false;
+				if (!hasValue) {
+					value.reset();
+					return true;
+				}
+				return deserializeValue(reader, value.emplace());
+			}
+			else if constexpr (tuple_like<T>)
+				return std::apply([&reader](auto &...elements) {return (deserializeValue(reader, elements) && ...);}, value);
+			else if constexpr (flex::fixed_array<T>) {
+				for (auto &element : value) {
+					if (!deserializeValue(reader, element))
+						return false;
+				}
+				return true;
+			}
+			else if constexpr (bulk_resizable_range<T>) {
+				using Element = std::ranges::range_value_t<T>;
+				std::size_t size {};
+				if (!reader.readSize(size, getMinEncodedSize<Element> ()))
+					return false;
+				value.resize(size);
+				return reader.readBytes(std::ranges::data(value), size * sizeof(Element));
+			}
+			else if constexpr (back_insertable_range<T> || map_like_range<T> || set_like_range<T>) {
+				// the elements are appended as they are read, so a count the input can't back only costs
+				// what was actually read
+				using Element = typename deserialized_element<T>::type;
+				std::size_t size {};
+				if (!reader.readSize(size, getMinEncodedSize<Element> ()))
+					return false;
+				value.clear();
+				if constexpr (requires {value.reserve(size);})
+					value.reserve(std::min(size, MAX_RESERVED_SIZE / sizeof(Element) + 1));
+				for (std::size_t i {0}; i < size; ++i) {
+					Element element {};
+					if (!deserializeValue(reader, element))
+						return false;
+					if constexpr (map_like_range<T>)
+						value.emplace(std::move(element.first), std::move(element.second));
+					else if constexpr (set_like_range<T>)
+						value.emplace(std::move(element));
+					else
+						value.emplace_back(std::move(element));
+				}
+				return true;
+			}
+			else if constexpr (flex::reflectable<T>)
+				return deserializeMembers(reader, value);
+			else {
+				static_assert(flex::false_v<T>, "T can't be deserialized, specialize flex::serialization_traits<T>");
+				return false;
+			}
+		}
+
+	} // namespace __internals
+
+
+	/*
+	 * @brief Append the encoding of `value` to `buffer`
+	 * @param buffer A resizable container of bytes, like `std::vector<std::byte>` or `std::string`
+	 * */
+	template <typename T, serialization::buffer Buffer>
+	auto serialize(const T &value, Buffer &buffer) -> void {
+		serialization::Writer<Buffer> writer {buffer};
+		__internals::serializeValue(writer, value);
+	}
+
+	/*
+	 * @brief Decode a `T` that spans the whole of `data`
+	 * */
+	template <std::default_initializable T>
+	auto deserialize(std::span<const std::byte> data) -> std::expected<T, DeserializeError> {
+		serialization::Reader reader {data};
+		T value {};
+		if (!__internals::deserializeValue(reader, value))
+			return std::unexpected(reader.getError().value_or(DeserializeError::eInvalidValue));
+		if (reader.getRemainingSize() != 0)
+			return std::unexpected(DeserializeError::eTrailingBytes);
+		return value;
+	}
+
+} // namespace flex
@@ -0,0 +1,470 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "flex/config.hpp"
+#include "flex/fixedString.hpp"
+#include "flex/reflection/reflection.hpp"
+
+
+namespace flex {
+	template <flex::autogen_reflection T>
+	class SoAVector;
+
+
+	/*
+	 * @brief A reference to an element of a `SoAVector<T>`, spread over its columns
+	 *
+	 * It converts to `T`, assigning a `T` to it writes every member, and `get<N>()` /
+	 * `get<"name">()` or a structured binding reach the members in place. Like the references of
+	 * `std::views::zip`, copying it copies the reference, while assigning to it writes the values.
+	 * */
+	template <flex::autogen_reflection T, bool CONST>
+	class SoAReference final {
+		public:
+			using Container = flex::if_add_const_t<CONST, SoAVector<T>>;
+			static constexpr std::size_t MEMBERS_COUNT {flex::reflection_members_count_v<T>};
+
+			template <std::size_t N>
+			using Member = flex::if_add_const_t<CONST, std::tuple_element_t<N, flex::reflection_members_t<T>>>;
+
+			SoAReference(const SoAReference&) noexcept = default;
+			~SoAReference() = default;
+
+			template <std::size_t N>
+			requires (N < MEMBERS_COUNT)
+			auto get() const noexcept -> Member<N>& {
+				return std::get<N> (m_container->m_columns)[m_index];
+			}
+
+			template <flex::FixedString NAME>
+			auto get() const noexcept -> Member<flex::reflection_member_index_v<T, NAME>>& {
+				return this->get<flex::reflection_member_index_v<T, NAME>> ();
+			}
+
+			operator T() const {
+				return [this]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					return T{this->get<INDICES> ()...};
+				}(std::make_index_sequence<MEMBERS_COUNT> {});
+			}
+
+			auto operator=(const T &value) const -> const SoAReference& requires (!CONST) {
+				[&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					((this->get<INDICES> () = flex::reflection_traits<T>::template getMember<INDICES> (value)), ...);
+				}(std::make_index_sequence<MEMBERS_COUNT> {});
+				return *this;
+			}
+
+			auto operator=(T &&value) const -> const SoAReference& requires (!CONST) {
+				[&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					((this->get<INDICES> () = std::move(flex::reflection_traits<T>::template getMember<INDICES> (value))), ...);
+				}(std::make_index_sequence<MEMBERS_COUNT> {});
+				return *this;
+			}
+
+			auto operator=(const SoAReference &other) const -> const SoAReference& requires (!CONST) {
+				[&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					((this->get<INDICES> () = other.template get<INDICES> ()), ...);
+				}(std::make_index_sequence<MEMBERS_COUNT> {});
+				return *this;
+			}
+
+			friend auto swap(const SoAReference &lhs, const SoAReference &rhs) -> void requires (!CONST) {
+				[&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					using std::swap;
+					(swap(lhs.template get<INDICES> (), rhs.template get<INDICES> ()), ...);
+				}(std::make_index_sequence<MEMBERS_COUNT> {});
+			}
+
+		private:
+			friend class SoAVector<T>;
+			template <flex::autogen_reflection, bool>
+			friend class SoAIterator;
+
+			SoAReference(Container *container, std::size_t index) noexcept : m_container {container}, m_index {index} {}
+
+			Container *m_container;
+			std::size_t m_index;
+	};
+
+
+	template <flex::autogen_reflection T, bool CONST>
+	class SoAIterator final {
+		public:
+			using iterator_concept = std::random_access_iterator_tag;
+			using iterator_category = std::input_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using reference = SoAReference<T, CONST>;
+			using Container = typename reference::Container;
+
+			SoAIterator() noexcept : m_container {nullptr}, m_index {0} {}
+			SoAIterator(Container *container, std::size_t index) noexcept : m_container {container}, m_index {index} {}
+
+			operator SoAIterator<T, true>() const noexcept requires (!CONST) {
+				return SoAIterator<T, true> {m_container, m_index};
+			}
+
+			auto operator*() const noexcept -> reference {return reference{m_container, m_index};}
+			auto operator[](difference_type offset) const noexcept -> reference {return *(*this + offset);}
+
+			auto operator++() noexcept -> SoAIterator& {++m_index; return *this;}
+			auto operator++(int) noexcept -> SoAIterator {auto copy {*this}; ++m_index; return copy;}
+			auto operator--() noexcept -> SoAIterator& {--m_index; return *this;}
+			auto operator--(int) noexcept -> SoAIterator {auto copy {*this}; --m_index; return copy;}
+
+			auto operator+=(difference_type offset) noexcept -> SoAIterator& {
+				m_index = static_cast<std::size_t> (static_cast<difference_type> (m_index) + offset);
+				return *this;
+			}
+			auto operator-=(difference_type offset) noexcept -> SoAIterator& {return *this += -offset;}
+
+			friend auto operator+(SoAIterator it, difference_type offset) noexcept -> SoAIterator {return it += offset;}
+			friend auto operator+(difference_type offset, SoAIterator it) noexcept -> SoAIterator {return it += offset;}
+			friend auto operator-(SoAIterator it, difference_type offset) noexcept -> SoAIterator {return it -= offset;}
+			friend auto operator-(const SoAIterator &lhs, const SoAIterator &rhs) noexcept -> difference_type {
+				return static_cast<difference_type> (lhs.m_index) - static_cast<difference_type> (rhs.m_index);
+			}
+
+			friend auto operator==(const SoAIterator &lhs, const SoAIterator &rhs) noexcept -> bool {return lhs.m_index == rhs.m_index;}
+			friend auto operator<=>(const SoAIterator &lhs, const SoAIterator &rhs) noexcept -> std::strong_ordering {return lhs.m_index <=> rhs.m_index;}
+
+			friend auto iter_move(const SoAIterator &it) -> T {
+				return [&it]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					return T{std::move((*it).template get<INDICES> ())...};
+				}(std::make_index_sequence<reference::MEMBERS_COUNT> {});
+			}
+
+			friend auto iter_swap(const SoAIterator &lhs, const SoAIterator &rhs) -> void requires (!CONST) {
+				swap(*lhs, *rhs);
+			}
+
+		private:
+			Container *m_container;
+			std::size_t m_index;
+	};
+
+
+	/*
+	 * @brief A vector of `T` storing each member in its own contiguous array
+	 *
+	 * Loops touching a few members of large structs only load the columns they use, and
+	 * `column<N>()` / `column<"name">()` hand out those arrays as spans. Elements are accessed
+	 * through `SoAReference` proxies.
+	 * */
+	template <flex::autogen_reflection T>
+	class SoAVector final {
+		public:
+			static constexpr std::size_t MEMBERS_COUNT {flex::reflection_members_count_v<T>};
+
+			template <std::size_t N>
+			using Member = std::tuple_element_t<N, flex::reflection_members_t<T>>;
+
+			using value_type = T;
+			using size_type = std::size_t;
+			using difference_type = std::ptrdiff_t;
+			using reference = SoAReference<T, false>;
+			using const_reference = SoAReference<T, true>;
+			using iterator = SoAIterator<T, false>;
+			using const_iterator = SoAIterator<T, true>;
+
+			SoAVector() noexcept : m_columns {}, m_size {0}, m_capacity {0} {}
+
+			SoAVector(const SoAVector &other) : SoAVector() {
+				this->reserve(other.m_size);
+				[&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					std::size_t copiedCount {0};
+					FLEX_TRY {
+						((std::uninitialized_copy_n(std::get<INDICES> (other.m_columns), other.m_size, std::get<INDICES> (m_columns)), ++copiedCount), ...);
+					}
+					FLEX_CATCH(...) {
+						((INDICES < copiedCount ? (void)std::destroy_n(std::get<INDICES> (m_columns), other.m_size) : void()), ...);
+						FLEX_THROW();
+					}
+				}(std::make_index_sequence<MEMBERS_COUNT> {});
+				m_size = other.m_size;
+			}
+
+			SoAVector(SoAVector &&other) noexcept :
+				m_columns {std::exchange(other.m_columns, {})},
+				m_size {std::exchange(other.m_size, 0)},
+				m_capacity {std::exchange(other.m_capacity, 0)}
+			{}
+
+			~SoAVector() {
+				this->clear();
+				this->deallocate(m_columns, m_capacity);
+			}
+
+			auto operator=(SoAVector other) noexcept -> SoAVector& {
+				this->swap(other);
+				return *this;
+			}
+
+			auto swap(SoAVector &other) noexcept -> void {
+				std::swap(m_columns, other.m_columns);
+				std::swap(m_size, other.m_size);
+				std::swap(m_capacity, other.m_capacity);
+			}
+
+
+			auto size() const noexcept -> std::size_t {return m_size;}
+			auto capacity() const noexcept -> std::size_t {return m_capacity;}
+			auto empty() const noexcept -> bool {return m_size == 0;}
+
+			auto reserve(std::size_t capacity) -> void {
+				if (capacity <= m_capacity)
+					return;
+				this->relocateTo(this->allocate(capacity), capacity, 0);
+			}
+
+			auto clear() noexcept -> void {
+				this->destroyRange(0, m_size);
+				m_size = 0;
+			}
+
+			auto push_back(const T &value) -> void {
+				this->emplaceFrom([&value]<std::size_t N>() -> decltype(auto) {
+					return flex::reflection_traits<T>::template getMember<N> (value);
+				});
+			}
+
+			auto push_back(T &&value) -> void {
+				this->emplaceFrom([&value]<std::size_t N>() -> decltype(auto) {
+					return std::move(flex::reflection_traits<T>::template getMember<N> (value));
+				});
+			}
+
+			/*
+			 * @brief Append an element built from one value per member
+			 * */
+			template <typename ...Args>
+			requires (sizeof...(Args) == MEMBERS_COUNT)
+			auto emplace_back(Args &&...args) -> reference {
+				auto arguments {std::forward_as_tuple(std::forward<Args> (args)...)};
+				this->emplaceFrom([&arguments]<std::size_t N>() -> decltype(auto) {
+					return std::get<N> (std::move(arguments));
+				});
+				return this->back();
+			}
+
+			auto pop_back() noexcept -> void {
+				this->destroyRange(m_size - 1, m_size);
+				--m_size;
+			}
+
+			/*
+			 * @brief Shrink to `size` elements, or grow with value-initialized ones
+			 * */
+			auto resize(std::size_t size) -> void {
+				if (size <= m_size) {
+					this->destroyRange(size, m_size);
+					m_size = size;
+					return;
+				}
+				this->reserve(size);
+				while (m_size < size)
+					this->emplaceFrom([]<std::size_t N>() {return Member<N> {};});
+			}
+
+
+			auto operator[](std::size_t index) noexcept -> reference {return reference{this, index};}
+			auto operator[](std::size_t index) const noexcept -> const_reference {return const_reference{this, index};}
+			auto front() noexcept -> reference {return (*this)[0];}
+			auto front() const noexcept -> const_reference {return (*this)[0];}
+			auto back() noexcept -> reference {return (*this)[m_size - 1];}
+			auto back() const noexcept -> const_reference {return (*this)[m_size - 1];}
+
+			auto begin() noexcept -> iterator {return iterator{this, 0};}
+			auto end() noexcept -> iterator {return iterator{this, m_size};}
+			auto begin() const noexcept -> const_iterator {return const_iterator{this, 0};}
+			auto end() const noexcept -> const_iterator {return const_iterator{this, m_size};}
+			auto cbegin() const noexcept -> const_iterator {return this->begin();}
+			auto cend() const noexcept -> const_iterator {return this->end();}
+
+
+			template <std::size_t N>
+			requires (N < MEMBERS_COUNT)
+			auto column() noexcept -> std::span<Member<N>> {
+				return std::span<Member<N>> {std::get<N> (m_columns), m_size};
+			}
+
+			template <std::size_t N>
+			requires (N < MEMBERS_COUNT)
+			auto column() const noexcept -> std::span<const Member<N>> {
+				return std::span<const Member<N>> {std::get<N> (m_columns), m_size};
+			}
+
+			template <flex::FixedString NAME>
+			auto column() noexcept {
+				return this->column<flex::reflection_member_index_v<T, NAME>> ();
+			}
+
+			template <flex::FixedString NAME>
+			auto column() const noexcept {
+				return this->column<flex::reflection_member_index_v<T, NAME>> ();
+			}
+
+
+		private:
+			template <flex::autogen_reflection, bool>
+			friend class SoAReference;
+
+			using Columns = decltype([]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+				return std::tuple<Member<INDICES>*...> {};
+			}(std::make_index_sequence<MEMBERS_COUNT> {}));
+
+			auto allocate(std::size_t capacity) -> Columns {
+				Columns columns {};
+				[&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					FLEX_TRY {
+						((std::get<INDICES> (columns) = std::allocator<Member<INDICES>> {}.allocate(capacity)), ...);
+					}
+					FLEX_CATCH(...) {
+						this->deallocate(columns, capacity);
+						FLEX_THROW();
+					}
+				}(std::make_index_sequence<MEMBERS_COUNT> {});
+				return columns;
+			}
+
+			auto deallocate(Columns &columns, std::size_t capacity) noexcept -> void {
+				[&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					((std::get<INDICES> (columns) != nullptr
+						? std::allocator<Member<INDICES>> {}.deallocate(std::get<INDICES> (columns), capacity)
+						: void()
+					), ...);
+				}(std::make_index_sequence<MEMBERS_COUNT> {});
+				columns = {};
+			}
+
+			auto destroyRange(std::size_t first, std::size_t last) noexcept -> void {
+				[&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					(std::destroy(std::get<INDICES> (m_columns) + first, std::get<INDICES> (m_columns) + last), ...);
+				}(std::make_index_sequence<MEMBERS_COUNT> {});
+			}
+
+			template <std::size_t N>
+			auto relocateColumn(Member<N> *destination) -> void {
+				Member<N> *source {std::get<N> (m_columns)};
+				if constexpr (std::is_nothrow_move_constructible_v<Member<N>> || !std::is_copy_constructible_v<Member<N>>)
+					std::uninitialized_move_n(source, m_size, destination);
+				else
+					std::uninitialized_copy_n(source, m_size, destination);
+			}
+
+			/*
+			 * @brief Move the elements into `columns` of `capacity` elements, which already hold
+			 *        `appendedCount` elements built past them, and make them the storage
+			 *
+			 * The columns that may throw are relocated first, and the nothrow moves only once they all
+			 * succeeded, so that a failure leaves the original columns untouched and frees `columns`.
+			 * */
+			auto relocateTo(Columns columns, std::size_t capacity, std::size_t appendedCount) -> void {
+				[&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					std::array<bool, MEMBERS_COUNT> relocated {};
+					FLEX_TRY {
+						([&]() {
+							if constexpr (!std::is_nothrow_move_constructible_v<Member<INDICES>>) {
+								this->relocateColumn<INDICES> (std::get<INDICES> (columns));
+								relocated[INDICES] = true;
+							}
+						}(), ...);
+					}
+					FLEX_CATCH(...) {
+						((relocated[INDICES] ? (void)std::destroy_n(std::get<INDICES> (columns), m_size) : void()), ...);
+						(std::destroy_n(std::get<INDICES> (columns) + m_size, appendedCount), ...);
+						this->deallocate(columns, capacity);
+						FLEX_THROW();
+					}
+					([&]() {
+						if constexpr (std::is_nothrow_move_constructible_v<Member<INDICES>>)
+							this->relocateColumn<INDICES> (std::get<INDICES> (columns));
+					}(), ...);
+				}(std::make_index_sequence<MEMBERS_COUNT> {});
+
+				this->destroyRange(0, m_size);
+				this->deallocate(m_columns, m_capacity);
+				m_columns = columns;
+				m_capacity = capacity;
+			}
+
+			/*
+			 * @brief Construct the element `index` of `columns`, member `N` from `getArgument.template operator()<N>()`
+			 * */
+			template <typename GetArgument>
+			static auto constructAt(Columns &columns, std::size_t index, GetArgument &getArgument) -> void {
+				[&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					std::size_t constructedCount {0};
+					FLEX_TRY {
+						((std::construct_at(
+							std::get<INDICES> (columns) + index,
+							getArgument.template operator()<INDICES> ()
+						), ++constructedCount), ...);
+					}
+					FLEX_CATCH(...) {
+						((INDICES < constructedCount ? std::destroy_at(std::get<INDICES> (columns) + index) : void()), ...);
+						FLEX_THROW();
+					}
+				}(std::make_index_sequence<MEMBERS_COUNT> {});
+			}
+
+			/*
+			 * @brief Construct the element at the end, member `N` from `getArgument.template operator()<N>()`
+			 *
+			 * The arguments may refer to elements of the vector, so when it is full the new element is
+			 * built in the new columns before the current ones are moved out of the old.
+			 * */
+			template <typename GetArgument>
+			auto emplaceFrom(GetArgument &&getArgument) -> void {
+				if (m_size != m_capacity)
+					constructAt(m_columns, m_size, getArgument);
+				else {
+					const std::size_t capacity {std::max<std::size_t> (m_capacity * 2, 8)};
+					Columns columns {this->allocate(capacity)};
+					FLEX_TRY {
+						constructAt(columns, m_size, getArgument);
+					}
+					FLEX_CATCH(...) {
+						this->deallocate(columns, capacity);
+						FLEX_THROW();
+					}
+					this->relocateTo(columns, capacity, 1);
+				}
+				++m_size;
+			}
+
+			Columns m_columns;
+			std::size_t m_size;
+			std::size_t m_capacity;
+	};
+
+} // namespace flex
+
+
+template <flex::autogen_reflection T, bool CONST, template <typename> typename TQual, template <typename> typename UQual>
+struct std::basic_common_reference<flex::SoAReference<T, CONST>, T, TQual, UQual> {
+	using type = T;
+};
+
+template <flex::autogen_reflection T, bool CONST, template <typename> typename TQual, template <typename> typename UQual>
+struct std::basic_common_reference<T, flex::SoAReference<T, CONST>, TQual, UQual> {
+	using type = T;
+};
+
+template <flex::autogen_reflection T, bool CONST>
+struct std::tuple_size<flex::SoAReference<T, CONST>> : std::integral_constant<std::size_t, flex::reflection_members_count_v<T>> {};
+
+template <std::size_t N, flex::autogen_reflection T, bool CONST>
+struct std::tuple_element<N, flex::SoAReference<T, CONST>> {
+	using type = typename flex::SoAReference<T, CONST>::template Member<N>&;
+};
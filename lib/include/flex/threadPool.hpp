@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "flex/config.hpp"
+
+
+namespace flex {
+	/*
+	 * @brief A fixed set of threads running one parallel job at a time
+	 *
+	 * `run(function)` calls `function(threadIndex)` once on every worker and once on the calling
+	 * thread, which is index 0, then waits for all of them. Splitting and balancing the work is up
+	 * to `function`. A `run` issued from a worker of the pool is executed inline by that worker
+	 * alone, so nested parallel jobs can't deadlock.
+	 *
+	 * An exception thrown by `function` on any thread is rethrown by `run` once every thread is
+	 * done with `function`. When several threads throw, the first one caught wins.
+	 * */
+	class ThreadPool final {
+		public:
+			ThreadPool(std::size_t threadsCount = std::max(std::thread::hardware_concurrency(), 1u)) :
+				m_workers {},
+				m_mutex {},
+				m_jobCondition {},
+				m_doneCondition {},
+				m_runMutex {},
+				m_job {nullptr},
+				m_jobFunction {nullptr},
+				m_exception {},
+				m_generation {0},
+				m_pendingCount {0},
+				m_stop {false}
+			{
+				m_workers.reserve(threadsCount - 1);
+				for (std::size_t i {1}; i < threadsCount; ++i)
+					m_workers.emplace_back([this, i]() {this->work(i);});
+			}
+
+			~ThreadPool() {
+				{
+					std::lock_guard lock {m_mutex};
+					m_stop = true;
+				}
+				m_jobCondition.notify_all();
+				for (auto &worker : m_workers)
+					worker.join();
+			}
+
+			ThreadPool(const ThreadPool&) = delete;
+			auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+			ThreadPool(ThreadPool&&) = delete;
+			auto operator=(ThreadPool&&) -> ThreadPool& = delete;
+
+			/*
+			 * @brief A pool with one thread per hardware thread, created on first use
+			 * */
+			static auto getDefault() -> ThreadPool& {
+				static ThreadPool pool {};
+				return pool;
+			}
+
+			/*
+			 * @brief The number of threads taking part in a `run`, the calling one included
+			 * */
+			auto getThreadsCount() const noexcept -> std::size_t {return m_workers.size() + 1;}
+
+			/*
+			 * @brief Whether the calling thread is a worker of any pool
+			 * */
+			static auto isWorkerThread() noexcept -> bool {return s_isWorkerThread;}
+
+			template <typename Function>
+			requires std::is_invocable_v<Function&, std::size_t>
+			auto run(Function &&function) -> void {
+				if (s_isWorkerThread || m_workers.empty()) {
+					function(0uz);
+					return;
+				}
+
+				std::lock_guard runLock {m_runMutex};
+				{
+					std::lock_guard lock {m_mutex};
+					m_job = std::addressof(function);
+					m_jobFunction = [](void *job, std::size_t threadIndex) {
+						(*static_cast<std::remove_reference_t<Function>*> (job))(threadIndex);
+					};
+					m_pendingCount = m_workers.size();
+					++m_generation;
+				}
+				m_jobCondition.notify_all();
+
+				{
+					const WorkerThreadScope scope {};
+					FLEX_TRY {
+						function(0uz);
+					}
+					FLEX_CATCH(...) {
+						this->saveException();
+					}
+				}
+
+				std::exception_ptr exception {};
+				{
+					std::unique_lock lock {m_mutex};
+					m_doneCondition.wait(lock, [this]() {return m_pendingCount == 0;});
+					m_job = nullptr;
+					exception = std::exchange(m_exception, nullptr);
+				}
+				if (exception)
+					std::rethrow_exception(exception);
+			}
+
+
+		private:
+			/*
+			 * @brief Marks the calling thread as a worker for its lifetime
+			 * */
+			class WorkerThreadScope final {
+				public:
+					WorkerThreadScope() noexcept : m_wasWorkerThread {s_isWorkerThread} {s_isWorkerThread = true;}
+					~WorkerThreadScope() {s_isWorkerThread = m_wasWorkerThread;}
+
+					WorkerThreadScope(const WorkerThreadScope&) = delete;
+					auto operator=(const WorkerThreadScope&) -> WorkerThreadScope& = delete;
+
+				private:
+					bool m_wasWorkerThread;
+			};
+
+			auto saveException() noexcept -> void {
+				std::lock_guard lock {m_mutex};
+				if (!m_exception)
+					m_exception = std::current_exception();
+			}
+
+			auto work(std::size_t threadIndex) -> void {
+				const WorkerThreadScope scope {};
+				std::uint64_t lastGeneration {0};
+				while (true) {
+					void *job {nullptr};
+					void (*jobFunction) (void*, std::size_t) {nullptr};
+					{
+						std::unique_lock lock {m_mutex};
+						m_jobCondition.wait(lock, [&]() {return m_stop || m_generation != lastGeneration;});
+						if (m_stop)
+							return;
+						lastGeneration = m_generation;
+						job = m_job;
+						jobFunction = m_jobFunction;
+					}
+
+					FLEX_TRY {
+						jobFunction(job, threadIndex);
+					}
+					FLEX_CATCH(...) {
+						this->saveException();
+					}
+
+					bool isLast {false};
+					{
+						std::lock_guard lock {m_mutex};
+						isLast = --m_pendingCount == 0;
+					}
+					if (isLast)
+						m_doneCondition.notify_one();
+				}
+			}
+
+			static inline thread_local bool s_isWorkerThread {false};
+
+			std::vector<std::thread> m_workers;
+			std::mutex m_mutex;
+			std::condition_variable m_jobCondition;
+			std::condition_variable m_doneCondition;
+			std::mutex m_runMutex;
+			void *m_job;
+			void (*m_jobFunction) (void*, std::size_t);
+			std::exception_ptr m_exception;
+			std::uint64_t m_generation;
+			std::size_t m_pendingCount;
+			bool m_stop;
+	};
+
+} // namespace flex
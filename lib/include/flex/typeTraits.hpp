@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <limits>
 #include <optional>
 #include <string>
@@ -141,6 +143,22 @@ namespace flex{
 	concept pair = is_pair_v<T>;
 
 
+	template <typename T>
+	struct is_std_array : std::false_type {};
+
+	template <typename T, std::size_t N>
+	struct is_std_array<std::array<T, N>> : std::true_type {};
+
+	template <typename T>
+	constexpr auto is_std_array_v = is_std_array<T>::value;
+
+	template <typename T>
+	concept std_array = is_std_array_v<T>;
+
+	template <typename T>
+	concept fixed_array = std_array<T> || std::is_bounded_array_v<T>;
+
+
 	template <typename T>
 	struct remove_member_function_pointer_const_noexcept {
 		using type = T;
@@ -0,0 +1,450 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "flex/fixedString.hpp"
+#include "flex/reflection/reflection.hpp"
+#include "flex/serialization.hpp"
+#include "flex/typeTraits.hpp"
+
+
+/*
+ * View message format
+ *
+ * A message is a table. All integers are little-endian and every table starts on a multiple of 8
+ * bytes from the start of the message :
+ *
+ *   u32 size                     : bytes of the table, header included
+ *   u16 fieldsCount              : the amount of members the writer's `T` had
+ *   u16 reserved                 : 0
+ *   u8[(fieldsCount + 7) / 8]    : presence bitmap, bit `i % 8` of byte `i / 8` for member `i`
+ *   padding to 4 bytes
+ *   u32[fieldsCount]             : offset of each member from the start of the table
+ *   data
+ *
+ * Members are identified by their index, so a message stays readable when members are appended to
+ * `T` : older messages report the new members as absent, and older readers ignore them. Members
+ * must not be removed nor reordered.
+ *
+ *   bool / arithmetic / enum     : `sizeof(T)` bytes, aligned on `alignof(T)`
+ *   strings                      : u32 size, the characters
+ *   contiguous ranges of `U`     : u32 count, padding to `alignof(U)` from the start of the message,
+ *                                  the elements, for the `U` `flex::serialize` copies in bulk and
+ *                                  aligned on at most 8 bytes
+ *   reflectable                  : a nested table
+ *   std::optional                : the value when present, and the presence bit is clear otherwise
+ * */
+namespace flex {
+	enum class ViewError {
+		eMisaligned,
+		eTruncated,
+		eInvalidOffset,
+		eInvalidValue
+	};
+
+	template <flex::reflectable T>
+	class View;
+
+
+	namespace __internals {
+		constexpr std::size_t VIEW_TABLE_ALIGNMENT {8};
+		constexpr std::size_t VIEW_HEADER_SIZE {8};
+
+		template <typename T>
+		concept view_scalar = std::same_as<T, bool> || flex::arithmetic<T> || flex::enumeration<T>;
+
+		template <typename T>
+		concept view_span = !flex::is_string_v<T>
+			&& std::ranges::contiguous_range<const T>
+			&& std::ranges::sized_range<const T>
+			&& is_bulk_serializable_v<std::ranges::range_value_t<T>>
+			&& alignof(std::ranges::range_value_t<T>) <= VIEW_TABLE_ALIGNMENT;
+
+		template <typename T>
+		concept view_field = view_scalar<T> || flex::is_string_v<T> || view_span<T> || flex::reflectable<T>;
+
+
+		/*
+		 * @brief What `View::get` returns for a member of type `T`
+		 * */
+		template <typename T>
+		struct view_field_result : flex::type_constant<T> {};
+
+		template <flex::string T>
+		struct view_field_result<T> : flex::type_constant<std::string_view> {};
+
+		template <view_span T>
+		struct view_field_result<T> : flex::type_constant<std::span<const std::ranges::range_value_t<T>>> {};
+
+		template <flex::reflectable T>
+		requires (!view_span<T> && !view_scalar<T> && !flex::string<T>)
+		struct view_field_result<T> : flex::type_constant<View<T>> {};
+
+		template <flex::optional T>
+		struct view_field_result<T> : flex::type_constant<std::optional<typename view_field_result<typename T::value_type>::type>> {};
+
+		template <typename T>
+		using view_field_result_t = typename view_field_result<T>::type;
+
+
+		template <std::unsigned_integral T>
+		auto loadLittleEndian(const std::byte *data) noexcept -> T {
+			T value {};
+			std::memcpy(&value, data, sizeof(T));
+			if constexpr (std::endian::native == std::endian::big)
+				value = std::byteswap(value);
+			return value;
+		}
+
+		template <std::unsigned_integral T>
+		auto storeLittleEndian(std::byte *data, T value) noexcept -> void {
+			if constexpr (std::endian::native == std::endian::big)
+				value = std::byteswap(value);
+			std::memcpy(data, &value, sizeof(T));
+		}
+
+		constexpr auto getViewOffsetsPosition(std::size_t fieldsCount) noexcept -> std::size_t {
+			return (VIEW_HEADER_SIZE + (fieldsCount + 7) / 8 + 3) & ~std::size_t{3};
+		}
+
+		/*
+		 * @brief The offset from the count of a span to its elements. Messages start on a multiple of
+		 *        8 bytes, so the encoder's position in its buffer and the reader's address agree on
+		 *        `countPosition % 8`, which is all this depends on
+		 * */
+		constexpr auto getViewElementsOffset(std::size_t countPosition, std::size_t alignment) noexcept -> std::size_t {
+			const std::size_t end {countPosition + sizeof(std::uint32_t)};
+			return (end + alignment - 1) / alignment * alignment - countPosition;
+		}
+
+
+		template <serialization::buffer Buffer>
+		class ViewEncoder final {
+			public:
+				ViewEncoder(Buffer &buffer) noexcept : m_buffer {buffer} {}
+
+				template <flex::reflectable T>
+				auto encodeTable(const T &value) -> void {
+					constexpr std::size_t COUNT {flex::reflection_members_count_v<T>};
+					static_assert(COUNT <= UINT16_MAX, "Too many members for a view message");
+
+					this->align(VIEW_TABLE_ALIGNMENT);
+					const std::size_t start {this->getSize()};
+					const std::size_t offsetsPosition {start + getViewOffsetsPosition(COUNT)};
+					this->grow(offsetsPosition - start + COUNT * sizeof(std::uint32_t));
+					storeLittleEndian(this->at(start + 4), static_cast<std::uint16_t> (COUNT));
+
+					[&]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+						(this->encodeMember<INDICES> (value, start, offsetsPosition), ...);
+					}(std::make_index_sequence<COUNT> {});
+
+					storeLittleEndian(this->at(start), static_cast<std::uint32_t> (this->getSize() - start));
+				}
+
+			private:
+				template <std::size_t INDEX, flex::reflectable T>
+				auto encodeMember(const T &value, std::size_t start, std::size_t offsetsPosition) -> void {
+					using Member = std::remove_cvref_t<std::tuple_element_t<INDEX, flex::reflection_members_t<T>>>;
+					const Member &member {flex::reflection_traits<T>::template getMember<INDEX> (value)};
+
+					std::size_t position {};
+					if constexpr (flex::optional<Member>) {
+						if (!member)
+							return;
+						position = this->encodeField(*member);
+					}
+					else
+						position = this->encodeField(member);
+
+					const std::size_t offset {position - start};
+					storeLittleEndian(this->at(offsetsPosition + INDEX * sizeof(std::uint32_t)), static_cast<std::uint32_t> (offset));
+					*this->at(start + VIEW_HEADER_SIZE + INDEX / 8) |= static_cast<std::byte> (1 << (INDEX % 8));
+				}
+
+				/*
+				 * @brief Append `value` and return its position
+				 * */
+				template <typename T>
+				auto encodeField(const T &value) -> std::size_t {
+					static_assert(view_field<T>, "This member type can't be part of a view message");
+
+					if constexpr (view_scalar<T>) {
+						this->align(alignof(T));
+						const std::size_t position {this->getSize()};
+						if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1)
+							this->append(&value, sizeof(T));
+						else {
+							auto bytes {std::bit_cast<std::array<std::byte, sizeof(T)>> (value)};
+							std::ranges::reverse(bytes);
+							this->append(bytes.data(), bytes.size());
+						}
+						return position;
+					}
+					else if constexpr (flex::is_string_v<T>) {
+						const std::string_view string {value};
+						this->align(alignof(std::uint32_t));
+						const std::size_t position {this->getSize()};
+						this->appendSize(string.size());
+						this->append(string.data(), string.size());
+						return position;
+					}
+					else if constexpr (view_span<T>) {
+						using Element = std::ranges::range_value_t<T>;
+						this->align(alignof(std::uint32_t));
+						const std::size_t position {this->getSize()};
+						this->appendSize(std::ranges::size(value));
+						this->grow(getViewElementsOffset(position, alignof(Element)) - sizeof(std::uint32_t));
+						this->append(std::ranges::data(value), std::ranges::size(value) * sizeof(Element));
+						return position;
+					}
+					else {
+						this->align(VIEW_TABLE_ALIGNMENT);
+						const std::size_t position {this->getSize()};
+						this->encodeTable(value);
+						return position;
+					}
+				}
+
+				auto getSize() const noexcept -> std::size_t {return static_cast<std::size_t> (m_buffer.size());}
+				auto at(std::size_t position) noexcept -> std::byte* {return reinterpret_cast<std::byte*> (m_buffer.data()) + position;}
+
+				auto grow(std::size_t size) -> void {
+					m_buffer.resize(m_buffer.size() + size);
+				}
+
+				auto align(std::size_t alignment) -> void {
+					if (const std::size_t remainder {this->getSize() % alignment}; remainder != 0)
+						this->grow(alignment - remainder);
+				}
+
+				auto append(const void *data, std::size_t size) -> void {
+					const std::size_t position {this->getSize()};
+					this->grow(size);
+					if (size != 0)
+						std::memcpy(this->at(position), data, size);
+				}
+
+				auto appendSize(std::size_t size) -> void {
+					std::array<std::byte, sizeof(std::uint32_t)> bytes {};
+					storeLittleEndian(bytes.data(), static_cast<std::uint32_t> (size));
+					this->append(bytes.data(), bytes.size());
+				}
+
+				Buffer &m_buffer;
+		};
+
+	} // namespace __internals
+
+
+	/*
+	 * @brief Read the members of a `T` straight from a message written by `View<T>::encode`
+	 *
+	 * Strings and contiguous ranges are returned as views into the message, nested reflectables as
+	 * nested views, and the rest by value. Absent members, either optional ones without a value or
+	 * ones appended to `T` after the message was written, read as empty or zero.
+	 *
+	 * `make` checks the whole message once, so accessors are unchecked and the data must outlive
+	 * the view.
+	 * */
+	template <flex::reflectable T>
+	class View final {
+		public:
+			static constexpr std::size_t MEMBERS_COUNT {flex::reflection_members_count_v<T>};
+
+			template <std::size_t N>
+			using Member = std::remove_cvref_t<std::tuple_element_t<N, flex::reflection_members_t<T>>>;
+
+			/*
+			 * @brief A view on which every member is absent
+			 * */
+			View() noexcept : m_data {}, m_fieldsCount {0} {}
+
+			/*
+			 * @brief Append the message of `value` to `buffer`, padding it first so that it starts on
+			 *        a multiple of 8 bytes
+			 * */
+			template <serialization::buffer Buffer>
+			static auto encode(const T &value, Buffer &buffer) -> void {
+				__internals::ViewEncoder<Buffer> {buffer}.encodeTable(value);
+			}
+
+			/*
+			 * @brief Check the message in `data` and overlay a view on it
+			 * @param data A message, aligned on 8 bytes
+			 * */
+			static auto make(std::span<const std::byte> data) noexcept -> std::expected<View, ViewError> {
+				if (reinterpret_cast<std::uintptr_t> (data.data()) % __internals::VIEW_TABLE_ALIGNMENT != 0)
+					return std::unexpected(ViewError::eMisaligned);
+				if (const auto error {View::validate(data)}; error)
+					return std::unexpected(*error);
+				return View{data.first(__internals::loadLittleEndian<std::uint32_t> (data.data()))};
+			}
+
+			/*
+			 * @brief Whether the message holds member `N`
+			 * */
+			template <std::size_t N>
+			requires (N < MEMBERS_COUNT)
+			auto has() const noexcept -> bool {
+				return N < m_fieldsCount
+					&& (static_cast<std::uint8_t> (m_data[__internals::VIEW_HEADER_SIZE + N / 8]) & (1 << (N % 8))) != 0;
+			}
+
+			template <flex::FixedString NAME>
+			auto has() const noexcept -> bool {
+				return this->has<flex::reflection_member_index_v<T, NAME>> ();
+			}
+
+			template <std::size_t N>
+			requires (N < MEMBERS_COUNT)
+			auto get() const noexcept -> __internals::view_field_result_t<Member<N>> {
+				using Field = Member<N>;
+				if constexpr (flex::optional<Field>) {
+					if (!this->has<N> ())
+						return std::nullopt;
+					return View::readField<typename Field::value_type> (m_data.data() + this->getOffset(N));
+				}
+				else {
+					if (!this->has<N> ())
+						return __internals::view_field_result_t<Field> {};
+					return View::readField<Field> (m_data.data() + this->getOffset(N));
+				}
+			}
+
+			template <flex::FixedString NAME>
+			auto get() const noexcept {
+				return this->get<flex::reflection_member_index_v<T, NAME>> ();
+			}
+
+			/*
+			 * @brief The bytes of the message, to forward it as is
+			 * */
+			auto getData() const noexcept -> std::span<const std::byte> {return m_data;}
+
+			/*
+			 * @brief The amount of members of the `T` that wrote the message
+			 * */
+			auto getFieldsCount() const noexcept -> std::size_t {return m_fieldsCount;}
+
+
+		private:
+			template <flex::reflectable U>
+			friend class View;
+
+			View(std::span<const std::byte> data) noexcept :
+				m_data {data},
+				m_fieldsCount {__internals::loadLittleEndian<std::uint16_t> (data.data() + 4)}
+			{}
+
+			auto getOffset(std::size_t index) const noexcept -> std::size_t {
+				return __internals::loadLittleEndian<std::uint32_t> (
+					m_data.data() + __internals::getViewOffsetsPosition(m_fieldsCount) + index * sizeof(std::uint32_t)
+				);
+			}
+
+			template <typename F>
+			static auto readField(const std::byte *data) noexcept -> __internals::view_field_result_t<F> {
+				if constexpr (__internals::view_scalar<F>) {
+					std::array<std::byte, sizeof(F)> bytes {};
+					std::memcpy(bytes.data(), data, sizeof(F));
+					if constexpr (std::endian::native == std::endian::big)
+						std::ranges::reverse(bytes);
+					return std::bit_cast<F> (bytes);
+				}
+				else if constexpr (flex::is_string_v<F>) {
+					const auto size {__internals::loadLittleEndian<std::uint32_t> (data)};
+					return std::string_view{reinterpret_cast<const char*> (data + sizeof(std::uint32_t)), size};
+				}
+				else if constexpr (__internals::view_span<F>) {
+					using Element = std::ranges::range_value_t<F>;
+					const auto count {__internals::loadLittleEndian<std::uint32_t> (data)};
+					const std::size_t elementsOffset {__internals::getViewElementsOffset(reinterpret_cast<std::uintptr_t> (data), alignof(Element))};
+					return std::span<const Element> {reinterpret_cast<const Element*> (data + elementsOffset), count};
+				}
+				else
+					return View<F> {std::span<const std::byte> {data, __internals::loadLittleEndian<std::uint32_t> (data)}};
+			}
+
+			/*
+			 * @brief Check that the table in `data` and everything it refers to lies inside `data`
+			 * */
+			static auto validate(std::span<const std::byte> data) noexcept -> std::optional<ViewError> {
+				if (data.size() < __internals::VIEW_HEADER_SIZE)
+					return ViewError::eTruncated;
+				const std::size_t size {__internals::loadLittleEndian<std::uint32_t> (data.data())};
+				const std::size_t fieldsCount {__internals::loadLittleEndian<std::uint16_t> (data.data() + 4)};
+				if (size > data.size())
+					return ViewError::eTruncated;
+				if (__internals::getViewOffsetsPosition(fieldsCount) + fieldsCount * sizeof(std::uint32_t) > size)
+					return ViewError::eInvalidOffset;
+
+				const View view {data.first(size)};
+				return [&view]<std::size_t ...INDICES>(std::index_sequence<INDICES...>) {
+					std::optional<ViewError> error {};
+					((error = view.template validateMember<INDICES> ()) || ...);
+					return error;
+				}(std::make_index_sequence<MEMBERS_COUNT> {});
+			}
+
+			template <std::size_t N>
+			auto validateMember() const noexcept -> std::optional<ViewError> {
+				if (!this->has<N> ())
+					return std::nullopt;
+				const std::size_t offset {this->getOffset(N)};
+				if (offset >= m_data.size())
+					return ViewError::eInvalidOffset;
+				using Field = Member<N>;
+				if constexpr (flex::optional<Field>)
+					return View::validateField<typename Field::value_type> (m_data.subspan(offset));
+				else
+					return View::validateField<Field> (m_data.subspan(offset));
+			}
+
+			template <typename F>
+			static auto validateField(std::span<const std::byte> data) noexcept -> std::optional<ViewError> {
+				if constexpr (__internals::view_scalar<F>) {
+					if (data.size() < sizeof(F))
+						return ViewError::eTruncated;
+					if constexpr (std::same_as<F, bool>) {
+						if (static_cast<std::uint8_t> (data[0]) > 1)
+							return ViewError::eInvalidValue;
+					}
+					return std::nullopt;
+				}
+				else if constexpr (flex::is_string_v<F> || __internals::view_span<F>) {
+					using Element = std::conditional_t<flex::is_string_v<F>, char, std::ranges::range_value_t<F>>;
+					if (data.size() < sizeof(std::uint32_t))
+						return ViewError::eTruncated;
+					if (reinterpret_cast<std::uintptr_t> (data.data()) % alignof(std::uint32_t) != 0)
+						return ViewError::eMisaligned;
+					const std::size_t count {__internals::loadLittleEndian<std::uint32_t> (data.data())};
+					const std::size_t elementsOffset {__internals::getViewElementsOffset(reinterpret_cast<std::uintptr_t> (data.data()), alignof(Element))};
+					if (count > (data.size() - std::min(elementsOffset, data.size())) / sizeof(Element))
+						return ViewError::eTruncated;
+					return std::nullopt;
+				}
+				else {
+					if (reinterpret_cast<std::uintptr_t> (data.data()) % __internals::VIEW_TABLE_ALIGNMENT != 0)
+						return ViewError::eMisaligned;
+					return View<F>::validate(data);
+				}
+			}
+
+			std::span<const std::byte> m_data;
+			std::size_t m_fieldsCount;
+	};
+
+} // namespace flex
@@ -1,10 +1,766 @@
 #include "flex/logger.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "flex/concurrentRingBuffer.hpp"
+
 
 namespace flex {
-	std::ostream *Logger::s_outputStream {&std::cout};
-	Logger::FormatStringType Logger::s_formatString {"{2}[{1}] > {0}{3}"};
+	namespace __internals {
+		/*
+		 * @brief A single-producer single-consumer byte ring holding the deferred records of one thread
+		 *
+		 * Records never wrap around the end of the ring : when a record doesn't fit in the remaining
+		 * space, a record of size 0 is written as a marker and the record starts back at offset 0.
+		 * */
+		class LoggerStagingBuffer final {
+			static constexpr std::size_t ALIGNMENT {alignof(std::max_align_t)};
+			static constexpr std::size_t CACHE_LINE_SIZE {64};
+
+			public:
+				LoggerStagingBuffer(std::size_t capacity) noexcept :
+					m_capacity {std::bit_ceil(std::max(capacity, 1024uz))},
+					m_data {std::make_unique<std::byte[]> (m_capacity)},
+					m_reservedHead {0},
+					m_cachedTail {0},
+					m_head {0},
+					m_tail {0}
+				{}
+
+				~LoggerStagingBuffer() = default;
+
+				LoggerStagingBuffer(const LoggerStagingBuffer&) = delete;
+				auto operator=(const LoggerStagingBuffer&) -> LoggerStagingBuffer& = delete;
+				LoggerStagingBuffer(LoggerStagingBuffer&&) = delete;
+				auto operator=(LoggerStagingBuffer&&) -> LoggerStagingBuffer& = delete;
+
+
+				[[nodiscard]]
+				auto reserve(std::size_t size) noexcept -> std::byte* {
+					size = alignUp(size);
+					if (size > m_capacity / 2)
+						return nullptr;
+
+					const std::size_t head {m_head.load(std::memory_order_relaxed)};
+					const std::size_t offset {head & (m_capacity - 1)};
+					const std::size_t padding {offset + size > m_capacity ? m_capacity - offset : 0};
+					if (head + padding + size - m_cachedTail > m_capacity) {
+						m_cachedTail = m_tail.load(std::memory_order_acquire);
+						if (head + padding + size - m_cachedTail > m_capacity)
+							return nullptr;
+					}
+
+					if (padding != 0) {
+						constexpr std::uint32_t WRAP_MARKER {0};
+						std::memcpy(m_data.get() + offset, &WRAP_MARKER, sizeof(WRAP_MARKER));
+					}
+					m_reservedHead = head + padding + size;
+					return m_data.get() + ((head + padding) & (m_capacity - 1));
+				}
+
+				auto commit() noexcept -> void {
+					m_head.store(m_reservedHead, std::memory_order_release);
+				}
+
+
+				template <typename Callback>
+				auto consume(Callback &&callback, std::size_t maxCount) noexcept -> std::size_t {
+					const std::size_t head {m_head.load(std::memory_order_acquire)};
+					std::size_t tail {m_tail.load(std::memory_order_relaxed)};
+					std::size_t count {0};
+					while (tail != head && count < maxCount) {
+						const std::size_t offset {tail & (m_capacity - 1)};
+						std::uint32_t size {};
+						std::memcpy(&size, m_data.get() + offset, sizeof(size));
+						if (size == 0) {
+							tail += m_capacity - offset;
+							continue;
+						}
+
+						callback(static_cast<const std::byte*> (m_data.get() + offset));
+						tail += alignUp(size);
+						++count;
+					}
+					m_tail.store(tail, std::memory_order_release);
+					return count;
+				}
+
+				[[nodiscard]]
+				auto isEmpty() const noexcept -> bool {
+					return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_relaxed);
+				}
+
+
+			private:
+				static constexpr auto alignUp(std::size_t size) noexcept -> std::size_t {
+					return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+				}
+
+				std::size_t m_capacity;
+				std::unique_ptr<std::byte[]> m_data;
+				std::size_t m_reservedHead;
+				std::size_t m_cachedTail;
+				alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_head;
+				alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_tail;
+		};
+
+
+		class LoggerAsyncBackend final {
+			public:
+				struct Record {
+					std::string content;
+					flex::logger::binary::PendingDefinitions definitions;
+				};
+
+				LoggerAsyncBackend(std::size_t capacity, LogOverflowPolicy overflowPolicy, std::size_t batchSize) :
+					m_ring {capacity},
+					m_overflowPolicy {overflowPolicy},
+					m_batchSize {batchSize == 0 ? 1 : batchSize},
+					m_enqueued {0},
+					m_completed {0},
+					m_dropped {0},
+					m_wakeup {0},
+					m_writerSleeping {false},
+					m_generation {s_nextGeneration.fetch_add(1, std::memory_order_relaxed)},
+					m_stagingMutex {},
+					m_stagingBuffers {},
+					m_chunk {},
+					m_chunkDefinitions {},
+					m_writer {[this](std::stop_token stopToken) {this->run(stopToken);}}
+				{}
+
+				~LoggerAsyncBackend() {
+					m_writer.request_stop();
+					m_writer.join();
+				}
+
+				LoggerAsyncBackend(const LoggerAsyncBackend&) = delete;
+				auto operator=(const LoggerAsyncBackend&) -> LoggerAsyncBackend& = delete;
+				LoggerAsyncBackend(LoggerAsyncBackend&&) = delete;
+				auto operator=(LoggerAsyncBackend&&) -> LoggerAsyncBackend& = delete;
+
+
+				auto push(Record &&record) noexcept -> void {
+					// counted before being published, so that neither a flush nor the completion of a
+					// dropped record can see it completed but not enqueued
+					m_enqueued.fetch_add(1);
+					while (!m_ring.tryPush(std::move(record))) {
+						switch (m_overflowPolicy) {
+							using enum LogOverflowPolicy;
+							case eBlock:
+								this->wakeWriter();
+								std::this_thread::yield();
+								break;
+							case eDropNewest:
+								m_dropped.fetch_add(1, std::memory_order_relaxed);
+								this->complete(1);
+								return;
+							case eDropOldest:
+								if (m_ring.tryPop()) {
+									m_dropped.fetch_add(1, std::memory_order_relaxed);
+									this->complete(1);
+								}
+								break;
+						}
+					}
+
+					this->notifyPublished();
+				}
+
+				[[nodiscard]]
+				auto reserveDeferred(std::size_t size) noexcept -> std::byte* {
+					if (t_staging.generation != m_generation || !t_staging.buffer) {
+						t_staging.buffer = std::make_shared<LoggerStagingBuffer> (s_stagingBufferSize);
+						t_staging.generation = m_generation;
+						std::lock_guard _ {m_stagingMutex};
+						m_stagingBuffers.push_back(t_staging.buffer);
+					}
+					return t_staging.buffer->reserve(size);
+				}
+
+				auto commitDeferred() noexcept -> void {
+					m_enqueued.fetch_add(1);
+					t_staging.buffer->commit();
+					this->notifyPublished();
+				}
+
+				auto flush() noexcept -> void {
+					const std::size_t target {m_enqueued.load(std::memory_order_acquire)};
+					std::size_t completed {m_completed.load(std::memory_order_acquire)};
+					while (completed < target) {
+						this->wakeWriter();
+						m_completed.wait(completed, std::memory_order_acquire);
+						completed = m_completed.load(std::memory_order_acquire);
+					}
+				}
+
+				[[nodiscard]]
+				auto getDroppedRecordsCount() const noexcept -> std::size_t {
+					return m_dropped.load(std::memory_order_relaxed);
+				}
+
+
+				static inline std::size_t s_stagingBufferSize {64 * 1024};
+
+
+			private:
+				struct ThreadStaging {
+					std::shared_ptr<LoggerStagingBuffer> buffer;
+					std::uint64_t generation;
+				};
+
+				auto notifyPublished() noexcept -> void {
+					if (m_writerSleeping.load())
+						this->wakeWriter();
+				}
+
+				auto wakeWriter() noexcept -> void {
+					m_wakeup.fetch_add(1, std::memory_order_release);
+					m_wakeup.notify_one();
+				}
+
+				auto complete(std::size_t count) noexcept -> void {
+					m_completed.fetch_add(count, std::memory_order_release);
+					m_completed.notify_all();
+				}
+
+				auto drainBatch() noexcept -> std::size_t {
+					m_chunk.clear();
+					m_chunkDefinitions.clear();
+					std::size_t written {0};
+					while (written < m_batchSize) {
+						std::optional<Record> record {m_ring.tryPop()};
+						if (!record)
+							break;
+						m_chunk += record->content;
+						if (!record->definitions.isEmpty())
+							m_chunkDefinitions.push_back(std::move(record->definitions));
+						++written;
+					}
+
+					{
+						std::lock_guard _ {m_stagingMutex};
+						for (const auto &buffer : m_stagingBuffers) {
+							written += buffer->consume([this](const std::byte *record) {
+								Logger::DeferredRecordHeader header {};
+								std::memcpy(&header, record, sizeof(header));
+								const std::string content {header.decoder(header.format, record + sizeof(header))};
+								m_chunk += Logger::formatRecord(header.level, header.callSite, content);
+							}, m_batchSize);
+						}
+
+						// the buffers of exited threads are only referenced here anymore
+						std::erase_if(m_stagingBuffers, [](const auto &buffer) {
+							return buffer.use_count() == 1 && buffer->isEmpty();
+						});
+					}
+					if (written != 0) {
+						const std::string_view chunk {m_chunk};
+						Logger::writeToSink({&chunk, 1});
+						for (const auto &definitions : m_chunkDefinitions)
+							definitions.commit();
+						this->complete(written);
+					}
+					return written;
+				}
+
+				auto run(std::stop_token stopToken) noexcept -> void {
+					std::stop_callback stopCallback {stopToken, [this]() {this->wakeWriter();}};
+					while (true) {
+						const std::uint32_t wakeup {m_wakeup.load(std::memory_order_acquire)};
+						if (this->drainBatch() != 0)
+							continue;
+						if (stopToken.stop_requested())
+							break;
+
+						// announce the sleep, then check again so that a producer that missed the
+						// announcement has necessarily published its record before our last check
+						m_writerSleeping.store(true);
+						if (m_enqueued.load() == m_completed.load() && !stopToken.stop_requested())
+							m_wakeup.wait(wakeup, std::memory_order_acquire);
+						m_writerSleeping.store(false);
+					}
+
+					while (this->drainBatch() != 0);
+				}
+
+
+				ConcurrentRingBuffer<Record> m_ring;
+				LogOverflowPolicy m_overflowPolicy;
+				std::size_t m_batchSize;
+				std::atomic<std::size_t> m_enqueued;
+				std::atomic<std::size_t> m_completed;
+				std::atomic<std::size_t> m_dropped;
+				std::atomic<std::uint32_t> m_wakeup;
+				std::atomic<bool> m_writerSleeping;
+				std::uint64_t m_generation;
+				std::mutex m_stagingMutex;
+				std::vector<std::shared_ptr<LoggerStagingBuffer>> m_stagingBuffers;
+				std::string m_chunk;
+				std::vector<flex::logger::binary::PendingDefinitions> m_chunkDefinitions;
+				std::jthread m_writer;
+
+				static inline std::atomic<std::uint64_t> s_nextGeneration {1};
+				static inline thread_local ThreadStaging t_staging {};
+		};
+
+
+		/*
+		 * @brief The records of one thread waiting to be written, when thread buffering is enabled
+		 *
+		 * The mutex is only contended when another thread calls `Logger::flush()`.
+		 * */
+		class LoggerThreadBuffer final {
+			public:
+				LoggerThreadBuffer() noexcept = default;
+				~LoggerThreadBuffer() {
+					if (!m_registered)
+						return;
+					{
+						std::lock_guard _ {s_registryMutex};
+						std::erase(s_registry, this);
+					}
+					this->flush();
+				}
+
+				LoggerThreadBuffer(const LoggerThreadBuffer&) = delete;
+				auto operator=(const LoggerThreadBuffer&) -> LoggerThreadBuffer& = delete;
+				LoggerThreadBuffer(LoggerThreadBuffer&&) = delete;
+				auto operator=(LoggerThreadBuffer&&) -> LoggerThreadBuffer& = delete;
+
+
+				auto append(std::string_view record, std::size_t flushThreshold) noexcept -> void {
+					if (!m_registered) {
+						std::lock_guard _ {s_registryMutex};
+						s_registry.push_back(this);
+						m_registered = true;
+					}
+
+					std::lock_guard _ {m_mutex};
+					m_data += record;
+					if (m_data.size() < flushThreshold)
+						return;
+					const std::string_view chunk {m_data};
+					Logger::writeToSink({&chunk, 1});
+					m_data.clear();
+				}
+
+				auto flush() noexcept -> void {
+					std::lock_guard _ {m_mutex};
+					if (m_data.empty())
+						return;
+					const std::string_view chunk {m_data};
+					Logger::writeToSink({&chunk, 1});
+					m_data.clear();
+				}
+
+				/*
+				 * @brief Write the content of every thread buffer, with a single `writev(2)` when possible
+				 * */
+				static auto flushAll() noexcept -> void {
+					std::lock_guard _ {s_registryMutex};
+					std::vector<std::unique_lock<std::mutex>> locks {};
+					std::vector<std::string_view> chunks {};
+					locks.reserve(s_registry.size());
+					chunks.reserve(s_registry.size());
+					for (LoggerThreadBuffer *buffer : s_registry) {
+						locks.emplace_back(buffer->m_mutex);
+						if (!buffer->m_data.empty())
+							chunks.push_back(buffer->m_data);
+					}
+
+					if (!chunks.empty())
+						Logger::writeToSink(chunks);
+					for (LoggerThreadBuffer *buffer : s_registry)
+						buffer->m_data.clear();
+				}
+
+
+			private:
+				std::mutex m_mutex {};
+				std::string m_data {};
+				bool m_registered {false};
+
+				static inline std::mutex s_registryMutex {};
+				static inline std::vector<LoggerThreadBuffer*> s_registry {};
+		};
+
+	} // namespace __internals
+
+
+	namespace {
+		using SinkList = std::vector<std::shared_ptr<flex::logger::Sink>>;
+		std::atomic<std::shared_ptr<const SinkList>> s_sinks {
+			std::make_shared<const SinkList> (SinkList{std::make_shared<flex::logger::OStreamSink> (std::cout)})
+		};
+		std::mutex s_sinksUpdateMutex {};
+
+		std::atomic<std::uint64_t> s_binaryGeneration {1};
+		std::atomic<std::uint64_t> s_binaryStreamGeneration {0};
+		std::mutex s_binaryPrologueMutex {};
+		std::uint64_t s_binaryPrologueGeneration {0};
+		std::string s_binaryPrologue {};
+		std::atomic<std::uint32_t> s_nextBinaryCallSiteId {1};
+
+		std::mutex s_samplersMutex {};
+		LogSampler *s_samplers {nullptr};
+		std::atomic<std::uint64_t> s_suppressedRecordsSummaryInterval {10};
+		std::atomic<std::uint64_t> s_nextSuppressedRecordsSummary {0};
+
+		bool s_threadBuffering {false};
+		std::size_t s_threadBufferFlushThreshold {16 * 1024};
+		thread_local __internals::LoggerThreadBuffer t_threadBuffer {};
+
+		std::mutex s_callSitesMutex {};
+		LogCallSite *s_callSites {nullptr};
+		std::function<bool(const LogCallSite&)> s_callSiteFilter {};
+
+		auto computeCallSiteState(const LogCallSite &callSite, LogLevel minLevel) noexcept -> LogCallSite::State {
+			if (callSite.level < minLevel)
+				return LogCallSite::State::eDisabled;
+			if (s_callSiteFilter && !s_callSiteFilter(callSite))
+				return LogCallSite::State::eDisabled;
+			return LogCallSite::State::eEnabled;
+		}
+
+		auto refreshCallSites(LogLevel minLevel) noexcept -> void {
+			for (LogCallSite *callSite {s_callSites}; callSite != nullptr; callSite = callSite->next)
+				callSite->state.store(computeCallSiteState(*callSite, minLevel), std::memory_order_relaxed);
+		}
+
+	} // namespace
+
+
+	Logger::FormatStringType Logger::s_formatString {"{3}[{1}] > {0}{4}"};
 	LogLevel Logger::s_minLevel {LogLevel::eInfo};
 	bool Logger::s_colorEnabled {true};
+	bool Logger::s_deferredFormatting {false};
+	bool Logger::s_binaryFormat {false};
+
+	namespace {
+		// declared after every static the writer thread uses : statics are destroyed in reverse
+		// order, so a backend still enabled at exit drains its records before they go away
+		std::unique_ptr<__internals::LoggerAsyncBackend> s_asyncBackend {};
+
+	} // namespace
+
+
+	auto Logger::setMinLevel(LogLevel minLevel) noexcept -> void {
+		std::lock_guard _ {s_callSitesMutex};
+		s_minLevel = minLevel;
+		refreshCallSites(minLevel);
+	}
+
+	auto Logger::setCallSiteFilter(std::function<bool(const LogCallSite&)> filter) noexcept -> void {
+		std::lock_guard _ {s_callSitesMutex};
+		s_callSiteFilter = std::move(filter);
+		refreshCallSites(s_minLevel);
+	}
+
+	auto Logger::registerCallSite(LogCallSite &callSite) noexcept -> bool {
+		std::lock_guard _ {s_callSitesMutex};
+		// another thread may have registered it while we were waiting for the lock
+		if (callSite.state.load(std::memory_order_relaxed) == LogCallSite::State::eUnregistered) {
+			callSite.next = s_callSites;
+			s_callSites = &callSite;
+			callSite.state.store(computeCallSiteState(callSite, s_minLevel), std::memory_order_relaxed);
+		}
+		return callSite.state.load(std::memory_order_relaxed) == LogCallSite::State::eEnabled;
+	}
+
+
+	auto Logger::logSuppressedRecords() noexcept -> void {
+		std::vector<std::pair<const LogCallSite*, std::uint64_t>> summaries {};
+		{
+			std::lock_guard _ {s_samplersMutex};
+			for (LogSampler *sampler {s_samplers}; sampler != nullptr; sampler = sampler->next) {
+				const std::uint64_t suppressedCount {sampler->getSuppressedCount()};
+				if (suppressedCount == sampler->reportedCount)
+					continue;
+				summaries.emplace_back(sampler->callSite, suppressedCount - sampler->reportedCount);
+				sampler->reportedCount = suppressedCount;
+			}
+		}
+
+		// the origin goes in the content, as the call site describes the format of its own records
+		for (const auto &[callSite, count] : summaries) {
+			logImpl(callSite->level, nullptr, "{} similar records suppressed at {}:{} ({})",
+				count,
+				callSite->location.file_name(),
+				callSite->location.line(),
+				callSite->location.function_name()
+			);
+		}
+	}
+
+	auto Logger::setSuppressedRecordsSummaryInterval(std::chrono::seconds interval) noexcept -> void {
+		s_suppressedRecordsSummaryInterval.store(static_cast<std::uint64_t> (interval.count()), std::memory_order_relaxed);
+		s_nextSuppressedRecordsSummary.store(0, std::memory_order_relaxed);
+	}
+
+	auto Logger::getCoarseSeconds() noexcept -> std::uint64_t {
+	#ifdef CLOCK_MONOTONIC_COARSE
+		timespec time {};
+		::clock_gettime(CLOCK_MONOTONIC_COARSE, &time);
+		return static_cast<std::uint64_t> (time.tv_sec);
+	#else
+		return static_cast<std::uint64_t> (std::chrono::duration_cast<std::chrono::seconds> (
+			std::chrono::steady_clock::now().time_since_epoch()
+		).count());
+	#endif
+	}
+
+	auto Logger::onSampledRecord(LogSampler &sampler) noexcept -> void {
+		if (!sampler.registered.load(std::memory_order_relaxed)) {
+			std::lock_guard _ {s_samplersMutex};
+			if (!sampler.registered.load(std::memory_order_relaxed)) {
+				sampler.next = s_samplers;
+				s_samplers = &sampler;
+				sampler.registered.store(true, std::memory_order_relaxed);
+			}
+		}
+
+		const std::uint64_t interval {s_suppressedRecordsSummaryInterval.load(std::memory_order_relaxed)};
+		if (interval == 0)
+			return;
+		const std::uint64_t now {getCoarseSeconds()};
+		std::uint64_t nextSummary {s_nextSuppressedRecordsSummary.load(std::memory_order_relaxed)};
+		if (nextSummary == 0) {
+			s_nextSuppressedRecordsSummary.compare_exchange_strong(nextSummary, now + interval, std::memory_order_relaxed);
+			return;
+		}
+		if (now < nextSummary)
+			return;
+		if (s_nextSuppressedRecordsSummary.compare_exchange_strong(nextSummary, now + interval, std::memory_order_relaxed))
+			logSuppressedRecords();
+	}
+
+
+	auto Logger::enableAsync(std::size_t capacity, LogOverflowPolicy overflowPolicy, std::size_t batchSize) noexcept -> bool {
+		s_asyncBackend.reset();
+		FLEX_TRY {
+			s_asyncBackend = std::make_unique<__internals::LoggerAsyncBackend> (capacity, overflowPolicy, batchSize);
+		}
+		FLEX_CATCH(...) {
+			return false;
+		}
+		return true;
+	}
+
+	auto Logger::disableAsync() noexcept -> void {
+		s_asyncBackend.reset();
+	}
+
+	auto Logger::isAsync() noexcept -> bool {
+		return !!s_asyncBackend;
+	}
+
+	auto Logger::flush() noexcept -> void {
+		if (s_asyncBackend)
+			return s_asyncBackend->flush();
+		__internals::LoggerThreadBuffer::flushAll();
+		for (const auto &sink : *s_sinks.load(std::memory_order_acquire))
+			sink->flush();
+	}
+
+	auto Logger::getDroppedRecordsCount() noexcept -> std::size_t {
+		if (!s_asyncBackend)
+			return 0;
+		return s_asyncBackend->getDroppedRecordsCount();
+	}
+
+
+	auto Logger::setDeferredFormatting(bool enabled, std::size_t stagingBufferSize) noexcept -> void {
+		s_deferredFormatting = enabled;
+		__internals::LoggerAsyncBackend::s_stagingBufferSize = stagingBufferSize;
+	}
+
+
+	auto Logger::setBinaryFormat(bool enabled) noexcept -> void {
+		s_binaryGeneration.fetch_add(1, std::memory_order_relaxed);
+		s_binaryFormat = enabled;
+		flex::logger::Sink::setStreamPrologue(enabled ? &writeBinaryPrologue : nullptr);
+	}
+
+
+	auto Logger::formatRecord(LogLevel level, const LogCallSite *callSite, const std::string &content) noexcept -> std::string {
+		std::string levelString {};
+		switch (level) {
+			using enum LogLevel;
+			case eVerbose: levelString = "verbose"; break;
+			case eInfo: levelString = "info"; break;
+			case eWarning: levelString = "warning"; break;
+			case eError: levelString = "error"; break;
+			case eFatal: levelString = "fatal"; break;
+		}
+
+		std::string colorStart {};
+		if (s_colorEnabled) {
+			switch (level) {
+				using enum LogLevel;
+				case eVerbose: colorStart = "\033[90m"; break;
+				case eInfo: colorStart = "\033[34m"; break;
+				case eWarning: colorStart = "\033[33m"; break;
+				case eError: colorStart = "\033[91m"; break;
+				case eFatal: colorStart = "\033[31m"; break;
+			}
+		}
+		const std::string colorEnd {s_colorEnabled ? "\033[m" : ""};
+
+		std::string origin {};
+		if (callSite != nullptr) {
+			origin = std::format("{}:{} ({})",
+				callSite->location.file_name(),
+				callSite->location.line(),
+				callSite->location.function_name()
+			);
+		}
+
+		std::string record {std::format(s_formatString.get(),
+			content,
+			levelString,
+			origin,
+			colorStart,
+			colorEnd
+		)};
+		record += '\n';
+		return record;
+	}
+
+	auto Logger::beginBinaryRecord(LogLevel level, const LogCallSite *callSite, std::string_view format, std::size_t argumentsCount) noexcept
+		-> flex::logger::binary::Encoder
+	{
+		flex::logger::binary::Encoder encoder {s_binaryGeneration.load(std::memory_order_relaxed)};
+		encoder.defineStream(s_binaryStreamGeneration);
+
+		const auto timestamp {static_cast<std::uint64_t> (std::chrono::duration_cast<std::chrono::nanoseconds> (
+			std::chrono::system_clock::now().time_since_epoch()
+		).count())};
+		const auto binaryLevel {static_cast<std::uint8_t> (level)};
+		if (callSite == nullptr) {
+			encoder.beginRecord(timestamp, binaryLevel, 0, format, argumentsCount);
+			return encoder;
+		}
+
+		std::uint32_t id {callSite->binaryId.load(std::memory_order_relaxed)};
+		if (id == 0) {
+			const std::uint32_t newId {s_nextBinaryCallSiteId.fetch_add(1, std::memory_order_relaxed)};
+			// on failure, `id` receives the id set by another thread
+			if (callSite->binaryId.compare_exchange_strong(id, newId, std::memory_order_relaxed))
+				id = newId;
+		}
+		encoder.defineCallSite(callSite->binaryGeneration, id, binaryLevel, callSite->location, format);
+		encoder.beginRecord(timestamp, binaryLevel, id, format, argumentsCount);
+		return encoder;
+	}
+
+	auto Logger::writeBinaryRecord(flex::logger::binary::Encoder &encoder) noexcept -> void {
+		// kept before the chunk is written : a stream started in between either begins with these
+		// descriptions or receives the chunk itself
+		if (const std::string_view definitions {encoder.getDefinitions()}; !definitions.empty()) {
+			std::lock_guard _ {s_binaryPrologueMutex};
+			// the first descriptions of a generation always start with the header
+			if (encoder.getGeneration() > s_binaryPrologueGeneration) {
+				s_binaryPrologueGeneration = encoder.getGeneration();
+				s_binaryPrologue.clear();
+			}
+			if (encoder.getGeneration() == s_binaryPrologueGeneration)
+				s_binaryPrologue += definitions;
+		}
+
+		std::string chunk {encoder.takeChunk()};
+		write(std::move(chunk), encoder.takeDefinitions());
+	}
+
+	auto Logger::writeBinaryPrologue(std::string &output) noexcept -> void {
+		std::lock_guard _ {s_binaryPrologueMutex};
+		output += s_binaryPrologue;
+	}
+
+	auto Logger::setOutputStream(std::ostream &stream, bool colorEnabled) noexcept -> void {
+		setSinks({std::make_shared<flex::logger::OStreamSink> (stream)}, colorEnabled);
+	}
+
+	auto Logger::setOutputFileDescriptor([[maybe_unused]] int fileDescriptor, [[maybe_unused]] bool colorEnabled) noexcept -> void {
+	#ifdef FLEX_POSIX
+		setSinks({std::make_shared<flex::logger::FileDescriptorSink> (fileDescriptor)}, colorEnabled);
+	#endif
+	}
+
+	auto Logger::setSinks(std::vector<std::shared_ptr<flex::logger::Sink>> sinks, bool colorEnabled) noexcept -> void {
+		std::lock_guard _ {s_sinksUpdateMutex};
+		std::erase(sinks, nullptr);
+		s_sinks.store(std::make_shared<const SinkList> (std::move(sinks)), std::memory_order_release);
+		s_binaryGeneration.fetch_add(1, std::memory_order_relaxed);
+		s_colorEnabled = colorEnabled;
+	}
+
+	auto Logger::addSink(std::shared_ptr<flex::logger::Sink> sink) noexcept -> void {
+		if (!sink)
+			return;
+		std::lock_guard _ {s_sinksUpdateMutex};
+		SinkList sinks {*s_sinks.load(std::memory_order_acquire)};
+		sinks.push_back(std::move(sink));
+		s_sinks.store(std::make_shared<const SinkList> (std::move(sinks)), std::memory_order_release);
+		// the new sink didn't see the descriptions written so far
+		s_binaryGeneration.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	auto Logger::removeSink(const std::shared_ptr<flex::logger::Sink> &sink) noexcept -> void {
+		std::lock_guard _ {s_sinksUpdateMutex};
+		SinkList sinks {*s_sinks.load(std::memory_order_acquire)};
+		std::erase(sinks, sink);
+		s_sinks.store(std::make_shared<const SinkList> (std::move(sinks)), std::memory_order_release);
+	}
+
+	auto Logger::setThreadBuffering(bool enabled, std::size_t flushThreshold) noexcept -> void {
+		if (!enabled)
+			__internals::LoggerThreadBuffer::flushAll();
+		s_threadBuffering = enabled;
+		s_threadBufferFlushThreshold = flushThreshold;
+	}
+
+
+	auto Logger::write(std::string &&record, flex::logger::binary::PendingDefinitions &&definitions) noexcept -> void {
+		if (s_asyncBackend)
+			return s_asyncBackend->push({std::move(record), std::move(definitions)});
+
+		if (s_threadBuffering) {
+			// the descriptions must reach the sinks before the records of other threads using them
+			t_threadBuffer.append(record, definitions.isEmpty() ? s_threadBufferFlushThreshold : 0);
+			definitions.commit();
+			return;
+		}
+		const std::string_view chunk {record};
+		writeToSink({&chunk, 1});
+		definitions.commit();
+	}
+
+	auto Logger::writeToSink(std::span<const std::string_view> chunks) noexcept -> void {
+		const std::shared_ptr<const SinkList> sinks {s_sinks.load(std::memory_order_acquire)};
+		for (const auto &sink : *sinks)
+			sink->write(chunks);
+	}
+
+	auto Logger::reserveDeferredRecord(std::size_t size) noexcept -> std::byte* {
+		if (!s_asyncBackend)
+			return nullptr;
+		return s_asyncBackend->reserveDeferred(size);
+	}
+
+	auto Logger::commitDeferredRecord() noexcept -> void {
+		s_asyncBackend->commitDeferred();
+	}
 
 } // namespace flex
@@ -0,0 +1,540 @@
+#include "flex/logger/binary.hpp"
+
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+
+#include "flex/config.hpp"
+
+
+namespace flex::logger::binary {
+	namespace {
+		constexpr std::size_t MAX_VALUE_DEPTH {64};
+
+		constexpr std::array<std::string_view, 5> LEVEL_NAMES {"verbose", "info", "warning", "error", "fatal"};
+
+
+		class Reader final {
+			public:
+				Reader(std::span<const std::byte> data) noexcept : m_data {data}, m_exhausted {false} {}
+
+				auto isEmpty() const noexcept -> bool {return m_data.empty();}
+				/*
+				 * @brief Whether a read failed because the data ended
+				 * */
+				auto isExhausted() const noexcept -> bool {return m_exhausted;}
+				auto getRemainingSize() const noexcept -> std::size_t {return m_data.size();}
+				auto isZeroFilled() const noexcept -> bool {
+					return std::ranges::all_of(m_data, [](std::byte byte) noexcept {return byte == std::byte{0};});
+				}
+
+				auto readByte() noexcept -> std::optional<std::uint8_t> {
+					if (m_data.empty()) {
+						m_exhausted = true;
+						return std::nullopt;
+					}
+					const auto value {static_cast<std::uint8_t> (m_data.front())};
+					m_data = m_data.subspan(1);
+					return value;
+				}
+
+				auto readVarint() noexcept -> std::optional<std::uint64_t> {
+					std::uint64_t value {0};
+					for (std::size_t shift {0}; shift < 64; shift += 7) {
+						const std::optional<std::uint8_t> byte {this->readByte()};
+						if (!byte)
+							return std::nullopt;
+						value |= static_cast<std::uint64_t> (*byte & 0x7f) << shift;
+						if ((*byte & 0x80) == 0)
+							return value;
+					}
+					return std::nullopt;
+				}
+
+				auto readSigned() noexcept -> std::optional<std::int64_t> {
+					const std::optional<std::uint64_t> value {this->readVarint()};
+					if (!value)
+						return std::nullopt;
+					return static_cast<std::int64_t> ((*value >> 1) ^ (~(*value & 1) + 1));
+				}
+
+				auto readFixed64() noexcept -> std::optional<std::uint64_t> {
+					std::uint64_t value {};
+					if (m_data.size() < sizeof(value)) {
+						m_exhausted = true;
+						return std::nullopt;
+					}
+					std::memcpy(&value, m_data.data(), sizeof(value));
+					m_data = m_data.subspan(sizeof(value));
+					if constexpr (std::endian::native == std::endian::big)
+						value = std::byteswap(value);
+					return value;
+				}
+
+				auto readString() noexcept -> std::optional<std::string_view> {
+					const std::optional<std::uint64_t> size {this->readVarint()};
+					if (!size)
+						return std::nullopt;
+					if (*size > m_data.size()) {
+						m_exhausted = true;
+						return std::nullopt;
+					}
+					const std::string_view string {reinterpret_cast<const char*> (m_data.data()), static_cast<std::size_t> (*size)};
+					m_data = m_data.subspan(static_cast<std::size_t> (*size));
+					return string;
+				}
+
+			private:
+				std::span<const std::byte> m_data;
+				bool m_exhausted;
+		};
+
+
+		struct Value {
+			ValueTag tag;
+			bool boolean;
+			std::int64_t signedInteger;
+			std::uint64_t unsignedInteger;
+			double floating;
+			std::string string;
+			std::uint32_t typeId;
+			std::vector<Value> children;
+		};
+
+		using TypesMap = std::unordered_map<std::uint32_t, std::vector<std::string>>;
+
+
+		auto readValue(Reader &reader, std::size_t depth = 0) noexcept -> std::optional<Value> {
+			if (depth == MAX_VALUE_DEPTH)
+				return std::nullopt;
+			const std::optional<std::uint8_t> tag {reader.readByte()};
+			if (!tag || *tag > static_cast<std::uint8_t> (ValueTag::eFormatted))
+				return std::nullopt;
+
+			Value value {};
+			value.tag = static_cast<ValueTag> (*tag);
+			switch (value.tag) {
+				case ValueTag::eNull:
+					return value;
+
+				case ValueTag::eBool: {
+					const std::optional<std::uint8_t> boolean {reader.readByte()};
+					if (!boolean)
+						return std::nullopt;
+					value.boolean = *boolean != 0;
+					return value;
+				}
+
+				case ValueTag::eSigned: {
+					const std::optional<std::int64_t> integer {reader.readSigned()};
+					if (!integer)
+						return std::nullopt;
+					value.signedInteger = *integer;
+					return value;
+				}
+
+				case ValueTag::eUnsigned: {
+					const std::optional<std::uint64_t> integer {reader.readVarint()};
+					if (!integer)
+						return std::nullopt;
+					value.unsignedInteger = *integer;
+					return value;
+				}
+
+				case ValueTag::eFloat: {
+					const std::optional<std::uint64_t> bits {reader.readFixed64()};
+					if (!bits)
+						return std::nullopt;
+					value.floating = std::bit_cast<double> (*bits);
+					return value;
+				}
+
+				case ValueTag::eString:
+				case ValueTag::eFormatted: {
+					const std::optional<std::string_view> string {reader.readString()};
+					if (!string)
+						return std::nullopt;
+					value.string = *string;
+					return value;
+				}
+
+				case ValueTag::eEnum: {
+					const std::optional<std::int64_t> integer {reader.readSigned()};
+					if (!integer)
+						return std::nullopt;
+					const std::optional<std::string_view> name {reader.readString()};
+					if (!name)
+						return std::nullopt;
+					value.signedInteger = *integer;
+					value.string = *name;
+					return value;
+				}
+
+				case ValueTag::eStruct:
+				case ValueTag::eList: {
+					if (value.tag == ValueTag::eStruct) {
+						const std::optional<std::uint64_t> typeId {reader.readVarint()};
+						if (!typeId)
+							return std::nullopt;
+						value.typeId = static_cast<std::uint32_t> (*typeId);
+					}
+					const std::optional<std::uint64_t> count {reader.readVarint()};
+					// every value takes at least one byte
+					if (!count || *count > reader.getRemainingSize())
+						return std::nullopt;
+					value.children.reserve(static_cast<std::size_t> (*count));
+					for (std::uint64_t i {0}; i < *count; ++i) {
+						std::optional<Value> child {readValue(reader, depth + 1)};
+						if (!child)
+							return std::nullopt;
+						value.children.push_back(std::move(*child));
+					}
+					return value;
+				}
+			}
+			return std::nullopt;
+		}
+
+
+		auto appendJsonString(std::string &output, std::string_view string) noexcept -> void {
+			output += '"';
+			for (char character : string) {
+				switch (character) {
+					case '"': output += "\\\""; break;
+					case '\\': output += "\\\\"; break;
+					case '\n': output += "\\n"; break;
+					case '\r': output += "\\r"; break;
+					case '\t': output += "\\t"; break;
+					default:
+						if (static_cast<unsigned char> (character) < 0x20)
+							output += std::format("\\u{:04x}", static_cast<unsigned> (character));
+						else
+							output += character;
+				}
+			}
+			output += '"';
+		}
+
+		auto getMemberName(const TypesMap &types, std::uint32_t typeId, std::size_t index) noexcept -> std::string {
+			const auto type {types.find(typeId)};
+			if (type == types.end() || index >= type->second.size())
+				return std::format("#{}", index);
+			return type->second[index];
+		}
+
+
+		auto appendText(std::string &output, const Value &value, const TypesMap &types, bool quoteStrings) noexcept -> void {
+			switch (value.tag) {
+				case ValueTag::eNull: output += "null"; return;
+				case ValueTag::eBool: output += value.boolean ? "true" : "false"; return;
+				case ValueTag::eSigned: output += std::to_string(value.signedInteger); return;
+				case ValueTag::eUnsigned: output += std::to_string(value.unsignedInteger); return;
+				case ValueTag::eFloat: output += std::format("{}", value.floating); return;
+				case ValueTag::eFormatted: output += value.string; return;
+
+				case ValueTag::eString:
+					if (quoteStrings)
+						appendJsonString(output, value.string);
+					else
+						output += value.string;
+					return;
+
+				case ValueTag::eEnum:
+					if (value.string.empty())
+						output += std::to_string(value.signedInteger);
+					else
+						output += value.string;
+					return;
+
+				case ValueTag::eStruct:
+					output += '{';
+					for (std::size_t i {0}; i < value.children.size(); ++i) {
+						if (i != 0)
+							output += ", ";
+						output += getMemberName(types, value.typeId, i);
+						output += ": ";
+						appendText(output, value.children[i], types, true);
+					}
+					output += '}';
+					return;
+
+				case ValueTag::eList:
+					output += '[';
+					for (std::size_t i {0}; i < value.children.size(); ++i) {
+						if (i != 0)
+							output += ", ";
+						appendText(output, value.children[i], types, true);
+					}
+					output += ']';
+					return;
+			}
+		}
+
+		auto appendJson(std::string &output, const Value &value, const TypesMap &types) noexcept -> void {
+			switch (value.tag) {
+				case ValueTag::eNull: output += "null"; return;
+				case ValueTag::eBool: output += value.boolean ? "true" : "false"; return;
+				case ValueTag::eSigned: output += std::to_string(value.signedInteger); return;
+				case ValueTag::eUnsigned: output += std::to_string(value.unsignedInteger); return;
+
+				case ValueTag::eFloat:
+					if (std::isfinite(value.floating))
+						output += std::format("{}", value.floating);
+					else
+						output += "null";
+					return;
+
+				case ValueTag::eString:
+				case ValueTag::eFormatted:
+					appendJsonString(output, value.string);
+					return;
+
+				case ValueTag::eEnum:
+					if (value.string.empty())
+						output += std::to_string(value.signedInteger);
+					else
+						appendJsonString(output, value.string);
+					return;
+
+				case ValueTag::eStruct:
+					output += '{';
+					for (std::size_t i {0}; i < value.children.size(); ++i) {
+						if (i != 0)
+							output += ',';
+						appendJsonString(output, getMemberName(types, value.typeId, i));
+						output += ':';
+						appendJson(output, value.children[i], types);
+					}
+					output += '}';
+					return;
+
+				case ValueTag::eList:
+					output += '[';
+					for (std::size_t i {0}; i < value.children.size(); ++i) {
+						if (i != 0)
+							output += ',';
+						appendJson(output, value.children[i], types);
+					}
+					output += ']';
+					return;
+			}
+		}
+
+
+		auto appendFormattedValue(std::string &output, const Value &value, std::string_view spec, const TypesMap &types) noexcept -> void {
+			if (!spec.empty()) {
+				const std::string format {std::format("{{:{}}}", spec)};
+				FLEX_TRY {
+					switch (value.tag) {
+						case ValueTag::eBool: output += std::vformat(format, std::make_format_args(value.boolean)); return;
+						case ValueTag::eSigned: output += std::vformat(format, std::make_format_args(value.signedInteger)); return;
+						case ValueTag::eUnsigned: output += std::vformat(format, std::make_format_args(value.unsignedInteger)); return;
+						case ValueTag::eFloat: output += std::vformat(format, std::make_format_args(value.floating)); return;
+						case ValueTag::eString: output += std::vformat(format, std::make_format_args(value.string)); return;
+						default: break;
+					}
+				}
+				FLEX_CATCH(const std::format_error&) {}
+			}
+			appendText(output, value, types, false);
+		}
+
+		/*
+		 * @brief Substitute the replacement fields of `format` with `arguments`, the way `std::format` would
+		 *
+		 * Format specs are applied to scalars only. Nested replacement fields are not supported.
+		 * */
+		auto formatMessage(std::string_view format, std::span<const Value> arguments, const TypesMap &types) noexcept -> std::string {
+			std::string message {};
+			std::size_t nextIndex {0};
+			for (std::size_t i {0}; i < format.size(); ++i) {
+				const char character {format[i]};
+				if (character == '}') {
+					message += '}';
+					if (i + 1 < format.size() && format[i + 1] == '}')
+						++i;
+					continue;
+				}
+				if (character != '{') {
+					message += character;
+					continue;
+				}
+				if (i + 1 < format.size() && format[i + 1] == '{') {
+					message += '{';
+					++i;
+					continue;
+				}
+
+				const std::size_t end {format.find('}', i)};
+				if (end == std::string_view::npos) {
+					message += format.substr(i);
+					break;
+				}
+				std::string_view field {format.substr(i + 1, end - i - 1)};
+				i = end;
+
+				std::string_view spec {};
+				if (const std::size_t colon {field.find(':')}; colon != std::string_view::npos) {
+					spec = field.substr(colon + 1);
+					field = field.substr(0, colon);
+				}
+				std::size_t index {nextIndex++};
+				if (!field.empty())
+					std::from_chars(field.data(), field.data() + field.size(), index);
+
+				if (index < arguments.size())
+					appendFormattedValue(message, arguments[index], spec, types);
+				else
+					message += "{?}";
+			}
+			return message;
+		}
+
+		auto getLevelName(std::uint8_t level) noexcept -> std::string_view {
+			if (level >= LEVEL_NAMES.size())
+				return "unknown";
+			return LEVEL_NAMES[level];
+		}
+
+	} // namespace
+
+
+	auto Decoder::decode(std::span<const std::byte> data, std::string &output) noexcept -> DecodeResult {
+		Reader reader {data};
+		while (!reader.isEmpty()) {
+			const std::optional<std::uint8_t> kind {reader.readByte()};
+			// the preallocated tail of a segment that was never trimmed, a header is never followed by zeros
+			if (static_cast<ChunkKind> (*kind) == ChunkKind::eHeader && reader.isZeroFilled())
+				break;
+			switch (static_cast<ChunkKind> (*kind)) {
+				case ChunkKind::eHeader: {
+					if (reader.getRemainingSize() < MAGIC.size() + 1)
+						return DecodeResult::eTruncated;
+					for (char character : MAGIC) {
+						if (*reader.readByte() != static_cast<std::uint8_t> (character))
+							return DecodeResult::eInvalidHeader;
+					}
+					if (*reader.readByte() > VERSION)
+						return DecodeResult::eUnsupportedVersion;
+					break;
+				}
+
+				case ChunkKind::eCallSite: {
+					const std::optional<std::uint64_t> id {reader.readVarint()};
+					const std::optional<std::uint8_t> level {reader.readByte()};
+					const std::optional<std::string_view> file {reader.readString()};
+					const std::optional<std::uint64_t> line {reader.readVarint()};
+					const std::optional<std::string_view> function {reader.readString()};
+					const std::optional<std::string_view> format {reader.readString()};
+					if (!id || !level || !file || !line || !function || !format)
+						return DecodeResult::eTruncated;
+					m_callSites[static_cast<std::uint32_t> (*id)] = CallSite{
+						.level = *level,
+						.file = std::string{*file},
+						.line = *line,
+						.function = std::string{*function},
+						.format = std::string{*format}
+					};
+					break;
+				}
+
+				case ChunkKind::eType: {
+					const std::optional<std::uint64_t> id {reader.readVarint()};
+					const std::optional<std::uint64_t> count {reader.readVarint()};
+					if (!id || !count || *count > reader.getRemainingSize())
+						return DecodeResult::eTruncated;
+					std::vector<std::string> names {};
+					names.reserve(static_cast<std::size_t> (*count));
+					for (std::uint64_t i {0}; i < *count; ++i) {
+						const std::optional<std::string_view> name {reader.readString()};
+						if (!name)
+							return DecodeResult::eTruncated;
+						names.emplace_back(*name);
+					}
+					m_types[static_cast<std::uint32_t> (*id)] = std::move(names);
+					break;
+				}
+
+				case ChunkKind::eRecord: {
+					const std::optional<std::uint64_t> timestamp {reader.readFixed64()};
+					const std::optional<std::uint8_t> level {reader.readByte()};
+					const std::optional<std::uint64_t> callSiteId {reader.readVarint()};
+					if (!timestamp || !level || !callSiteId)
+						return DecodeResult::eTruncated;
+
+					const CallSite *callSite {nullptr};
+					std::string_view format {};
+					if (*callSiteId == 0) {
+						const std::optional<std::string_view> inlineFormat {reader.readString()};
+						if (!inlineFormat)
+							return DecodeResult::eTruncated;
+						format = *inlineFormat;
+					}
+					else if (const auto it {m_callSites.find(static_cast<std::uint32_t> (*callSiteId))}; it != m_callSites.end()) {
+						callSite = &it->second;
+						format = callSite->format;
+					}
+
+					const std::optional<std::uint64_t> count {reader.readVarint()};
+					if (!count || *count > reader.getRemainingSize())
+						return DecodeResult::eTruncated;
+					std::vector<Value> arguments {};
+					arguments.reserve(static_cast<std::size_t> (*count));
+					for (std::uint64_t i {0}; i < *count; ++i) {
+						std::optional<Value> argument {readValue(reader)};
+						if (!argument)
+							return reader.isExhausted() ? DecodeResult::eTruncated : DecodeResult::eInvalidValue;
+						arguments.push_back(std::move(*argument));
+					}
+
+					// records of an unknown call site still show their arguments
+					std::string message {};
+					if (*callSiteId != 0 && callSite == nullptr) {
+						message = std::format("<unknown call site {}>", *callSiteId);
+						for (const Value &argument : arguments) {
+							message += ' ';
+							appendText(message, argument, m_types, true);
+						}
+					}
+					else
+						message = formatMessage(format, arguments, m_types);
+
+					if (m_outputFormat == DecodeOutputFormat::eJson) {
+						output += std::format("{{\"timestamp\":{},\"level\":\"{}\"", *timestamp, getLevelName(*level));
+						if (callSite != nullptr) {
+							output += ",\"file\":";
+							appendJsonString(output, callSite->file);
+							output += std::format(",\"line\":{},\"function\":", callSite->line);
+							appendJsonString(output, callSite->function);
+						}
+						output += ",\"message\":";
+						appendJsonString(output, message);
+						output += ",\"arguments\":[";
+						for (std::size_t i {0}; i < arguments.size(); ++i) {
+							if (i != 0)
+								output += ',';
+							appendJson(output, arguments[i], m_types);
+						}
+						output += "]}\n";
+						break;
+					}
+
+					const std::chrono::sys_time<std::chrono::nanoseconds> time {std::chrono::nanoseconds{*timestamp}};
+					output += std::format("{:%FT%T}Z [{}] ", time, getLevelName(*level));
+					if (callSite != nullptr)
+						output += std::format("{}:{} ({}) ", callSite->file, callSite->line, callSite->function);
+					output += "> ";
+					output += message;
+					output += '\n';
+					break;
+				}
+
+				default:
+					return DecodeResult::eInvalidChunk;
+			}
+		}
+		return DecodeResult::eSuccess;
+	}
+
+} // namespace flex::logger::binary
@@ -0,0 +1,376 @@
+#include "flex/logger/sinks.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <utility>
+
+#ifdef FLEX_POSIX
+	#include <cerrno>
+	#include <climits>
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/uio.h>
+	#include <unistd.h>
+#endif
+
+
+namespace flex::logger {
+	namespace {
+		auto removeFiles(std::span<const std::filesystem::path> paths) noexcept -> void {
+			for (const auto &path : paths) {
+				std::error_code error {};
+				std::filesystem::remove(path, error);
+			}
+		}
+
+		/*
+		 * @brief Write every byte of `chunks` in order through `writeSome`
+		 *
+		 * `writeSome(head, tail)` writes a prefix of `head` followed by `tail` and returns how many
+		 * bytes it took, or nothing on failure. `head` is what's left of a partially written chunk,
+		 * so a short write is resumed in the middle of it.
+		 * */
+		template <typename WriteSome>
+		auto writeChunks(std::span<const std::string_view> chunks, WriteSome &&writeSome) noexcept -> bool {
+			if (chunks.empty())
+				return true;
+			std::string_view head {chunks.front()};
+			chunks = chunks.subspan(1);
+			while (true) {
+				const std::optional<std::size_t> written {writeSome(head, chunks)};
+				if (!written)
+					return false;
+
+				std::size_t remaining {*written};
+				while (remaining >= head.size()) {
+					remaining -= head.size();
+					if (chunks.empty())
+						return true;
+					head = chunks.front();
+					chunks = chunks.subspan(1);
+				}
+				head.remove_prefix(remaining);
+			}
+		}
+
+	} // namespace
+
+
+	auto OStreamSink::write(std::span<const std::string_view> chunks) noexcept -> void {
+		std::lock_guard _ {m_mutex};
+		for (std::string_view chunk : chunks)
+			m_stream.write(chunk.data(), static_cast<std::streamsize> (chunk.size()));
+		m_stream.flush();
+	}
+
+	auto OStreamSink::flush() noexcept -> void {
+		std::lock_guard _ {m_mutex};
+		m_stream.flush();
+	}
+
+
+	auto FileDescriptorSink::write([[maybe_unused]] std::span<const std::string_view> chunks) noexcept -> void {
+	#ifdef FLEX_POSIX
+		std::vector<iovec> vectors {};
+		writeChunks(chunks, [this, &vectors](std::string_view head, std::span<const std::string_view> tail) -> std::optional<std::size_t> {
+			vectors.clear();
+			vectors.push_back(iovec{.iov_base = const_cast<char*> (head.data()), .iov_len = head.size()});
+			for (std::string_view chunk : tail.first(std::min<std::size_t> (tail.size(), IOV_MAX - 1)))
+				vectors.push_back(iovec{.iov_base = const_cast<char*> (chunk.data()), .iov_len = chunk.size()});
+
+			ssize_t written {::writev(m_fileDescriptor, vectors.data(), static_cast<int> (vectors.size()))};
+			while (written < 0 && errno == EINTR)
+				written = ::writev(m_fileDescriptor, vectors.data(), static_cast<int> (vectors.size()));
+			if (written < 0)
+				return std::nullopt;
+			return static_cast<std::size_t> (written);
+		});
+	#endif
+	}
+
+
+	MemoryRingSink::MemoryRingSink(std::size_t capacity) noexcept :
+		m_lines (std::max(capacity, 1uz)),
+		m_next {0},
+		m_count {0},
+		m_mutex {}
+	{}
+
+	auto MemoryRingSink::write(std::span<const std::string_view> chunks) noexcept -> void {
+		std::lock_guard _ {m_mutex};
+		for (std::string_view chunk : chunks) {
+			while (!chunk.empty()) {
+				const std::size_t end {std::min(chunk.find('\n'), chunk.size())};
+				m_lines[m_next].assign(chunk.substr(0, end));
+				m_next = (m_next + 1) % m_lines.size();
+				m_count = std::min(m_count + 1, m_lines.size());
+				chunk.remove_prefix(std::min(end + 1, chunk.size()));
+			}
+		}
+	}
+
+	auto MemoryRingSink::getLines() const noexcept -> std::vector<std::string> {
+		std::lock_guard _ {m_mutex};
+		std::vector<std::string> lines {};
+		lines.reserve(m_count);
+		const std::size_t first {(m_next + m_lines.size() - m_count) % m_lines.size()};
+		for (std::size_t i {0}; i < m_count; ++i)
+			lines.push_back(m_lines[(first + i) % m_lines.size()]);
+		return lines;
+	}
+
+
+	RotatingFileSink::RotatingFileSink(const CreateInfo &createInfo) noexcept :
+		m_createInfo {createInfo},
+		m_nextIndex {0},
+		m_openFailed {false},
+		m_mutex {},
+		m_condition {},
+		m_current {},
+		m_next {},
+		m_retired {},
+		m_files {},
+		m_maintenanceThread {}
+	{
+	#ifdef FLEX_POSIX
+		m_createInfo.segmentSize = std::max(m_createInfo.segmentSize, static_cast<std::size_t> (::sysconf(_SC_PAGESIZE)));
+
+		std::filesystem::path directory {m_createInfo.path.parent_path()};
+		if (directory.empty())
+			directory = ".";
+		const std::string prefix {m_createInfo.path.filename().string() + "."};
+		// the files of the previous runs count in the retention too
+		std::vector<std::pair<std::size_t, std::filesystem::path>> existingFiles {};
+		std::error_code error {};
+		for (const auto &entry : std::filesystem::directory_iterator(directory, error)) {
+			const std::string name {entry.path().filename().string()};
+			if (!name.starts_with(prefix))
+				continue;
+			const std::string_view suffix {std::string_view{name}.substr(prefix.size())};
+			std::size_t index {};
+			const auto [ptr, err] {std::from_chars(suffix.data(), suffix.data() + suffix.size(), index)};
+			if (err == std::errc{} && ptr == suffix.data() + suffix.size())
+				existingFiles.emplace_back(index, entry.path());
+		}
+		std::ranges::sort(existingFiles);
+		for (auto &[index, path] : existingFiles) {
+			m_nextIndex = index + 1;
+			m_files.push_back(std::move(path));
+		}
+
+		const std::filesystem::path path {this->makeSegmentPath(m_nextIndex++)};
+		m_current = this->openSegment(path);
+		if (!m_current)
+			return;
+		m_files.push_back(path);
+		removeFiles(this->popExpiredFiles());
+		m_current->deadline = std::chrono::steady_clock::now() + m_createInfo.rotationInterval;
+		m_maintenanceThread = std::jthread{[this](std::stop_token stopToken) {this->runMaintenance(stopToken);}};
+	#endif
+	}
+
+	RotatingFileSink::~RotatingFileSink() {
+		if (m_maintenanceThread.joinable()) {
+			m_maintenanceThread.request_stop();
+			m_maintenanceThread.join();
+		}
+
+		for (Segment &segment : m_retired)
+			this->closeSegment(segment);
+		removeFiles(this->popExpiredFiles());
+		if (m_current)
+			this->closeSegment(*m_current);
+		if (m_next) {
+			this->closeSegment(*m_next);
+			removeFiles({&m_next->path, 1});
+		}
+	}
+
+
+	auto RotatingFileSink::write(std::span<const std::string_view> chunks) noexcept -> void {
+		std::unique_lock lock {m_mutex};
+		if (!m_current)
+			return;
+
+		const std::size_t segmentSize {m_createInfo.segmentSize};
+		writeChunks(chunks, [this, &lock, segmentSize](std::string_view head, std::span<const std::string_view> tail) -> std::optional<std::size_t> {
+			// don't split a chunk across two files if it fits in a fresh segment
+			const std::size_t available {segmentSize - m_current->used};
+			const bool isFresh {m_current->used == m_current->prologueSize};
+			if (head.size() > available && ((head.size() <= segmentSize && !isFresh) || available == 0)) {
+				if (!this->rotate(lock))
+					return std::nullopt;
+				return 0;
+			}
+
+			std::size_t written {std::min(head.size(), available)};
+			std::memcpy(m_current->data + m_current->used, head.data(), written);
+			m_current->used += written;
+			if (written != head.size())
+				return written;
+			for (std::string_view chunk : tail) {
+				if (chunk.size() > segmentSize - m_current->used)
+					break;
+				std::memcpy(m_current->data + m_current->used, chunk.data(), chunk.size());
+				m_current->used += chunk.size();
+				written += chunk.size();
+			}
+			return written;
+		});
+	}
+
+	auto RotatingFileSink::flush() noexcept -> void {
+	#ifdef FLEX_POSIX
+		std::lock_guard _ {m_mutex};
+		if (m_current && m_current->used != 0)
+			::msync(m_current->data, m_current->used, MS_ASYNC);
+	#endif
+	}
+
+	auto RotatingFileSink::isValid() const noexcept -> bool {
+		std::lock_guard _ {m_mutex};
+		return m_current.has_value();
+	}
+
+
+	auto RotatingFileSink::makeSegmentPath(std::size_t index) const noexcept -> std::filesystem::path {
+		std::filesystem::path path {m_createInfo.path};
+		path += "." + std::to_string(index);
+		return path;
+	}
+
+	auto RotatingFileSink::openSegment([[maybe_unused]] const std::filesystem::path &path) noexcept -> std::optional<Segment> {
+	#ifdef FLEX_POSIX
+		const int fileDescriptor {::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)};
+		if (fileDescriptor < 0)
+			return std::nullopt;
+
+		const auto size {static_cast<off_t> (m_createInfo.segmentSize)};
+	#ifdef __linux__
+		const bool allocated {::fallocate(fileDescriptor, 0, 0, size) == 0 || ::ftruncate(fileDescriptor, size) == 0};
+	#else
+		const bool allocated {::ftruncate(fileDescriptor, size) == 0};
+	#endif
+		void *data {allocated
+			? ::mmap(nullptr, m_createInfo.segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0)
+			: MAP_FAILED
+		};
+		if (data == MAP_FAILED) {
+			::close(fileDescriptor);
+			std::error_code error {};
+			std::filesystem::remove(path, error);
+			return std::nullopt;
+		}
+
+		return Segment{
+			.path = path,
+			.fileDescriptor = fileDescriptor,
+			.data = static_cast<std::byte*> (data),
+			.used = 0,
+			.prologueSize = 0,
+			.deadline = {}
+		};
+	#else
+		return std::nullopt;
+	#endif
+	}
+
+	auto RotatingFileSink::closeSegment([[maybe_unused]] Segment &segment) noexcept -> void {
+	#ifdef FLEX_POSIX
+		::munmap(segment.data, m_createInfo.segmentSize);
+		::ftruncate(segment.fileDescriptor, static_cast<off_t> (segment.used));
+		::close(segment.fileDescriptor);
+	#endif
+	}
+
+	auto RotatingFileSink::popExpiredFiles() noexcept -> std::vector<std::filesystem::path> {
+		std::vector<std::filesystem::path> expiredFiles {};
+		while (m_createInfo.maxFilesCount != 0 && m_files.size() > m_createInfo.maxFilesCount) {
+			expiredFiles.push_back(std::move(m_files.front()));
+			m_files.pop_front();
+		}
+		return expiredFiles;
+	}
+
+	auto RotatingFileSink::rotate(std::unique_lock<std::mutex> &lock) noexcept -> bool {
+		// only waits if the maintenance thread is late on the preparation of the next segment. The
+		// lock is released while waiting, so another writer may rotate in the meantime
+		const std::byte *rotatedData {m_current->data};
+		m_condition.wait(lock, [this, rotatedData]() {
+			return m_next.has_value() || m_openFailed || m_current->data != rotatedData;
+		});
+		if (m_current->data != rotatedData)
+			return true;
+		if (!m_next) {
+			m_openFailed = false;
+			m_condition.notify_all();
+			return false;
+		}
+
+		m_retired.push_back(std::move(*m_current));
+		m_current = std::move(m_next);
+		m_next.reset();
+		m_files.push_back(m_current->path);
+		m_current->deadline = std::chrono::steady_clock::now() + m_createInfo.rotationInterval;
+		if (const std::string prologue {Sink::getStreamPrologue()}; prologue.size() <= m_createInfo.segmentSize) {
+			std::memcpy(m_current->data, prologue.data(), prologue.size());
+			m_current->used = prologue.size();
+			m_current->prologueSize = prologue.size();
+		}
+		m_condition.notify_all();
+		return true;
+	}
+
+	auto RotatingFileSink::runMaintenance(std::stop_token stopToken) noexcept -> void {
+		const bool rotatesOnTime {m_createInfo.rotationInterval.count() != 0};
+		std::unique_lock lock {m_mutex};
+		while (!stopToken.stop_requested()) {
+			if (!m_retired.empty()) {
+				std::vector<Segment> retired {std::move(m_retired)};
+				m_retired.clear();
+				const std::vector<std::filesystem::path> expiredFiles {this->popExpiredFiles()};
+				lock.unlock();
+				for (Segment &segment : retired)
+					this->closeSegment(segment);
+				removeFiles(expiredFiles);
+				lock.lock();
+				continue;
+			}
+
+			if (!m_next && !m_openFailed) {
+				const std::filesystem::path path {this->makeSegmentPath(m_nextIndex++)};
+				lock.unlock();
+				std::optional<Segment> segment {this->openSegment(path)};
+				lock.lock();
+
+				if (segment)
+					m_next = std::move(segment);
+				else
+					m_openFailed = true;
+				m_condition.notify_all();
+				continue;
+			}
+
+			const auto needsWork {[this]() {return !m_retired.empty() || (!m_next && !m_openFailed);}};
+			if (!rotatesOnTime) {
+				m_condition.wait(lock, stopToken, needsWork);
+				continue;
+			}
+
+			const auto deadline {m_current->deadline};
+			if (std::chrono::steady_clock::now() < deadline) {
+				m_condition.wait_until(lock, stopToken, deadline, needsWork);
+				continue;
+			}
+			// an empty segment isn't worth a file, it restarts its interval instead
+			if (m_current->used == m_current->prologueSize)
+				m_current->deadline = std::chrono::steady_clock::now() + m_createInfo.rotationInterval;
+			else if (m_next)
+				this->rotate(lock);
+			else
+				m_condition.wait(lock, stopToken, needsWork);
+		}
+	}
+
+} // namespace flex::logger
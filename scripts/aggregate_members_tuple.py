@@ -11,36 +11,55 @@ amount = int(sys.argv[2]) + 1
 content = "#pragma once\n\n"
 
 content += "#include <cstddef>\n"
-content += "#include <tuple>\n"
 content += "#include <type_traits>\n\n"
 
-content += "#include \"flex/reflection/aggregateMembersCount.hpp\"\n\n\n"
+content += "#include \"flex/reflection/aggregateMembersCount.hpp\"\n"
+content += "#include \"flex/reflection/aggregateMembersReferences.hpp\"\n\n\n"
 
 
 content += f"#define FLEX_REFLECTION_MAX_AGGREGATE_MEMBERS_COUNT {amount - 1}\n\n"
 
 content += "namespace flex::reflection {\n"
-content += "\ttemplate <flex::aggregate T>\n"
-content += "\tconstexpr auto makeAggregateMembersTuple(const T &value) {\n"
-content += "\t\tconstexpr std::size_t size {flex::reflection::aggregate_members_count_v<T>};\n"
+content += "\tnamespace __internals {\n"
+
+# one specialization per count, shared by const and non-const aggregates : an instantiation only
+# looks up its specialization instead of walking a chain of `if constexpr`, and the members are
+# bound into flat references instead of a `std::tuple`
+content += "\t\ttemplate <std::size_t COUNT>\n"
+content += "\t\tstruct aggregate_members_binding {\n"
+content += "\t\t\tstatic_assert(COUNT <= FLEX_REFLECTION_MAX_AGGREGATE_MEMBERS_COUNT,\n"
+content += "\t\t\t\t\"Too many members to reflect, raise FLEX_REFLECTION_MAX_MEMBERS_COUNT\"\n"
+content += "\t\t\t);\n"
+content += "\t\t};\n\n"
+
+content += "\t\ttemplate <>\n"
+content += "\t\tstruct aggregate_members_binding<0> {\n"
+content += "\t\t\ttemplate <typename T>\n"
+content += "\t\t\tstatic constexpr auto bind(T &) noexcept {return bindAggregateMembers();}\n"
+content += "\t\t};\n"
+
 for val in range(1, amount):
     args = ",".join([f"m{i}" for i in range(0, val)])
-    content += f"\t\tif constexpr (size == {val})" + " {\n"
-    content += f"\t\t\tconst auto &[{args}] {{value}};\n"
-    content += f"\t\t\treturn std::tie({args});\n"
-    content += "\t\t}\n"
-content += "\t}\n\n\n"
+    content += "\n\t\ttemplate <>\n"
+    content += f"\t\tstruct aggregate_members_binding<{val}>" + " {\n"
+    content += "\t\t\ttemplate <typename T>\n"
+    content += "\t\t\tstatic constexpr auto bind(T &value) noexcept {\n"
+    content += f"\t\t\t\tauto &[{args}] {{value}};\n"
+    content += f"\t\t\t\treturn bindAggregateMembers({args});\n"
+    content += "\t\t\t}\n"
+    content += "\t\t};\n"
+
+content += "\n\t} // namespace __internals\n\n\n"
 
 
 content += "\ttemplate <flex::aggregate T>\n"
-content += "\tconstexpr auto makeAggregateMembersTuple(T &value) {\n"
-content += "\t\tconstexpr std::size_t size {flex::reflection::aggregate_members_count_v<T>};\n"
-for val in range(1, amount):
-    args = ",".join([f"m{i}" for i in range(0, val)])
-    content += f"\t\tif constexpr (size == {val})" + " {\n"
-    content += f"\t\t\tauto &[{args}] {{value}};\n"
-    content += f"\t\t\treturn std::tie({args});\n"
-    content += "\t\t}\n"
+content += "\tconstexpr auto makeAggregateMembersReferences(const T &value) noexcept {\n"
+content += "\t\treturn __internals::aggregate_members_binding<flex::reflection::aggregate_members_count_v<T>>::bind(value);\n"
+content += "\t}\n\n"
+
+content += "\ttemplate <flex::aggregate T>\n"
+content += "\tconstexpr auto makeAggregateMembersReferences(T &value) noexcept {\n"
+content += "\t\treturn __internals::aggregate_members_binding<flex::reflection::aggregate_members_count_v<T>>::bind(value);\n"
 content += "\t}\n\n"
 
 content += "} // namespace flex::reflection"
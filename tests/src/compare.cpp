@@ -0,0 +1,141 @@
+#include <compare>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <flex/compare.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+namespace {
+	struct Position {
+		std::int32_t x;
+		std::int32_t y;
+	};
+
+	struct Player {
+		std::uint64_t id;
+		std::int32_t level;
+		std::int32_t health;
+		std::string name;
+		Position position;
+		float speed;
+		std::vector<std::string> items;
+		std::optional<std::uint32_t> guild;
+	};
+
+	// b is at offset 2, the sizes and alignments of the members alone would put it at 1
+	struct Aligned {
+		char a;
+		alignas(2) char b;
+		double d;
+	};
+
+	class Account {
+		public:
+			auto getBalance() const noexcept -> std::int64_t {return m_balance;}
+			auto setBalance(std::int64_t balance) noexcept -> void {m_balance = balance;}
+
+			std::string owner;
+
+			struct FlexMetadata {
+				static constexpr std::tuple MEMBERS {
+					&Account::owner,
+					std::tuple{"balance", &Account::getBalance, &Account::setBalance}
+				};
+			};
+
+		private:
+			std::int64_t m_balance {0};
+	};
+
+} // namespace
+
+// id, level and health are compared with a single memcmp
+static_assert(flex::__internals::members_segments<Player>::SEGMENTS[0].last == 3);
+static_assert(std::same_as<decltype(flex::compare(std::declval<Player> (), std::declval<Player> ())), std::partial_ordering>);
+static_assert(std::same_as<decltype(flex::compare(Position{}, Position{})), std::strong_ordering>);
+
+
+TEST_CASE("equality", "[compare]") {
+	const Player player {1, 10, 100, "alice", {3, -4}, 1.5f, {"sword"}, 7};
+	Player other {player};
+	REQUIRE(flex::equal(player, other));
+
+	other.health = 99;
+	REQUIRE(!flex::equal(player, other));
+	other = player;
+	other.items.push_back("shield");
+	REQUIRE(!flex::equal(player, other));
+	other = player;
+	other.speed = 1.5000001f;
+	REQUIRE(!flex::equal(player, other));
+
+	REQUIRE(flex::equal(0.0, -0.0));
+	REQUIRE(flex::equal(std::vector<Position> {{1, 2}}, std::vector<Position> {{1, 2}}));
+	REQUIRE(!flex::equal(std::vector<int> {1}, std::vector<int> {1, 2}));
+}
+
+
+TEST_CASE("ordering", "[compare]") {
+	REQUIRE((flex::compare(Position{1, 5}, Position{2, 0}) < 0));
+	REQUIRE((flex::compare(Position{-1, 5}, Position{1, 5}) < 0));
+	REQUIRE((flex::compare(Position{2, 5}, Position{2, 5}) == 0));
+	REQUIRE((flex::compare(Position{2, 6}, Position{2, 5}) > 0));
+
+	Player lhs {1, 10, 100, "alice", {3, -4}, 1.5f, {"sword"}, std::nullopt};
+	Player rhs {lhs};
+	REQUIRE((flex::compare(lhs, rhs) == 0));
+	rhs.name = "bob";
+	REQUIRE((flex::compare(lhs, rhs) < 0));
+	rhs.level = 9;
+	REQUIRE((flex::compare(lhs, rhs) > 0));
+	rhs = lhs;
+	rhs.guild = 0;
+	REQUIRE((flex::compare(lhs, rhs) < 0));
+}
+
+
+TEST_CASE("diff", "[compare]") {
+	const Player player {1, 10, 100, "alice", {3, -4}, 1.5f, {"sword"}, 7};
+	Player other {player};
+	REQUIRE(flex::diff(player, other).none());
+
+	other.health = 50;
+	other.name = "alicia";
+	other.guild.reset();
+	const auto changes {flex::diff(player, other)};
+	REQUIRE(changes.count() == 3);
+	REQUIRE(changes.test(flex::reflection_member_index_v<Player, "health">));
+	REQUIRE(changes.test(flex::reflection_member_index_v<Player, "name">));
+	REQUIRE(changes.test(flex::reflection_member_index_v<Player, "guild">));
+
+	Account account {};
+	account.owner = "carol";
+	Account richer {account};
+	richer.setBalance(100);
+	REQUIRE(!flex::equal(account, richer));
+	REQUIRE(flex::diff(account, richer).to_ulong() == 0b10);
+	REQUIRE((flex::compare(account, richer) < 0));
+}
+
+
+TEST_CASE("over-aligned members", "[compare]") {
+	Aligned lhs;
+	Aligned rhs;
+	std::memset(&lhs, 0x00, sizeof(lhs));
+	std::memset(&rhs, 0xff, sizeof(rhs));
+	lhs.a = rhs.a = 'a';
+	lhs.b = rhs.b = 5;
+	lhs.d = rhs.d = 0.5;
+	REQUIRE(flex::equal(lhs, rhs));
+	REQUIRE((flex::compare(lhs, rhs) == 0));
+	REQUIRE(flex::diff(lhs, rhs).none());
+
+	rhs.b = 6;
+	REQUIRE(!flex::equal(lhs, rhs));
+	REQUIRE((flex::compare(lhs, rhs) < 0));
+	REQUIRE(flex::diff(lhs, rhs).to_ulong() == 0b010);
+}
@@ -0,0 +1,63 @@
+#include <string>
+
+#include <flex/enumArray.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+namespace {
+	enum class State {
+		eIdle,
+		eRunning,
+		eStopped
+	};
+
+	enum class Code {
+		eOk = 0,
+		eNotFound = 44,
+		eFailed = 100
+	};
+
+} // namespace
+
+#ifndef __cpp_impl_reflection
+	FLEX_SET_MAX_ENUM_SIZE(Code, 128);
+#endif
+
+static_assert(flex::enum_index_v<State, State::eStopped> == 2);
+static_assert(flex::enum_index((State)3) == flex::enum_members_count_v<State>);
+static_assert(flex::enum_index(Code::eNotFound) == 1);
+static_assert(sizeof(flex::EnumArray<State, int>) == 3 * sizeof(int));
+
+
+TEST_CASE("indexing", "[enumArray]") {
+	flex::EnumArray<State, std::string> names {{State::eRunning, "running"}};
+	REQUIRE(names[State::eIdle].empty());
+	REQUIRE(names[State::eRunning] == "running");
+	names[State::eStopped] = "stopped";
+	REQUIRE(names.at(State::eStopped) == "stopped");
+	REQUIRE_THROWS_AS(names.at((State)7), std::out_of_range);
+
+	flex::EnumArray<Code, int> counters {0};
+	++counters[Code::eFailed];
+	++counters[Code::eFailed];
+	++counters[Code::eOk];
+	REQUIRE(counters[Code::eFailed] == 2);
+	REQUIRE(counters[Code::eNotFound] == 0);
+	REQUIRE(!counters.contains((Code)45));
+}
+
+
+TEST_CASE("iteration", "[enumArray]") {
+	flex::EnumArray<State, int> values {{State::eIdle, 1}, {State::eRunning, 2}, {State::eStopped, 3}};
+	int sum {0};
+	for (int value : values)
+		sum += value;
+	REQUIRE(sum == 6);
+
+	std::size_t index {0};
+	for (auto [key, value] : values.items()) {
+		REQUIRE(key == flex::EnumArray<State, int>::keyAt(index++));
+		value *= 10;
+	}
+	REQUIRE(values[State::eStopped] == 30);
+}
@@ -0,0 +1,46 @@
+#include <vector>
+
+#include <flex/enumSet.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+namespace {
+	enum class Permission {
+		eRead,
+		eWrite,
+		eExecute,
+		eDelete
+	};
+
+} // namespace
+
+
+TEST_CASE("insertion", "[enumSet]") {
+	flex::EnumSet<Permission> set {Permission::eWrite};
+	REQUIRE(set.insert(Permission::eRead));
+	REQUIRE(!set.insert(Permission::eRead));
+	REQUIRE(!set.insert((Permission)9));
+	REQUIRE(set.contains(Permission::eWrite));
+	REQUIRE(!set.contains(Permission::eExecute));
+	REQUIRE(set.size() == 2);
+
+	REQUIRE(set.erase(Permission::eWrite));
+	REQUIRE(!set.erase(Permission::eWrite));
+	REQUIRE(set.size() == 1);
+	set.clear();
+	REQUIRE(set.empty());
+}
+
+
+TEST_CASE("iteration and algebra", "[enumSet]") {
+	constexpr flex::EnumSet<Permission> all {flex::EnumSet<Permission>::all()};
+	static_assert(all.size() == 4);
+
+	const flex::EnumSet<Permission> set {Permission::eDelete, Permission::eRead};
+	REQUIRE(std::vector<Permission> (set.begin(), set.end()) == std::vector{Permission::eRead, Permission::eDelete});
+
+	const flex::EnumSet<Permission> others {all - set};
+	REQUIRE(std::vector<Permission> (others.begin(), others.end()) == std::vector{Permission::eWrite, Permission::eExecute});
+	REQUIRE((others | set) == all);
+	REQUIRE((others & set).empty());
+}
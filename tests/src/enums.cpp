@@ -18,7 +18,15 @@ enum class SomeBitfield {
 };
 
 
+enum class SparseEnum {
+	eFirst = 1,
+	eSecond = 40,
+	eThird = 100
+};
+
+
 #ifndef __cpp_impl_reflection
+	FLEX_SET_MAX_ENUM_SIZE(SparseEnum, 128);
 	FLEX_SET_MAX_ENUM_SIZE(SomeBitfield, 4);
 	FLEX_MAKE_ENUM_BITFLAG(SomeBitfield);
 #endif
@@ -41,3 +49,48 @@ TEST_CASE("macros", "[reflection]") {
 	REQUIRE(flex::toString(bitfield).value_or("<invalid>") == "eREAD | eEXEC");
 	REQUIRE(!flex::toString(flex::Bitfield<SomeBitfield> {}));
 }
+
+
+TEST_CASE("string conversions", "[reflection]") {
+	static_assert(flex::fromString<SomeEnum> ("eB") == SomeEnum::eB);
+	static_assert(flex::toString(SomeEnum::eC) == "eC");
+
+	REQUIRE(flex::fromString<SomeEnum> ("eA") == SomeEnum::eA);
+	REQUIRE(flex::fromString<SomeEnum> ("eC") == SomeEnum::eC);
+	REQUIRE(!flex::fromString<SomeEnum> ("eD"));
+	REQUIRE(!flex::fromString<SomeEnum> (""));
+
+	REQUIRE(flex::fromString<SomeBitfield> ("eWRITE") == SomeBitfield::eWRITE);
+	REQUIRE(!flex::toString((SomeBitfield)0b011));
+
+	REQUIRE(flex::toString(SparseEnum::eSecond).value_or("<invalid>") == "eSecond");
+	REQUIRE(flex::toString(SparseEnum::eThird).value_or("<invalid>") == "eThird");
+	REQUIRE(!flex::toString((SparseEnum)0));
+	REQUIRE(!flex::toString((SparseEnum)41));
+	REQUIRE(flex::fromString<SparseEnum> ("eFirst") == SparseEnum::eFirst);
+	REQUIRE(!flex::fromString<SparseEnum> ("efirst"));
+}
+
+
+enum class SignedEnum : std::int8_t {
+	eLow = -100,
+	eMinusOne = -1,
+	eZero = 0,
+	eHigh = 90
+};
+
+#ifndef __cpp_impl_reflection
+	FLEX_SET_ENUM_RANGE(SignedEnum, -128, 127);
+#endif
+
+
+TEST_CASE("ranges", "[reflection]") {
+	static_assert(flex::enum_members_count_v<SignedEnum> == 4);
+	static_assert(flex::enum_members_v<SignedEnum>[0].value == SignedEnum::eLow);
+
+	REQUIRE(flex::toString(SignedEnum::eLow).value_or("<invalid>") == "eLow");
+	REQUIRE(flex::toString(SignedEnum::eMinusOne).value_or("<invalid>") == "eMinusOne");
+	REQUIRE(flex::toString(SignedEnum::eHigh).value_or("<invalid>") == "eHigh");
+	REQUIRE(!flex::toString((SignedEnum)-2));
+	REQUIRE(flex::fromString<SignedEnum> ("eZero") == SignedEnum::eZero);
+}
@@ -0,0 +1,131 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <flex/hash.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+namespace {
+	struct Point {
+		std::int32_t x;
+		std::int32_t y;
+	};
+
+	struct Record {
+		std::uint64_t id;
+		std::uint32_t shard;
+		std::uint32_t region;
+		std::string name;
+		std::uint16_t flags;
+		double score;
+		std::optional<Point> origin;
+	};
+
+	// b is at offset 2, the sizes and alignments of the members alone would put it at 1
+	struct Aligned {
+		char a;
+		alignas(2) char b;
+		double d;
+	};
+
+	struct Renamed {
+		int value;
+		std::string label;
+
+		struct FlexMetadata {
+			static constexpr std::tuple MEMBERS {
+				std::tuple{"number", &Renamed::value},
+				&Renamed::label
+			};
+		};
+	};
+
+} // namespace
+
+static_assert(flex::__internals::is_trivially_comparable_v<Point>);
+static_assert(!flex::__internals::is_trivially_comparable_v<Record>);
+// id, shard and region are hashed as a single block of 16 bytes
+static_assert(flex::__internals::members_segments<Record>::COUNT == 5);
+static_assert(flex::__internals::members_segments<Record>::SEGMENTS[0].isBlock);
+static_assert(flex::__internals::members_segments<Record>::SEGMENTS[0].size == 16);
+
+
+TEST_CASE("hash of values", "[hash]") {
+	const flex::hash<Record> hasher {};
+	const Record record {42, 1, 7, "hello", 3, 0.5, Point{1, 2}};
+	Record copy {record};
+	REQUIRE(hasher(record) == hasher(copy));
+
+	copy.name = "hellp";
+	REQUIRE(hasher(record) != hasher(copy));
+	copy = record;
+	copy.region = 8;
+	REQUIRE(hasher(record) != hasher(copy));
+	copy = record;
+	copy.origin.reset();
+	REQUIRE(hasher(record) != hasher(copy));
+
+	REQUIRE(flex::hash<double> {} (0.0) == flex::hash<double> {} (-0.0));
+	REQUIRE(flex::hash<std::string> {} ("abc") == flex::hash<std::string_view> {} ("abc"));
+	REQUIRE(flex::hash<std::vector<std::string>> {} ({"ab", "c"}) != flex::hash<std::vector<std::string>> {} ({"a", "bc"}));
+	REQUIRE(flex::hash<Renamed> {} (Renamed{1, "a"}) != flex::hash<Renamed> {} (Renamed{2, "a"}));
+
+	std::unordered_set<Point, flex::hash<Point>, decltype([](const Point &lhs, const Point &rhs) {
+		return lhs.x == rhs.x && lhs.y == rhs.y;
+	})> points {};
+	for (std::int32_t i {0}; i < 100; ++i)
+		points.insert(Point{i % 10, i / 10});
+	points.insert(Point{3, 3});
+	REQUIRE(points.size() == 100);
+}
+
+
+TEST_CASE("hash of over-aligned members", "[hash]") {
+	const flex::hash<Aligned> hasher {};
+	Aligned lhs;
+	Aligned rhs;
+	std::memset(&lhs, 0x00, sizeof(lhs));
+	std::memset(&rhs, 0xff, sizeof(rhs));
+	lhs.a = rhs.a = 'a';
+	lhs.b = rhs.b = 5;
+	lhs.d = rhs.d = 0.5;
+	REQUIRE(hasher(lhs) == hasher(rhs));
+
+	rhs.b = 6;
+	REQUIRE(hasher(lhs) != hasher(rhs));
+}
+
+
+TEST_CASE("hash of bytes", "[hash]") {
+	std::array<std::byte, 200> bytes {};
+	for (std::size_t i {0}; i < bytes.size(); ++i)
+		bytes[i] = static_cast<std::byte> (i * 7);
+
+	std::unordered_set<std::uint64_t> hashes {};
+	for (std::size_t size {0}; size <= bytes.size(); ++size)
+		hashes.insert(flex::__internals::hashBytes(bytes.data(), size, 0));
+	REQUIRE(hashes.size() == bytes.size() + 1);
+	REQUIRE(flex::__internals::hashBytes(bytes.data(), 100, 0) != flex::__internals::hashBytes(bytes.data(), 100, 1));
+}
+
+
+TEST_CASE("hash batch", "[hash]") {
+	std::vector<Point> points {};
+	for (std::int32_t i {0}; i < 103; ++i)
+		points.push_back(Point{i, -i});
+
+	const auto hashes {flex::hash_batch(std::span<const Point> {points})};
+	REQUIRE(hashes.size() == points.size());
+	for (std::size_t i {0}; i < points.size(); ++i)
+		REQUIRE(hashes[i] == flex::hash<Point> {} (points[i]));
+
+	const std::vector<std::string> names {"a", "b", "c"};
+	std::array<std::size_t, 2> output {};
+	REQUIRE(flex::hash_batch(std::span<const std::string> {names}, std::span{output}) == 2);
+	REQUIRE(output[1] == flex::hash<std::string> {} ("b"));
+}
@@ -0,0 +1,133 @@
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <flex/json.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+namespace {
+	enum class Mode {
+		eFast,
+		eSafe
+	};
+
+	struct Endpoint {
+		std::string host;
+		std::uint16_t port;
+	};
+
+	struct Config {
+		std::string name;
+		Mode mode;
+		bool enabled;
+		double ratio;
+		std::int64_t limit;
+		std::optional<std::string> comment;
+		std::vector<Endpoint> endpoints;
+		std::map<std::string, int> weights;
+		std::set<int> ids;
+		std::pair<int, std::string> pair;
+	};
+
+	struct Renamed {
+		int value;
+		bool flag;
+
+		struct FlexMetadata {
+			static constexpr std::tuple MEMBERS {
+				std::tuple{"the \"value\"", &Renamed::value},
+				&Renamed::flag
+			};
+		};
+	};
+
+} // namespace
+
+static_assert(flex::json::__internals::ObjectKeys<Endpoint>::get(0) == "{\"host\":");
+static_assert(flex::json::__internals::ObjectKeys<Endpoint>::get(1) == ",\"port\":");
+static_assert(flex::json::__internals::ObjectKeys<Renamed>::get(0) == R"({"the \"value\"":)");
+static_assert(flex::json::__internals::MembersPerfectHash<Config>::find("weights") == 7);
+static_assert(flex::json::__internals::MembersPerfectHash<Config>::find("weight") == 10);
+
+
+TEST_CASE("write", "[json]") {
+	const Config config {
+		.name = "main \"server\"\n",
+		.mode = Mode::eSafe,
+		.enabled = true,
+		.ratio = 0.25,
+		.limit = -12,
+		.comment = std::nullopt,
+		.endpoints = {{"localhost", 8080}, {"example.org", 443}},
+		.weights = {{"a", 1}, {"b", 2}},
+		.ids = {3, 1},
+		.pair = {1, "one"}
+	};
+
+	REQUIRE(flex::json::write(config) == R"({"name":"main \"server\"\n","mode":"eSafe","enabled":true,"ratio":0.25,)"
+		R"("limit":-12,"comment":null,"endpoints":[{"host":"localhost","port":8080},{"host":"example.org","port":443}],)"
+		R"("weights":{"a":1,"b":2},"ids":[1,3],"pair":[1,"one"]})"
+	);
+	REQUIRE(flex::json::write(Renamed{4, true}) == R"({"the \"value\"":4,"flag":true})");
+	REQUIRE(flex::json::write(std::string{"\x01"}) == R"("\u0001")");
+}
+
+
+TEST_CASE("read", "[json]") {
+	const auto config {flex::json::read<Config> (R"(
+		{
+			"unknown": {"nested": [1, 2.5e3, "x", null, true]},
+			"name": "café 😀 \"q\"",
+			"mode": "eFast",
+			"enabled": false,
+			"ratio": -1.5e2,
+			"limit": 9007199254740993,
+			"comment": "present",
+			"endpoints": [{"port": 22, "host": "a"}, {"host": "b"}],
+			"weights": {"x": -1},
+			"ids": [5, 5, 4],
+			"pair": [2, "two"]
+		}
+	)")};
+	REQUIRE(config.has_value());
+	REQUIRE(config->name == "caf\xc3\xa9 \xf0\x9f\x98\x80 \"q\"");
+	REQUIRE(config->mode == Mode::eFast);
+	REQUIRE(!config->enabled);
+	REQUIRE(config->ratio == -150.0);
+	REQUIRE(config->limit == 9007199254740993);
+	REQUIRE(config->comment == "present");
+	REQUIRE(config->endpoints.size() == 2);
+	REQUIRE(config->endpoints[0].host == "a");
+	REQUIRE(config->endpoints[0].port == 22);
+	REQUIRE(config->endpoints[1].port == 0);
+	REQUIRE(config->weights == std::map<std::string, int> {{"x", -1}});
+	REQUIRE(config->ids == std::set<int> {4, 5});
+	REQUIRE(config->pair == std::pair<int, std::string> {2, "two"});
+
+	const auto roundTrip {flex::json::read<Config> (flex::json::write(*config))};
+	REQUIRE(roundTrip.has_value());
+	REQUIRE(flex::json::write(*roundTrip) == flex::json::write(*config));
+
+	REQUIRE(flex::json::read<Renamed> (R"({"the \"value\"": 7})")->value == 7);
+}
+
+
+TEST_CASE("read errors", "[json]") {
+	const auto expectError {[](std::string_view input, flex::json::ErrorCode code, std::size_t position) {
+		const auto result {flex::json::read<Endpoint> (input)};
+		REQUIRE(!result.has_value());
+		REQUIRE(result.error().code == code);
+		REQUIRE(result.error().position == position);
+	}};
+
+	expectError(R"({"host": "a", "port": 1.5})", flex::json::ErrorCode::eInvalidNumber, 23);
+	expectError(R"({"host": "a", "port": 70000})", flex::json::ErrorCode::eInvalidNumber, 22);
+	expectError(R"({"host": "a")", flex::json::ErrorCode::eUnexpectedEnd, 12);
+	expectError(R"({"host": "a"} x)", flex::json::ErrorCode::eTrailingCharacters, 14);
+	expectError(R"({"host": "\q"})", flex::json::ErrorCode::eInvalidString, 11);
+	expectError(R"({"host" "a"})", flex::json::ErrorCode::eUnexpectedCharacter, 8);
+	REQUIRE(flex::json::read<Mode> (R"("eOther")").error().code == flex::json::ErrorCode::eInvalidEnum);
+}
@@ -0,0 +1,107 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <flex/reflection/layout.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+namespace {
+	struct Sparse {
+		std::uint8_t flag;
+		std::uint64_t id;
+		std::uint16_t kind;
+		std::uint32_t count;
+		std::uint8_t level;
+	};
+
+	struct Dense {
+		std::uint64_t id;
+		std::uint32_t count;
+		std::uint16_t kind;
+		std::uint8_t flag;
+		std::uint8_t level;
+	};
+
+	struct WithString {
+		bool enabled;
+		std::string name;
+		double ratio;
+	};
+
+	struct Aligned {
+		char a;
+		alignas(2) char b;
+		double d;
+	};
+
+	enum class Kind : std::uint8_t {
+		eNone,
+		eSome
+	};
+
+	struct Nested {
+		bool enabled;
+		Sparse sparse;
+		Kind kind;
+		float ratio;
+	};
+
+	struct Base {
+		int x;
+	};
+
+	struct Derived : Base {
+		int y;
+	};
+
+	struct NotStandardLayout {
+		Derived derived;
+		int z;
+	};
+
+} // namespace
+
+
+static_assert(flex::reflection_member_offsets_v<Sparse>[0] == offsetof(Sparse, flag));
+static_assert(flex::reflection_member_offsets_v<Sparse>[1] == offsetof(Sparse, id));
+static_assert(flex::reflection_member_offsets_v<Sparse>[2] == offsetof(Sparse, kind));
+static_assert(flex::reflection_member_offsets_v<Sparse>[3] == offsetof(Sparse, count));
+static_assert(flex::reflection_member_offsets_v<Sparse>[4] == offsetof(Sparse, level));
+static_assert(flex::reflection_member_offsets_v<Aligned>[1] == offsetof(Aligned, b));
+static_assert(flex::reflection_member_offsets_v<Aligned>[2] == offsetof(Aligned, d));
+static_assert(flex::reflection_member_offsets_v<Nested>[1] == offsetof(Nested, sparse));
+static_assert(flex::reflection_member_offsets_v<Nested>[2] == offsetof(Nested, kind));
+static_assert(flex::reflection_member_offsets_v<Nested>[3] == offsetof(Nested, ratio));
+// the offset of `name` can't be measured, and a guessed one isn't published
+static_assert(!flex::layout_reflectable<WithString>);
+static_assert(!flex::layout_reflectable<NotStandardLayout>);
+
+static_assert(flex::is_reflection_layout_optimal_v<Dense>);
+static_assert(!flex::is_reflection_layout_optimal_v<Sparse>);
+static_assert(flex::reflection_layout_v<Sparse>.suggestedSize == sizeof(Dense));
+
+
+TEST_CASE("layout report", "[layout]") {
+	constexpr auto layout {flex::reflection_layout_v<Sparse>};
+	REQUIRE(layout.size == sizeof(Sparse));
+	REQUIRE(layout.alignment == alignof(Sparse));
+	REQUIRE(layout.members[0].name == "flag");
+	REQUIRE(layout.members[0].padding == 7);
+	REQUIRE(layout.members[2].size == 2);
+	REQUIRE(layout.members[2].padding == 2);
+	REQUIRE(layout.members[4].padding == sizeof(Sparse) - offsetof(Sparse, level) - 1);
+	REQUIRE(layout.paddingBytes == sizeof(Sparse) - 16);
+	REQUIRE(layout.suggestedOrder == std::array<std::size_t, 5> {1, 3, 2, 0, 4});
+
+	constexpr auto aligned {flex::reflection_layout_v<Aligned>};
+	REQUIRE(aligned.members[0].padding == 1);
+	REQUIRE(aligned.members[1].padding == 5);
+	REQUIRE(aligned.paddingBytes == 6);
+	REQUIRE(aligned.suggestedOrder == std::array<std::size_t, 3> {0, 1, 2});
+	REQUIRE(aligned.suggestedSize == sizeof(Aligned));
+
+	constexpr auto dense {flex::reflection_layout_v<Dense>};
+	REQUIRE(dense.paddingBytes == 0);
+	REQUIRE(dense.suggestedOrder == std::array<std::size_t, 5> {0, 1, 2, 3, 4});
+}
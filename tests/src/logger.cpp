@@ -0,0 +1,657 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <flex/logger.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#ifdef FLEX_POSIX
+	#include <sys/wait.h>
+	#include <unistd.h>
+#endif
+
+
+static auto countLines(const std::string &text) noexcept -> std::size_t {
+	return static_cast<std::size_t> (std::ranges::count(text, '\n'));
+}
+
+
+TEST_CASE("async", "[logger]") {
+	std::ostringstream stream {};
+	flex::Logger::setOutputStream(stream);
+	flex::Logger::setMinLevel(flex::LogLevel::eInfo);
+
+	constexpr std::size_t THREADS_COUNT {4};
+	constexpr std::size_t LOGS_PER_THREAD {5000};
+	const auto logFromThreads {[]() {
+		std::vector<std::jthread> threads {};
+		for (std::size_t i {0}; i < THREADS_COUNT; ++i) {
+			threads.emplace_back([]() {
+				for (std::size_t j {0}; j < LOGS_PER_THREAD; ++j)
+					flex::Logger::info("record {}", j);
+			});
+		}
+	}};
+
+	SECTION("block") {
+		REQUIRE(flex::Logger::enableAsync(64, flex::LogOverflowPolicy::eBlock));
+		logFromThreads();
+		flex::Logger::flush();
+		REQUIRE(countLines(stream.str()) == THREADS_COUNT * LOGS_PER_THREAD);
+		REQUIRE(flex::Logger::getDroppedRecordsCount() == 0);
+	}
+
+	SECTION("drop newest") {
+		REQUIRE(flex::Logger::enableAsync(64, flex::LogOverflowPolicy::eDropNewest));
+		logFromThreads();
+		flex::Logger::flush();
+		REQUIRE(countLines(stream.str()) + flex::Logger::getDroppedRecordsCount() == THREADS_COUNT * LOGS_PER_THREAD);
+	}
+
+	SECTION("drop oldest") {
+		REQUIRE(flex::Logger::enableAsync(64, flex::LogOverflowPolicy::eDropOldest));
+		logFromThreads();
+		flex::Logger::flush();
+		REQUIRE(countLines(stream.str()) + flex::Logger::getDroppedRecordsCount() == THREADS_COUNT * LOGS_PER_THREAD);
+	}
+
+	flex::Logger::disableAsync();
+	REQUIRE(!flex::Logger::isAsync());
+	flex::Logger::setOutputStream(std::cout, true);
+}
+
+
+TEST_CASE("async flush", "[logger]") {
+	flex::Logger::setFormatString("{0}");
+	flex::Logger::setMinLevel(flex::LogLevel::eInfo);
+	const auto sink {std::make_shared<flex::logger::MemoryRingSink> (4096)};
+	flex::Logger::setSinks({sink});
+	REQUIRE(flex::Logger::enableAsync(16, flex::LogOverflowPolicy::eBlock, 4));
+
+	// each record must have reached the sink once the flush that follows it returns
+	std::atomic<std::size_t> missingRecords {0};
+	{
+		std::vector<std::jthread> threads {};
+		for (std::size_t i {0}; i < 4; ++i) {
+			threads.emplace_back([i, &sink, &missingRecords]() {
+				for (std::size_t j {0}; j < 200; ++j) {
+					const std::string record {std::format("thread {} record {}", i, j)};
+					flex::Logger::info("{}", record);
+					flex::Logger::flush();
+					const std::vector<std::string> lines {sink->getLines()};
+					if (std::ranges::find(lines, record) == lines.end())
+						++missingRecords;
+				}
+			});
+		}
+	}
+	REQUIRE(missingRecords == 0);
+
+	flex::Logger::disableAsync();
+	flex::Logger::setFormatString("{3}[{1}] > {0}{4}");
+	flex::Logger::setOutputStream(std::cout, true);
+}
+
+
+namespace {
+	enum class Color {
+		eRed,
+		eGreen
+	};
+
+	struct Size {
+		float width;
+		float height;
+	};
+
+	struct Label {
+		std::string_view text;
+		int line;
+	};
+
+	/*
+	 * @return Whether the span could be logged, not every standard library formats ranges yet
+	 * */
+	template <typename Span>
+	auto logStackSpan() -> bool {
+		if constexpr (std::formattable<Span, char>) {
+			int buffer[] {1, 2, 3};
+			flex::Logger::info("{}", Span{buffer});
+			// the writer thread is still asleep, a deferred span would see these values. Volatile so
+			// that the stores to a buffer about to die aren't optimized out
+			for (int &value : buffer)
+				*static_cast<volatile int*> (&value) = -1;
+			return true;
+		}
+		else
+			return false;
+	}
+
+} // namespace
+
+template <>
+struct flex::logger::is_deferrable_pod<Size> : std::true_type {};
+
+static_assert(flex::logger::deferrable_argument<int>);
+static_assert(flex::logger::deferrable_argument<const double&>);
+static_assert(flex::logger::deferrable_argument<Color>);
+static_assert(flex::logger::deferrable_argument<const char*>);
+static_assert(flex::logger::deferrable_argument<std::string>);
+static_assert(flex::logger::deferrable_argument<Size>);
+static_assert(!flex::logger::deferrable_argument<std::span<const int>>);
+static_assert(!flex::logger::deferrable_argument<std::reference_wrapper<int>>);
+static_assert(!flex::logger::deferrable_argument<std::u8string_view>);
+static_assert(!flex::logger::deferrable_argument<std::wstring_view>);
+static_assert(!flex::logger::deferrable_argument<std::vector<int>::const_iterator>);
+static_assert(!flex::logger::deferrable_argument<const void*>);
+static_assert(!flex::logger::deferrable_argument<Label>);
+
+
+TEST_CASE("deferred", "[logger]") {
+	std::ostringstream stream {};
+	flex::Logger::setOutputStream(stream);
+	flex::Logger::setFormatString("{0}");
+	flex::Logger::setMinLevel(flex::LogLevel::eInfo);
+	REQUIRE(flex::Logger::enableAsync());
+	flex::Logger::setDeferredFormatting(true);
+
+	const std::string name {"Albert"};
+	flex::Logger::info("{} is {} years old, {:.1f}m tall, {}", name, 76, 1.75, "deferred");
+	flex::Logger::flush();
+	REQUIRE(stream.str() == "Albert is 76 years old, 1.8m tall, deferred\n");
+
+	// formatted before the buffer goes out of scope
+	stream.str("");
+	if (logStackSpan<std::span<const int>> ()) {
+		flex::Logger::flush();
+		REQUIRE(stream.str() == "[1, 2, 3]\n");
+	}
+
+	stream.str("");
+	flex::Logger::info("{} {}", Size{1.5f, 2.f}, Label{"label", 3});
+	flex::Logger::flush();
+	REQUIRE(stream.str() == "{width: 1.5, height: 2} {text: \"label\", line: 3}\n");
+
+	flex::Logger::setDeferredFormatting(false);
+	flex::Logger::disableAsync();
+	flex::Logger::setFormatString("{3}[{1}] > {0}{4}");
+	flex::Logger::setOutputStream(std::cout, true);
+}
+
+
+TEST_CASE("call sites", "[logger]") {
+	std::ostringstream stream {};
+	flex::Logger::setOutputStream(stream);
+	flex::Logger::setFormatString("{2}: {0}");
+	flex::Logger::setMinLevel(flex::LogLevel::eWarning);
+
+	std::size_t evaluationsCount {0};
+	const auto evaluate {[&evaluationsCount]() {return ++evaluationsCount;}};
+
+	FLEX_LOG_INFO("evaluated {} times", evaluate());
+	REQUIRE(evaluationsCount == 0);
+	REQUIRE(stream.str().empty());
+
+	FLEX_LOG_ERROR("evaluated {} times", evaluate());
+	REQUIRE(evaluationsCount == 1);
+	REQUIRE(stream.str().find(__FILE__) != std::string::npos);
+	REQUIRE(stream.str().ends_with(": evaluated 1 times\n"));
+
+	stream.str("");
+	flex::Logger::setCallSiteFilter([](const flex::LogCallSite &callSite) {return callSite.level != flex::LogLevel::eError;});
+	FLEX_LOG_ERROR("filtered");
+	REQUIRE(stream.str().empty());
+
+	flex::Logger::setCallSiteFilter({});
+	flex::Logger::setMinLevel(flex::LogLevel::eInfo);
+	flex::Logger::setFormatString("{3}[{1}] > {0}{4}");
+	flex::Logger::setOutputStream(std::cout, true);
+}
+
+
+TEST_CASE("thread buffering", "[logger]") {
+	std::ostringstream stream {};
+	flex::Logger::setOutputStream(stream);
+	flex::Logger::setMinLevel(flex::LogLevel::eInfo);
+	flex::Logger::setThreadBuffering(true, 1024 * 1024);
+
+	flex::Logger::info("buffered");
+	REQUIRE(stream.str().empty());
+
+	{
+		std::vector<std::jthread> threads {};
+		for (std::size_t i {0}; i < 4; ++i)
+			threads.emplace_back([]() {flex::Logger::info("from thread");});
+	}
+	// exited threads write their buffer on their own
+	REQUIRE(countLines(stream.str()) == 4);
+
+	flex::Logger::flush();
+	REQUIRE(countLines(stream.str()) == 5);
+
+	flex::Logger::setThreadBuffering(false);
+	flex::Logger::setOutputStream(std::cout, true);
+}
+
+
+TEST_CASE("sinks", "[logger]") {
+	flex::Logger::setFormatString("{0}");
+	flex::Logger::setMinLevel(flex::LogLevel::eInfo);
+
+	const auto first {std::make_shared<flex::logger::MemoryRingSink> (2)};
+	const auto second {std::make_shared<flex::logger::MemoryRingSink> (8)};
+	flex::Logger::setSinks({first});
+	flex::Logger::addSink(second);
+
+	for (std::size_t i {0}; i < 3; ++i)
+		flex::Logger::info("record {}", i);
+	REQUIRE(first->getLines() == std::vector<std::string> {"record 1", "record 2"});
+	REQUIRE(second->getLines().size() == 3);
+
+	flex::Logger::removeSink(first);
+	flex::Logger::info("only second");
+	REQUIRE(first->getLines().back() == "record 2");
+	REQUIRE(second->getLines().back() == "only second");
+
+	flex::Logger::setFormatString("{3}[{1}] > {0}{4}");
+	flex::Logger::setOutputStream(std::cout, true);
+}
+
+
+#ifdef FLEX_POSIX
+namespace {
+	/*
+	 * @brief The indices and contents of the files `<path>.<index>`, ordered by index
+	 * */
+	auto readRotatedFiles(const std::filesystem::path &path) -> std::vector<std::pair<std::size_t, std::string>> {
+		std::vector<std::pair<std::size_t, std::string>> files {};
+		const std::string prefix {path.filename().string() + "."};
+		for (const auto &entry : std::filesystem::directory_iterator(path.parent_path())) {
+			const std::string name {entry.path().filename().string()};
+			if (!name.starts_with(prefix))
+				continue;
+			std::ifstream file {entry.path(), std::ios::binary};
+			files.emplace_back(std::stoull(name.substr(prefix.size())), std::string{std::istreambuf_iterator<char> {file}, {}});
+		}
+		std::ranges::sort(files);
+		return files;
+	}
+
+	class TemporaryDirectory final {
+		public:
+			TemporaryDirectory(std::string_view name) :
+				m_path {std::filesystem::temp_directory_path() / name}
+			{
+				std::filesystem::remove_all(m_path);
+				std::filesystem::create_directories(m_path);
+			}
+			~TemporaryDirectory() {
+				std::error_code error {};
+				std::filesystem::remove_all(m_path, error);
+			}
+
+			auto getPath() const noexcept -> const std::filesystem::path& {return m_path;}
+
+		private:
+			std::filesystem::path m_path;
+	};
+
+} // namespace
+
+
+TEST_CASE("rotating file sink", "[logger]") {
+	const TemporaryDirectory directory {"flex_rotating_file_sink"};
+	const std::filesystem::path path {directory.getPath() / "log"};
+	const std::string record (1000, 'x');
+	const std::string chunk {record + '\n'};
+
+	SECTION("size") {
+		{
+			flex::logger::RotatingFileSink sink {{.path = path, .segmentSize = 4096}};
+			REQUIRE(sink.isValid());
+			for (std::size_t i {0}; i < 10; ++i) {
+				const std::string_view view {chunk};
+				sink.write({&view, 1});
+			}
+		}
+
+		// 4 records of 1001 bytes per segment, none of them split
+		const auto files {readRotatedFiles(path)};
+		REQUIRE(files.size() == 3);
+		std::string content {};
+		for (const auto &[index, fileContent] : files) {
+			REQUIRE(fileContent.size() <= 4096);
+			REQUIRE(fileContent.size() % (record.size() + 1) == 0);
+			content += fileContent;
+		}
+		REQUIRE(content.size() == 10 * (record.size() + 1));
+	}
+
+	SECTION("time") {
+		{
+			flex::logger::RotatingFileSink sink {{.path = path, .segmentSize = 4096, .rotationInterval = std::chrono::seconds{1}}};
+			REQUIRE(sink.isValid());
+			const std::string_view first {"first\n"};
+			sink.write({&first, 1});
+			// rotated by the background thread, without waiting for the next write
+			std::this_thread::sleep_for(std::chrono::milliseconds{1500});
+			REQUIRE(readRotatedFiles(path).front().second == "first\n");
+			const std::string_view second {"second\n"};
+			sink.write({&second, 1});
+		}
+
+		const auto files {readRotatedFiles(path)};
+		REQUIRE(files.size() >= 2);
+		REQUIRE(files.front().second == "first\n");
+		REQUIRE(files[1].second == "second\n");
+	}
+
+	SECTION("retention") {
+		for (std::size_t i {0}; i < 5; ++i)
+			std::ofstream{path.string() + "." + std::to_string(i)} << "previous run " << i << '\n';
+
+		{
+			flex::logger::RotatingFileSink sink {{.path = path, .segmentSize = 4096, .maxFilesCount = 3}};
+			REQUIRE(sink.isValid());
+			// the files of the previous run are expired as soon as the sink starts
+			const auto files {readRotatedFiles(path)};
+			REQUIRE(files.size() == 3);
+			REQUIRE(files.front().first == 3);
+			REQUIRE(files.back().first == 5);
+
+			// 5 segments, from 5 to 9
+			for (std::size_t i {0}; i < 20; ++i) {
+				const std::string_view view {chunk};
+				sink.write({&view, 1});
+			}
+		}
+
+		const auto files {readRotatedFiles(path)};
+		REQUIRE(files.size() == 3);
+		REQUIRE(files.front().first == 7);
+		REQUIRE(files.back().first == 9);
+	}
+}
+
+
+TEST_CASE("file descriptor sink", "[logger]") {
+	int pipeEnds[2] {};
+	REQUIRE(::pipe(pipeEnds) == 0);
+	{
+		flex::logger::FileDescriptorSink sink {pipeEnds[1]};
+		const std::vector<std::string_view> chunks {"first ", "", "record\n", "second record\n"};
+		sink.write(chunks);
+	}
+	::close(pipeEnds[1]);
+
+	std::string content {};
+	char buffer[64] {};
+	for (ssize_t size {}; (size = ::read(pipeEnds[0], buffer, sizeof(buffer))) > 0;)
+		content.append(buffer, static_cast<std::size_t> (size));
+	::close(pipeEnds[0]);
+	REQUIRE(content == "first record\nsecond record\n");
+}
+
+
+TEST_CASE("exit while async", "[logger]") {
+	constexpr std::size_t RECORDS_COUNT {10000};
+	int pipeEnds[2] {};
+	REQUIRE(::pipe(pipeEnds) == 0);
+
+	const pid_t child {::fork()};
+	REQUIRE(child >= 0);
+	if (child == 0) {
+		::close(pipeEnds[0]);
+		flex::Logger::setFormatString("{0}");
+		flex::Logger::setMinLevel(flex::LogLevel::eInfo);
+		flex::Logger::setOutputFileDescriptor(pipeEnds[1]);
+		if (!flex::Logger::enableAsync(RECORDS_COUNT))
+			::_exit(1);
+		for (std::size_t i {0}; i < RECORDS_COUNT; ++i)
+			flex::Logger::info("record {}", i);
+		// the records still queued are written by the destruction of the statics
+		std::exit(0);
+	}
+
+	::close(pipeEnds[1]);
+	std::string content {};
+	char buffer[4096] {};
+	for (ssize_t size {}; (size = ::read(pipeEnds[0], buffer, sizeof(buffer))) > 0;)
+		content.append(buffer, static_cast<std::size_t> (size));
+	::close(pipeEnds[0]);
+
+	int status {};
+	REQUIRE(::waitpid(child, &status, 0) == child);
+	REQUIRE(WIFEXITED(status));
+	REQUIRE(WEXITSTATUS(status) == 0);
+	REQUIRE(countLines(content) == RECORDS_COUNT);
+}
+#endif
+
+
+namespace {
+	struct Point {
+		int x;
+		double y;
+	};
+
+	struct Shape {
+		std::string name;
+		Point origin;
+	};
+
+} // namespace
+
+TEST_CASE("binary format", "[logger]") {
+	std::ostringstream stream {};
+	flex::Logger::setOutputStream(stream);
+	flex::Logger::setMinLevel(flex::LogLevel::eInfo);
+	flex::Logger::setBinaryFormat(true);
+
+	for (int i {0}; i < 2; ++i)
+		FLEX_LOG_INFO("{} {:.1f} {}", Shape{"square", {i, 2.5}}, 1.25, i);
+	flex::Logger::warning("without call site {}", "value");
+	flex::Logger::setBinaryFormat(false);
+
+	const std::string data {stream.str()};
+	REQUIRE(data.starts_with(static_cast<char> (flex::logger::binary::ChunkKind::eHeader)));
+
+	SECTION("text") {
+		flex::logger::binary::Decoder decoder {flex::logger::binary::DecodeOutputFormat::eText};
+		std::string output {};
+		REQUIRE(decoder.decode(std::as_bytes(std::span{data}), output) == flex::logger::binary::DecodeResult::eSuccess);
+		REQUIRE(countLines(output) == 3);
+		REQUIRE(output.find(__FILE__) != std::string::npos);
+		REQUIRE(output.find("> {name: \"square\", origin: {x: 1, y: 2.5}} 1.2 1\n") != std::string::npos);
+		REQUIRE(output.ends_with("[warning] > without call site value\n"));
+	}
+
+	SECTION("json") {
+		flex::logger::binary::Decoder decoder {flex::logger::binary::DecodeOutputFormat::eJson};
+		std::string output {};
+		REQUIRE(decoder.decode(std::as_bytes(std::span{data}), output) == flex::logger::binary::DecodeResult::eSuccess);
+		REQUIRE(output.find(R"("arguments":[{"name":"square","origin":{"x":0,"y":2.5}},1.25,0])") != std::string::npos);
+	}
+
+	SECTION("truncated") {
+		flex::logger::binary::Decoder decoder {flex::logger::binary::DecodeOutputFormat::eText};
+		std::string output {};
+		const auto bytes {std::as_bytes(std::span{data})};
+		REQUIRE(decoder.decode(bytes.first(bytes.size() - 1), output) == flex::logger::binary::DecodeResult::eTruncated);
+		REQUIRE(countLines(output) == 2);
+	}
+
+	flex::Logger::setOutputStream(std::cout, true);
+}
+
+
+TEST_CASE("binary lists", "[logger]") {
+	// encoded without going through a format string, which would need a formatter for the ranges
+	std::atomic<std::uint64_t> streamGeneration {0};
+	flex::logger::binary::Encoder encoder {1};
+	encoder.defineStream(streamGeneration);
+	encoder.beginRecord(0, static_cast<std::uint8_t> (flex::LogLevel::eInfo), 0, "{} {}", 2);
+	encoder.encode(std::vector<int> {1, 2});
+	encoder.encode(std::vector<std::vector<int>> {{3}, {}});
+	const std::string data {encoder.takeChunk()};
+
+	flex::logger::binary::Decoder decoder {flex::logger::binary::DecodeOutputFormat::eText};
+	std::string output {};
+	REQUIRE(decoder.decode(std::as_bytes(std::span{data}), output) == flex::logger::binary::DecodeResult::eSuccess);
+	REQUIRE(output.ends_with("> [1, 2] [[3], []]\n"));
+}
+
+
+namespace {
+	auto logFromSharedCallSite(int value) -> void {
+		FLEX_LOG_INFO("shared call site {}", value);
+	}
+
+} // namespace
+
+TEST_CASE("binary descriptions", "[logger]") {
+	flex::Logger::setMinLevel(flex::LogLevel::eInfo);
+
+	SECTION("thread buffering") {
+		std::ostringstream stream {};
+		flex::Logger::setOutputStream(stream);
+		flex::Logger::setBinaryFormat(true);
+		flex::Logger::setThreadBuffering(true, 1024 * 1024);
+
+		// the description of the call site must not wait in the buffer of this thread while
+		// another thread writes a record using it
+		logFromSharedCallSite(0);
+		std::jthread{[]() {logFromSharedCallSite(1);}}.join();
+		const std::string data {stream.str()};
+		flex::Logger::setThreadBuffering(false);
+		flex::Logger::setBinaryFormat(false);
+
+		flex::logger::binary::Decoder decoder {flex::logger::binary::DecodeOutputFormat::eText};
+		std::string output {};
+		REQUIRE(decoder.decode(std::as_bytes(std::span{data}), output) == flex::logger::binary::DecodeResult::eSuccess);
+		REQUIRE(countLines(output) == 2);
+		REQUIRE(output.find("<unknown call site") == std::string::npos);
+	}
+
+#ifdef FLEX_POSIX
+	SECTION("rotation") {
+		const TemporaryDirectory directory {"flex_binary_rotation"};
+		const std::filesystem::path path {directory.getPath() / "log"};
+		flex::Logger::setSinks({std::make_shared<flex::logger::RotatingFileSink> (flex::logger::RotatingFileSink::CreateInfo{
+			.path = path,
+			.segmentSize = 4096
+		})});
+		flex::Logger::setBinaryFormat(true);
+		for (int i {0}; i < 1000; ++i)
+			logFromSharedCallSite(i);
+		flex::Logger::setBinaryFormat(false);
+		flex::Logger::setOutputStream(std::cout, true);
+
+		// every segment can be decoded on its own
+		const auto files {readRotatedFiles(path)};
+		REQUIRE(files.size() > 1);
+		for (const auto &[index, data] : files) {
+			REQUIRE(data.starts_with(static_cast<char> (flex::logger::binary::ChunkKind::eHeader)));
+			flex::logger::binary::Decoder decoder {flex::logger::binary::DecodeOutputFormat::eText};
+			std::string output {};
+			REQUIRE(decoder.decode(std::as_bytes(std::span{data}), output) == flex::logger::binary::DecodeResult::eSuccess);
+			REQUIRE(output.find("<unknown call site") == std::string::npos);
+		}
+	}
+
+	SECTION("never trimmed segment") {
+		constexpr std::size_t SEGMENT_SIZE {4096};
+		const TemporaryDirectory directory {"flex_binary_crash"};
+		const std::filesystem::path path {directory.getPath() / "log"};
+
+		const pid_t child {::fork()};
+		REQUIRE(child >= 0);
+		if (child == 0) {
+			flex::Logger::setSinks({std::make_shared<flex::logger::RotatingFileSink> (flex::logger::RotatingFileSink::CreateInfo{
+				.path = path,
+				.segmentSize = SEGMENT_SIZE
+			})});
+			flex::Logger::setBinaryFormat(true);
+			for (int i {0}; i < 10; ++i)
+				logFromSharedCallSite(i);
+			// dies without closing the segments, which keep their preallocated size
+			::_exit(0);
+		}
+		int status {};
+		REQUIRE(::waitpid(child, &status, 0) == child);
+		REQUIRE(WIFEXITED(status));
+
+		const auto files {readRotatedFiles(path)};
+		REQUIRE(!files.empty());
+		REQUIRE(files.front().second.size() == SEGMENT_SIZE);
+		REQUIRE(files.front().second.back() == '\0');
+		std::size_t linesCount {0};
+		for (const auto &[index, data] : files) {
+			flex::logger::binary::Decoder decoder {flex::logger::binary::DecodeOutputFormat::eText};
+			std::string output {};
+			REQUIRE(decoder.decode(std::as_bytes(std::span{data}), output) == flex::logger::binary::DecodeResult::eSuccess);
+			linesCount += countLines(output);
+		}
+		REQUIRE(linesCount == 10);
+	}
+#endif
+
+	flex::Logger::setOutputStream(std::cout, true);
+}
+
+
+TEST_CASE("sampling", "[logger]") {
+	flex::Logger::setFormatString("{0}");
+	flex::Logger::setMinLevel(flex::LogLevel::eInfo);
+	flex::Logger::setSuppressedRecordsSummaryInterval(std::chrono::seconds{0});
+	const auto sink {std::make_shared<flex::logger::MemoryRingSink> (64)};
+	flex::Logger::setSinks({sink});
+
+	SECTION("every n") {
+		for (std::size_t i {0}; i < 10; ++i)
+			FLEX_LOG_EVERY_N(flex::LogLevel::eInfo, 4, "occurrence {}", i);
+		REQUIRE(sink->getLines() == std::vector<std::string> {"occurrence 0", "occurrence 4", "occurrence 8"});
+
+		flex::Logger::logSuppressedRecords();
+		REQUIRE(sink->getLines().back().starts_with("7 similar records suppressed at "));
+	}
+
+	SECTION("first n") {
+		for (std::size_t i {0}; i < 10; ++i)
+			FLEX_LOG_FIRST_N(flex::LogLevel::eInfo, 2, "occurrence {}", i);
+		REQUIRE(sink->getLines() == std::vector<std::string> {"occurrence 0", "occurrence 1"});
+
+		flex::Logger::logSuppressedRecords();
+		REQUIRE(sink->getLines().back().starts_with("8 similar records suppressed at "));
+		flex::Logger::logSuppressedRecords();
+		REQUIRE(sink->getLines().size() == 3);
+	}
+
+	SECTION("rate limited") {
+		std::vector<std::jthread> threads {};
+		for (std::size_t i {0}; i < 4; ++i) {
+			threads.emplace_back([]() {
+				for (std::size_t j {0}; j < 1000; ++j)
+					FLEX_LOG_RATE_LIMITED(flex::LogLevel::eInfo, 5, "limited");
+			});
+		}
+		threads.clear();
+		// the loops may straddle two seconds
+		REQUIRE(sink->getLines().size() >= 5);
+		REQUIRE(sink->getLines().size() <= 10);
+	}
+
+	flex::Logger::setSuppressedRecordsSummaryInterval(std::chrono::seconds{10});
+	flex::Logger::setFormatString("{3}[{1}] > {0}{4}");
+	flex::Logger::setOutputStream(std::cout, true);
+}
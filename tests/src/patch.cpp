@@ -0,0 +1,136 @@
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <flex/patch.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+namespace {
+	struct Vector2 {
+		float x;
+		float y;
+	};
+
+	struct Unit {
+		std::uint32_t id;
+		Vector2 position;
+		std::int32_t health;
+		std::string name;
+		std::vector<std::uint32_t> targets;
+		std::optional<std::uint32_t> owner;
+	};
+
+	// b is at offset 2, the sizes and alignments of the members alone would put it at 1
+	struct Aligned {
+		char a;
+		alignas(2) char b;
+		double d;
+	};
+
+	class Session {
+		public:
+			auto getTick() const noexcept -> std::uint64_t {return m_tick;}
+			auto setTick(std::uint64_t tick) noexcept -> void {m_tick = tick;}
+			auto getLeader() const noexcept -> Unit {return m_leader;}
+			auto setLeader(const Unit &leader) noexcept -> void {m_leader = leader;}
+
+			std::vector<Unit> units;
+
+			struct FlexMetadata {
+				static constexpr std::tuple MEMBERS {
+					std::tuple{"tick", &Session::getTick, &Session::setTick},
+					&Session::units,
+					std::tuple{"leader", &Session::getLeader, &Session::setLeader}
+				};
+			};
+
+		private:
+			std::uint64_t m_tick {0};
+			Unit m_leader {};
+	};
+
+} // namespace
+
+
+TEST_CASE("patch round trip", "[patch]") {
+	const Unit previous {7, {1.f, 2.f}, 100, "scout", {1, 2}, std::nullopt};
+	Unit current {previous};
+	REQUIRE(flex::makePatch(previous, current).size() == 1);
+
+	current.position.y = 3.5f;
+	current.owner = 4;
+	const auto patch {flex::makePatch(previous, current)};
+	// count, gap, nested patch of position (count, gap, float), gap, owner (presence, value)
+	REQUIRE(patch.size() == 1 + 1 + (1 + 1 + sizeof(float)) + 1 + (1 + sizeof(std::uint32_t)));
+
+	Unit patched {previous};
+	REQUIRE(flex::applyPatch(patched, patch).has_value());
+	REQUIRE(flex::equal(patched, current));
+	REQUIRE(patched.position.x == 1.f);
+	REQUIRE(patched.position.y == 3.5f);
+	REQUIRE(patched.owner == 4u);
+}
+
+
+TEST_CASE("patch of over-aligned members", "[patch]") {
+	const Aligned previous {'a', 0, 0.5};
+	Aligned current {previous};
+	current.b = 5;
+	const auto patch {flex::makePatch(previous, current)};
+	// count, gap, b
+	REQUIRE(patch.size() == 3);
+
+	Aligned patched {previous};
+	REQUIRE(flex::applyPatch(patched, patch).has_value());
+	REQUIRE(patched.a == 'a');
+	REQUIRE(patched.b == 5);
+	REQUIRE(patched.d == 0.5);
+}
+
+
+TEST_CASE("patch through getters and setters", "[patch]") {
+	Session previous {};
+	previous.units.push_back(Unit{1, {0.f, 0.f}, 10, "a", {}, std::nullopt});
+	Session current {previous};
+	current.setTick(42);
+	Unit leader {current.getLeader()};
+	leader.name = "boss";
+	current.setLeader(leader);
+
+	const auto patch {flex::makePatch(previous, current)};
+	Session patched {previous};
+	REQUIRE(flex::applyPatch(patched, patch).has_value());
+	REQUIRE(patched.getTick() == 42);
+	REQUIRE(patched.getLeader().name == "boss");
+	REQUIRE(patched.units.size() == 1);
+	REQUIRE(flex::diff(patched, current).none());
+}
+
+
+TEST_CASE("invalid patch", "[patch]") {
+	const Unit previous {7, {1.f, 2.f}, 100, "scout", {1, 2}, std::nullopt};
+	Unit current {previous};
+	current.name = "ranger";
+	auto patch {flex::makePatch(previous, current)};
+
+	Unit patched {previous};
+	const std::span<const std::byte> bytes {patch};
+	REQUIRE(flex::applyPatch(patched, bytes.first(bytes.size() - 1)).error() == flex::DeserializeError::eTruncated);
+
+	patch.push_back(std::byte{0});
+	REQUIRE(flex::applyPatch(patched, patch).error() == flex::DeserializeError::eTrailingBytes);
+
+	const std::vector<std::byte> outOfRange {std::byte{1}, std::byte{6}};
+	REQUIRE(flex::applyPatch(patched, outOfRange).error() == flex::DeserializeError::eInvalidValue);
+	const std::vector<std::byte> tooManyChanges {std::byte{7}};
+	REQUIRE(flex::applyPatch(patched, tooManyChanges).error() == flex::DeserializeError::eInvalidValue);
+
+	// one change, to `units`, holding far more units than the patch has bytes
+	Session session {};
+	const std::vector<std::byte> hostileCount {
+		std::byte{1}, std::byte{1}, std::byte{0xff}, std::byte{0xff}, std::byte{0xff}, std::byte{0xff}, std::byte{0x0f}
+	};
+	REQUIRE(flex::applyPatch(session, hostileCount).error() == flex::DeserializeError::eTruncated);
+}
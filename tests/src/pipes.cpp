@@ -0,0 +1,261 @@
+#include <array>
+#include <expected>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <flex/pipes/accumulateErrors.hpp>
+#include <flex/pipes/andThen.hpp>
+#include <flex/pipes/conversion.hpp>
+#include <flex/pipes/hasValue.hpp>
+#include <flex/pipes/parallel.hpp>
+#include <flex/pipes/toNumber.hpp>
+#include <flex/pipes/toString.hpp>
+#include <flex/pipes/transform.hpp>
+#include <flex/pipes/valueOr.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+namespace {
+	template <typename T>
+	class Outcome final {
+		public:
+			using ValueType = T;
+			using ErrorType = std::string;
+			template <typename U>
+			using Rebind = Outcome<U>;
+
+			Outcome(T value) : m_value {std::move(value)}, m_error {} {}
+
+			static auto makeError(std::string error) -> Outcome {
+				Outcome outcome {};
+				outcome.m_error = std::move(error);
+				return outcome;
+			}
+
+			auto operator*() -> T& {return *m_value;}
+			auto operator*() const -> const T& {return *m_value;}
+			auto operator->() -> T* {return &*m_value;}
+			auto operator->() const -> const T* {return &*m_value;}
+			auto operator!() const -> bool {return !m_value;}
+			auto getError() -> std::string& {return m_error;}
+			auto getError() const -> const std::string& {return m_error;}
+
+		private:
+			Outcome() = default;
+
+			std::optional<T> m_value;
+			std::string m_error;
+	};
+
+	template <typename T>
+	class Maybe final {
+		public:
+			using ValueType = T;
+			template <typename U>
+			using Rebind = Maybe<U>;
+
+			Maybe(T value) : m_value {std::move(value)} {}
+
+			static auto makeError() -> Maybe {return Maybe{};}
+
+			auto operator*() -> T& {return *m_value;}
+			auto operator*() const -> const T& {return *m_value;}
+			auto operator->() -> T* {return &*m_value;}
+			auto operator->() const -> const T* {return &*m_value;}
+			auto operator!() const -> bool {return !m_value;}
+
+		private:
+			Maybe() = default;
+
+			std::optional<T> m_value;
+	};
+
+	template <typename T>
+	class Unrebindable final {
+		public:
+			using ValueType = T;
+
+			auto operator*() -> T& {return m_value;}
+			auto operator*() const -> const T& {return m_value;}
+			auto operator->() -> T* {return &m_value;}
+			auto operator->() const -> const T* {return &m_value;}
+			auto operator!() const -> bool {return false;}
+
+		private:
+			T m_value;
+	};
+
+} // namespace
+
+static_assert(flex::rebindable_error_type<Outcome<int>>);
+static_assert(flex::rebindable_error_type<Maybe<int>>);
+static_assert(flex::error_type<Unrebindable<int>>);
+static_assert(!flex::rebindable_error_type<Unrebindable<int>>);
+
+
+TEST_CASE("pipeline composition", "[pipes]") {
+	auto pipeline {flex::pipes::to_number<int> ()
+		| flex::pipes::transform([](int value) {return value * 2;})
+		| flex::pipes::value_or(-1)
+	};
+	static_assert(flex::pipes::pipe_object<decltype(pipeline)>);
+	static_assert(std::tuple_size_v<std::remove_cvref_t<decltype(pipeline.getPipes())>> == 3);
+
+	REQUIRE(pipeline(std::string_view{"21"}) == 42);
+	REQUIRE((std::string_view{"nope"} | pipeline) == -1);
+
+	auto extended {pipeline | flex::pipes::static_cast_to<double> ()};
+	static_assert(std::tuple_size_v<std::remove_cvref_t<decltype(extended.getPipes())>> == 4);
+	REQUIRE(extended(std::string_view{"3"}) == 6.0);
+
+	const std::optional<int> value {std::optional<int> {4} | (flex::pipes::transform([](int x) {return x + 1;}) | flex::pipes::value_or(0))};
+	REQUIRE(value == 5);
+}
+
+
+TEST_CASE("pipeline over ranges", "[pipes]") {
+	const std::vector<std::string_view> fields {"1", "x", "30", "-4"};
+	auto pipeline {flex::pipes::to_number<int> () | flex::pipes::value_or(0)};
+
+	std::vector<int> lazyResults {};
+	for (int number : flex::pipes::lazy(fields, pipeline))
+		lazyResults.push_back(number);
+	REQUIRE(lazyResults == std::vector<int> {1, 0, 30, -4});
+
+	auto view {flex::pipes::lazy(fields, pipeline) | std::views::filter([](int number) {return number > 0;})};
+	REQUIRE(std::ranges::distance(view) == 2);
+
+	std::array<int, 4> buffer {};
+	const auto end {flex::pipes::apply_into(fields, pipeline, buffer.begin())};
+	REQUIRE(end == buffer.end());
+	REQUIRE(buffer == std::array{1, 0, 30, -4});
+}
+
+
+TEST_CASE("parallel pipeline", "[pipes]") {
+	std::vector<std::string> fields (100'000);
+	for (std::size_t i {0}; i < fields.size(); ++i)
+		fields[i] = i % 1000 == 7 ? "invalid" : std::to_string(i);
+
+	flex::ThreadPool pool {4};
+	const auto parsed {fields | flex::pipes::par(flex::pipes::to_number<std::size_t> (), pool)};
+	REQUIRE(parsed.results.size() == fields.size());
+	REQUIRE(parsed.failedIndices.size() == 100);
+	REQUIRE(parsed.failedIndices.front() == 7);
+	REQUIRE(parsed.failedIndices.back() == 99'007);
+	for (std::size_t i {0}; i < fields.size(); ++i)
+		REQUIRE(parsed.results[i] == (i % 1000 == 7 ? std::nullopt : std::optional{i}));
+
+	std::vector<int> numbers (50'000);
+	std::iota(numbers.begin(), numbers.end(), 0);
+	const auto doubled {numbers | flex::pipes::par_unseq(flex::pipes::static_cast_to<long> () | flex::pipes::transform([](long x) {return x * 2;}), pool)};
+	REQUIRE(doubled.failedIndices.empty());
+	REQUIRE(std::accumulate(doubled.results.begin(), doubled.results.end(), 0l) == 49'999l * 50'000l);
+}
+
+
+TEST_CASE("expected pipeline", "[pipes]") {
+	using Expected = std::expected<std::string_view, std::string>;
+	auto parse {flex::pipes::and_then([](std::string_view field) -> std::expected<int, std::string> {
+		if (field.empty())
+			return std::unexpected<std::string> ("empty field");
+		return static_cast<int> (field.size());
+	})};
+	auto pipeline {parse | flex::pipes::transform([](int size) {return size * 10;}) | flex::pipes::static_cast_to<long> ()};
+
+	const auto success {pipeline(Expected{"abc"})};
+	static_assert(std::same_as<std::remove_cvref_t<decltype(success)>, std::expected<long, std::string>>);
+	REQUIRE(success == 30l);
+
+	const auto emptyField {pipeline(Expected{""})};
+	REQUIRE(!emptyField);
+	REQUIRE(emptyField.error() == "empty field");
+
+	const Expected upstreamFailure {std::unexpect, "no such column"};
+	const auto propagated {upstreamFailure | pipeline};
+	REQUIRE(propagated.error() == "no such column");
+	REQUIRE((propagated | flex::pipes::value_or(-1l)) == -1l);
+	REQUIRE(!(propagated | flex::pipes::has_value()));
+
+	// the error payload is kept, the parsing failure has none and stays an empty optional
+	const auto number {std::expected<std::string_view, int> {"12"} | flex::pipes::to_number<int> ()};
+	static_assert(std::same_as<std::remove_cvref_t<decltype(number)>, std::expected<std::optional<int>, int>>);
+	REQUIRE(number.value() == std::optional{12});
+	REQUIRE((std::expected<std::string_view, int> {std::unexpect, 3} | flex::pipes::to_number<int> ()).error() == 3);
+
+	const auto optionalNumber {std::optional<std::string_view> {"x"} | flex::pipes::to_number<int> ()};
+	static_assert(std::same_as<std::remove_cvref_t<decltype(optionalNumber)>, std::optional<int>>);
+	REQUIRE(!optionalNumber);
+}
+
+
+TEST_CASE("error accumulation", "[pipes]") {
+	const std::vector<std::string_view> fields {"4", "", "7", "", "", "1"};
+	auto parse {flex::pipes::and_then([](std::string_view field) -> std::expected<int, std::string> {
+		if (field.empty())
+			return std::unexpected<std::string> ("empty field");
+		return field.front() - '0';
+	})};
+
+	flex::pipes::ErrorAccumulator<std::string> errors {2};
+	std::vector<std::expected<int, std::string>> results {};
+	for (std::string_view field : fields)
+		results.push_back(std::expected<std::string_view, std::string> {field} | parse | flex::pipes::accumulate_errors(errors));
+
+	REQUIRE(results.size() == fields.size());
+	REQUIRE(results[2] == 7);
+	REQUIRE(errors.getProcessedCount() == 6);
+	REQUIRE(errors.getFailures().size() == 2);
+	REQUIRE(errors.getFailures()[0].index == 1);
+	REQUIRE(errors.getFailures()[1].index == 3);
+	REQUIRE(errors.getFailures()[1].error == "empty field");
+	REQUIRE(errors.getDroppedCount() == 1);
+	REQUIRE(errors.hasFailed());
+
+	flex::pipes::ErrorAccumulator<std::monostate> emptyOptionals {8};
+	std::array<int, 6> numbers {};
+	flex::pipes::apply_into(fields, flex::pipes::to_number<int> () | flex::pipes::accumulate_errors(emptyOptionals) | flex::pipes::value_or(0), numbers.begin());
+	REQUIRE(numbers == std::array{4, 0, 7, 0, 0, 1});
+	REQUIRE(emptyOptionals.getFailures().size() == 3);
+	REQUIRE(emptyOptionals.getFailures()[2].index == 4);
+	REQUIRE(emptyOptionals.getDroppedCount() == 0);
+
+	emptyOptionals.clear();
+	REQUIRE(!emptyOptionals.hasFailed());
+}
+
+
+TEST_CASE("custom error type pipeline", "[pipes]") {
+	auto pipeline {flex::pipes::transform([](std::string_view field) {return field.substr(1);})
+		| flex::pipes::to_number<int> ()
+		| flex::pipes::transform([](std::optional<int> number) {return number.value_or(-1);})
+		| flex::pipes::static_cast_to<long> ()
+		| flex::pipes::to_string()
+	};
+
+	const auto success {pipeline(Outcome<std::string_view> {"#42"})};
+	static_assert(std::same_as<std::remove_cvref_t<decltype(success)>, Outcome<std::string>>);
+	REQUIRE(!!success);
+	REQUIRE(*success == "42");
+	REQUIRE(*pipeline(Outcome<std::string_view> {"#x"}) == "-1");
+
+	const auto failure {Outcome<std::string_view>::makeError("no such column") | pipeline};
+	REQUIRE(!failure);
+	REQUIRE(failure.getError() == "no such column");
+	REQUIRE((failure | flex::pipes::value_or(std::string{"none"})) == "none");
+
+	// without error, the failure of the parsing merges with the one of the entry
+	const auto number {Maybe<std::string_view> {"12"} | flex::pipes::to_number<int> ()};
+	static_assert(std::same_as<std::remove_cvref_t<decltype(number)>, std::optional<int>>);
+	REQUIRE(number == 12);
+	REQUIRE(!(Maybe<std::string_view>::makeError() | flex::pipes::to_number<int> ()));
+
+	const auto text {Maybe<int> {7} | flex::pipes::static_cast_to<double> () | flex::pipes::to_string()};
+	static_assert(std::same_as<std::remove_cvref_t<decltype(text)>, Maybe<std::string>>);
+	REQUIRE(*text == "7");
+	REQUIRE(!(Maybe<int>::makeError() | flex::pipes::transform([](int value) {return value * 2;})));
+}
@@ -41,6 +41,33 @@ struct Person {
 	auto test() -> void {}
 };
 
+// wider than the 128 members reflection used to be limited to
+struct Wide {
+	int
+		m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19,
+		m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31, m32, m33, m34, m35, m36, m37, m38, m39,
+		m40, m41, m42, m43, m44, m45, m46, m47, m48, m49, m50, m51, m52, m53, m54, m55, m56, m57, m58, m59,
+		m60, m61, m62, m63, m64, m65, m66, m67, m68, m69, m70, m71, m72, m73, m74, m75, m76, m77, m78, m79,
+		m80, m81, m82, m83, m84, m85, m86, m87, m88, m89, m90, m91, m92, m93, m94, m95, m96, m97, m98, m99,
+		m100, m101, m102, m103, m104, m105, m106, m107, m108, m109, m110, m111, m112, m113, m114, m115, m116, m117, m118, m119,
+		m120, m121, m122, m123, m124, m125, m126, m127, m128, m129, m130, m131, m132, m133, m134, m135, m136, m137, m138, m139,
+		m140, m141, m142, m143, m144, m145, m146, m147, m148, m149, m150, m151, m152, m153, m154, m155, m156, m157, m158, m159,
+		m160, m161, m162, m163, m164, m165, m166, m167, m168, m169, m170, m171, m172, m173, m174, m175, m176, m177, m178, m179,
+		m180, m181, m182, m183, m184, m185, m186, m187, m188, m189, m190, m191, m192, m193, m194, m195, m196, m197, m198, m199;
+	double last;
+};
+
+struct EmptyAggregate {};
+
+struct Measure {
+	bool valid;
+	double ratio;
+	float scale;
+	std::uint8_t channel;
+	char unit;
+	long long offset;
+};
+
 
 static_assert(!flex::reflectable<decltype("{")>);
 
@@ -60,6 +87,14 @@ static_assert(std::get<2> (flex::reflection_members_names_v<Address>) == "city")
 static_assert(std::get<3> (flex::reflection_members_names_v<Address>) == "country");
 static_assert(std::is_same_v<flex::reflection_members_t<Address>, std::tuple<std::string, int, City, std::string>>);
 
+static_assert(flex::reflection_members_count_v<Wide> == 201);
+static_assert(std::get<137> (flex::reflection_members_names_v<Wide>) == "m137");
+static_assert(flex::reflection_members_names_v<Wide>.back() == "last");
+static_assert(std::is_same_v<std::tuple_element_t<200, flex::reflection_members_t<Wide>>, double>);
+
+static_assert(flex::reflection_members_count_v<EmptyAggregate> == 0);
+static_assert(std::is_same_v<flex::reflection_members_t<EmptyAggregate>, std::tuple<>>);
+
 
 
 TEST_CASE("reflection", "[reflection]") {
@@ -103,3 +138,64 @@ TEST_CASE("reflection", "[reflection]") {
 	REQUIRE(person.address.city.city == "Bern");
 	REQUIRE(person.address.getCountry() == "Switzerland");
 }
+
+
+TEST_CASE("wide aggregate", "[reflection]") {
+	Wide wide {};
+	flex::reflection_traits<Wide>::getMember<150> (wide) = 42;
+	flex::reflection_traits<Wide>::getMember<200> (wide) = 0.5;
+	const Wide &constWide {wide};
+
+	REQUIRE(wide.m150 == 42);
+	REQUIRE(flex::reflection_traits<Wide>::getMember<150> (constWide) == 42);
+	REQUIRE(wide.last == 0.5);
+	REQUIRE(&std::get<150> (flex::reflection::makeAggregateMembersTuple(wide)) == &wide.m150);
+}
+
+
+TEST_CASE("reflectable formatter", "[reflection]") {
+	Person person {"Albert", "Einstein", 76, {}};
+	person.address.street = "Kramgasse";
+	person.address.number = 12;
+	person.address.city = City{3000, "Bern"};
+	person.address.setCountry("Switzerland");
+
+	REQUIRE(std::format("{}", person) == "{name: \"Albert\", surname: \"Einstein\", age: 76, address: "
+		"{street: \"Kramgasse\", streetNumber: 12, city: {postalCode: 3000, city: \"Bern\"}, country: \"Switzerland\"}}"
+	);
+
+	REQUIRE(std::format("{:4} and {}", person.address.city, City{1000, "\"Lausanne\""}) ==
+		"{\n"
+		"    postalCode: 3000, \n"
+		"    city: \"Bern\"\n"
+		"} and {postalCode: 1000, city: \"\\\"Lausanne\\\"\"}"
+	);
+
+	REQUIRE(std::format("{:2}", person).ends_with(
+		"  address: {\n"
+		"    street: \"Kramgasse\", \n"
+		"    streetNumber: 12, \n"
+		"    city: {\n"
+		"      postalCode: 3000, \n"
+		"      city: \"Bern\"\n"
+		"    }, \n"
+		"    country: \"Switzerland\"\n"
+		"  }\n"
+		"}"
+	));
+}
+
+
+TEST_CASE("reflectable formatter arithmetic members", "[reflection]") {
+	const Measure measure {true, 1.0 / 3.0, 1e-7f, 65, 'm', -12};
+
+	REQUIRE(std::format("{}", measure) == "{valid: 1, ratio: 0.333333, scale: 1e-07, channel: A, unit: m, offset: -12}");
+
+	std::ostringstream stream {};
+	stream << "{valid: " << measure.valid << ", ratio: " << measure.ratio << ", scale: " << measure.scale
+		<< ", channel: " << measure.channel << ", unit: " << measure.unit << ", offset: " << measure.offset << "}";
+	REQUIRE(std::format("{}", measure) == stream.view());
+	REQUIRE(std::format("{}", Measure{false, 2.5, 100000000.f, '0', ' ', 7}) ==
+		"{valid: 0, ratio: 2.5, scale: 1e+08, channel: 0, unit:  , offset: 7}"
+	);
+}
@@ -0,0 +1,129 @@
+#include <list>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <flex/serialization.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+namespace {
+	enum class Kind : std::uint8_t {
+		eRequest,
+		eResponse
+	};
+
+	struct Vector3 {
+		float x;
+		float y;
+		float z;
+	};
+
+	struct Header {
+		Kind kind;
+		std::uint32_t id;
+		bool urgent;
+	};
+
+	struct Message {
+		Header header;
+		std::string body;
+		std::vector<Vector3> points;
+		std::optional<std::list<std::string>> tags;
+		std::map<std::string, std::int64_t> counters;
+		std::set<int> flags;
+		std::array<std::uint16_t, 3> version;
+		std::pair<double, std::string> extra;
+	};
+
+	struct Renamed {
+		int value;
+		std::string label;
+
+		struct FlexMetadata {
+			static constexpr std::tuple MEMBERS {
+				std::tuple{"number", &Renamed::value},
+				&Renamed::label
+			};
+		};
+	};
+
+} // namespace
+
+static_assert(flex::__internals::is_bulk_serializable_v<Vector3>);
+static_assert(flex::__internals::is_bulk_serializable_v<std::array<Vector3, 2>>);
+static_assert(!flex::__internals::is_bulk_serializable_v<Header>);
+static_assert(flex::__internals::getMinEncodedSize<Header> () == 6);
+static_assert(flex::__internals::getMinEncodedSize<Renamed> () == 5);
+
+
+TEST_CASE("round trip", "[serialization]") {
+	const Message message {
+		.header = {Kind::eResponse, 0x01020304, true},
+		.body = "hello",
+		.points = {{1.f, 2.f, 3.f}, {-1.f, 0.5f, 8.f}},
+		.tags = std::list<std::string> {"a", "bc"},
+		.counters = {{"x", -3}, {"y", 1ll << 40}},
+		.flags = {3, 1, 2},
+		.version = {1, 2, 3},
+		.extra = {2.5, "extra"}
+	};
+
+	std::vector<std::byte> buffer {};
+	flex::serialize(message, buffer);
+
+	// kind, id little-endian, urgent
+	REQUIRE(buffer[0] == std::byte{1});
+	REQUIRE(buffer[1] == std::byte{0x04});
+	REQUIRE(buffer[4] == std::byte{0x01});
+	REQUIRE(buffer[5] == std::byte{1});
+
+	const auto result {flex::deserialize<Message> (buffer)};
+	REQUIRE(result.has_value());
+	REQUIRE(result->header.kind == Kind::eResponse);
+	REQUIRE(result->header.id == 0x01020304);
+	REQUIRE(result->header.urgent);
+	REQUIRE(result->body == "hello");
+	REQUIRE(result->points.size() == 2);
+	REQUIRE(result->points[1].y == 0.5f);
+	REQUIRE(result->tags == message.tags);
+	REQUIRE(result->counters == message.counters);
+	REQUIRE(result->flags == message.flags);
+	REQUIRE(result->version == message.version);
+	REQUIRE(result->extra == message.extra);
+
+	std::string text {};
+	flex::serialize(Renamed{42, "label"}, text);
+	REQUIRE(text.size() == sizeof(int) + 1 + 5);
+	const auto renamed {flex::deserialize<Renamed> (std::as_bytes(std::span{text}))};
+	REQUIRE(renamed.has_value());
+	REQUIRE(renamed->value == 42);
+	REQUIRE(renamed->label == "label");
+}
+
+
+TEST_CASE("invalid input", "[serialization]") {
+	std::vector<std::byte> buffer {};
+	flex::serialize(std::vector<std::string> {"first", "second"}, buffer);
+
+	const std::span<const std::byte> bytes {buffer};
+	REQUIRE(flex::deserialize<std::vector<std::string>> (bytes.first(bytes.size() - 1)).error() == flex::DeserializeError::eTruncated);
+
+	buffer.push_back(std::byte{0});
+	REQUIRE(flex::deserialize<std::vector<std::string>> (buffer).error() == flex::DeserializeError::eTrailingBytes);
+
+	const std::vector<std::byte> hugeCount {std::byte{0xff}, std::byte{0xff}, std::byte{0xff}, std::byte{0x0f}};
+	REQUIRE(flex::deserialize<std::vector<int>> (hugeCount).error() == flex::DeserializeError::eTruncated);
+
+	// a count the input can't hold must be rejected before any element gets allocated
+	const std::vector<std::byte> hostileCount {std::byte{0xff}, std::byte{0xff}, std::byte{0xff}, std::byte{0xff}, std::byte{0x0f}, std::byte{0}};
+	REQUIRE(flex::deserialize<std::vector<Renamed>> (hostileCount).error() == flex::DeserializeError::eTruncated);
+	REQUIRE(flex::deserialize<std::vector<Header>> (hostileCount).error() == flex::DeserializeError::eTruncated);
+	REQUIRE(flex::deserialize<std::vector<Message>> (hostileCount).error() == flex::DeserializeError::eTruncated);
+	REQUIRE(flex::deserialize<std::vector<std::vector<std::string>>> (hostileCount).error() == flex::DeserializeError::eTruncated);
+
+	const std::vector<std::byte> invalidBool {std::byte{2}};
+	REQUIRE(flex::deserialize<bool> (invalidBool).error() == flex::DeserializeError::eInvalidValue);
+}
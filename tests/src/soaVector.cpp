@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+
+#include <flex/soaVector.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+namespace {
+	struct Trade {
+		std::uint64_t id;
+		double price;
+		std::uint32_t quantity;
+		bool buy;
+		std::string symbol;
+	};
+
+	/*
+	 * Copy-only, its copies throw once `copiesLeft` runs out
+	 * */
+	struct Fragile {
+		Fragile(int value = 0) : value {value} {}
+		Fragile(const Fragile &other) : value {other.value} {
+			if (copiesLeft-- == 0)
+				throw std::runtime_error{"copy"};
+		}
+		auto operator=(const Fragile&) -> Fragile& = default;
+
+		int value;
+		static inline int copiesLeft {0};
+	};
+
+	struct Labelled {
+		std::string label;
+		Fragile fragile;
+	};
+
+} // namespace
+
+static_assert(std::ranges::random_access_range<flex::SoAVector<Trade>>);
+static_assert(std::ranges::random_access_range<const flex::SoAVector<Trade>>);
+static_assert(std::ranges::sized_range<flex::SoAVector<Trade>>);
+static_assert(std::sortable<flex::SoAVector<Trade>::iterator, std::ranges::less, decltype([](const Trade &trade) {return trade.price;})>);
+
+
+TEST_CASE("columns", "[soaVector]") {
+	flex::SoAVector<Trade> trades {};
+	for (std::uint64_t i {0}; i < 100; ++i)
+		trades.push_back(Trade{i, 10.0 + static_cast<double> (i), static_cast<std::uint32_t> (i % 7), i % 2 == 0, "SYM" + std::to_string(i % 3)});
+	trades.emplace_back(100u, 0.5, 3u, false, "LAST");
+
+	REQUIRE(trades.size() == 101);
+	REQUIRE(trades.capacity() >= 101);
+
+	const std::span<double> prices {trades.column<"price">()};
+	REQUIRE(prices.size() == 101);
+	REQUIRE(prices[5] == 15.0);
+	REQUIRE(trades.column<1>().data() == prices.data());
+
+	const auto quantities {trades.column<"quantity">()};
+	REQUIRE(std::accumulate(quantities.begin(), quantities.end(), std::uint64_t{0}) == 295 + 3);
+
+	for (double &price : trades.column<"price">())
+		price *= 2.0;
+	REQUIRE(static_cast<Trade> (trades[5]).price == 30.0);
+
+	const Trade last = trades.back();
+	REQUIRE(last.id == 100);
+	REQUIRE(last.symbol == "LAST");
+}
+
+
+TEST_CASE("proxy references", "[soaVector]") {
+	flex::SoAVector<Trade> trades {};
+	trades.push_back({1, 3.0, 10, true, "A"});
+	trades.push_back({2, 1.0, 20, false, "B"});
+	trades.push_back({3, 2.0, 30, true, "C"});
+
+	auto reference {trades[1]};
+	reference.get<"quantity">() += 5;
+	REQUIRE(trades.column<"quantity">()[1] == 25);
+
+	auto [id, price, quantity, buy, symbol] {trades[2]};
+	symbol = "D";
+	REQUIRE(trades[2].get<"symbol">() == "D");
+
+	trades[0] = Trade{9, 9.0, 9, false, "Z"};
+	REQUIRE(trades[0].get<0>() == 9);
+	trades[1] = trades[0];
+	REQUIRE(trades[1].get<"symbol">() == "Z");
+
+	std::ranges::sort(trades, {}, [](const Trade &trade) {return trade.id;});
+	REQUIRE(std::ranges::equal(trades.column<"id">(), std::vector<std::uint64_t> {3, 9, 9}));
+	REQUIRE(trades[0].get<"symbol">() == "D");
+
+	auto buys {trades
+		| std::views::filter([](const Trade &trade) {return trade.buy;})
+		| std::views::transform([](const Trade &trade) {return trade.id;})
+	};
+	REQUIRE(std::ranges::distance(buys) == 1);
+	REQUIRE(*buys.begin() == 3);
+
+	const flex::SoAVector<Trade> copy {trades};
+	trades.clear();
+	REQUIRE(trades.empty());
+	REQUIRE(copy.size() == 3);
+	REQUIRE(copy[2].get<"symbol">() == "Z");
+
+	flex::SoAVector<Trade> moved {std::move(trades)};
+	moved.resize(2);
+	REQUIRE(moved[1].get<"symbol">().empty());
+	moved.pop_back();
+	REQUIRE(moved.size() == 1);
+}
+
+
+TEST_CASE("failed reserve", "[soaVector]") {
+	Fragile::copiesLeft = 1000;
+	flex::SoAVector<Labelled> labelled {};
+	labelled.reserve(3);
+	labelled.push_back({"first label, too long for the small string buffer", 1});
+	labelled.push_back({"second label, too long for the small string buffer", 2});
+	labelled.push_back({"third label, too long for the small string buffer", 3});
+
+	// the fragile column throws on its second copy, after the label column could have been moved
+	Fragile::copiesLeft = 1;
+	REQUIRE_THROWS_AS(labelled.reserve(100), std::runtime_error);
+	REQUIRE(labelled.size() == 3);
+	REQUIRE(labelled.capacity() == 3);
+	REQUIRE(labelled[0].get<"label">() == "first label, too long for the small string buffer");
+	REQUIRE(labelled[2].get<"label">() == "third label, too long for the small string buffer");
+	REQUIRE(labelled[1].get<"fragile">().value == 2);
+
+	Fragile::copiesLeft = 1000;
+	labelled.reserve(100);
+	REQUIRE(labelled.capacity() == 100);
+	REQUIRE(labelled[1].get<"label">() == "second label, too long for the small string buffer");
+}
+
+
+TEST_CASE("emplace from own elements", "[soaVector]") {
+	flex::SoAVector<Trade> trades {};
+	trades.emplace_back(1u, 2.5, 10u, true, "first symbol, too long for the small string buffer");
+	while (trades.size() != trades.capacity())
+		trades.push_back({2, 1.0, 20, false, "B"});
+
+	// the arguments refer to the columns the reallocation moves out of
+	const auto &first {trades[0]};
+	trades.emplace_back(first.get<"id">(), first.get<"price">(), first.get<"quantity">(), first.get<"buy">(), first.get<"symbol">());
+	REQUIRE(trades.size() == 9);
+	REQUIRE(trades.back().get<"price">() == 2.5);
+	REQUIRE(trades.back().get<"quantity">() == 10);
+	REQUIRE(trades.back().get<"symbol">() == "first symbol, too long for the small string buffer");
+	REQUIRE(trades[0].get<"symbol">() == "first symbol, too long for the small string buffer");
+
+	Fragile::copiesLeft = 1000;
+	flex::SoAVector<Labelled> labelled {};
+	labelled.reserve(3);
+	labelled.push_back({"first label, too long for the small string buffer", 1});
+	labelled.push_back({"second label, too long for the small string buffer", 2});
+	labelled.push_back({"third label, too long for the small string buffer", 3});
+
+	// the new element is built, then the relocation of the fragile column throws
+	Fragile::copiesLeft = 2;
+	REQUIRE_THROWS_AS(labelled.emplace_back(labelled[0].get<"label">(), labelled[0].get<"fragile">()), std::runtime_error);
+	REQUIRE(labelled.size() == 3);
+	REQUIRE(labelled.capacity() == 3);
+	REQUIRE(labelled[0].get<"label">() == "first label, too long for the small string buffer");
+	REQUIRE(labelled[0].get<"fragile">().value == 1);
+
+	Fragile::copiesLeft = 1000;
+	labelled.emplace_back(labelled[2].get<"label">(), labelled[2].get<"fragile">());
+	REQUIRE(labelled.size() == 4);
+	REQUIRE(labelled[3].get<"label">() == "third label, too long for the small string buffer");
+	REQUIRE(labelled[3].get<"fragile">().value == 3);
+}
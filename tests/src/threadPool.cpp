@@ -0,0 +1,61 @@
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <flex/threadPool.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+TEST_CASE("run", "[threadPool]") {
+	flex::ThreadPool pool {3};
+	REQUIRE(pool.getThreadsCount() == 3);
+
+	for (std::size_t iteration {0}; iteration < 100; ++iteration) {
+		std::vector<std::atomic<int>> calls (pool.getThreadsCount());
+		pool.run([&](std::size_t threadIndex) {
+			++calls[threadIndex];
+		});
+		for (const auto &count : calls)
+			REQUIRE(count == 1);
+	}
+}
+
+
+TEST_CASE("nested run", "[threadPool]") {
+	flex::ThreadPool pool {2};
+	std::atomic<int> innerCalls {0};
+	pool.run([&](std::size_t) {
+		REQUIRE(flex::ThreadPool::isWorkerThread());
+		pool.run([&](std::size_t threadIndex) {
+			REQUIRE(threadIndex == 0);
+			++innerCalls;
+		});
+	});
+	REQUIRE(innerCalls == 2);
+	REQUIRE(!flex::ThreadPool::isWorkerThread());
+}
+
+
+TEST_CASE("run throwing", "[threadPool]") {
+	flex::ThreadPool pool {3};
+	std::atomic<int> calls {0};
+	REQUIRE_THROWS_AS(pool.run([&](std::size_t threadIndex) {
+		++calls;
+		if (threadIndex == 0)
+			throw std::runtime_error{"caller"};
+	}), std::runtime_error);
+	// the workers are done with the job before `run` rethrows
+	REQUIRE(calls == 3);
+	REQUIRE(!flex::ThreadPool::isWorkerThread());
+
+	REQUIRE_THROWS_AS(pool.run([&](std::size_t threadIndex) {
+		if (threadIndex != 0)
+			throw std::logic_error{"worker"};
+	}), std::logic_error);
+	REQUIRE(!flex::ThreadPool::isWorkerThread());
+
+	// the pool is still usable afterwards
+	calls = 0;
+	pool.run([&](std::size_t) {++calls;});
+	REQUIRE(calls == 3);
+}
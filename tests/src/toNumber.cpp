@@ -0,0 +1,61 @@
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <flex/pipes/toNumber.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+TEST_CASE("single number", "[pipes]") {
+	REQUIRE(("42" | flex::pipes::to_number<int> ()) == 42);
+	REQUIRE((std::string{"-7"} | flex::pipes::to_number<int> ()) == -7);
+	REQUIRE(!("abc" | flex::pipes::to_number<int> ()));
+	REQUIRE(("ff" | flex::pipes::to_number<int> (16)) == 255);
+}
+
+
+TEST_CASE("delimited integers", "[pipes]") {
+	std::array<std::int64_t, 8> buffer {};
+	const auto count {flex::pipes::to_numbers<std::int64_t> ("1,-22,123456789,12345678901234567,-9223372036854775808", ',', buffer)};
+	REQUIRE(count == 5);
+	REQUIRE(buffer[0] == 1);
+	REQUIRE(buffer[1] == -22);
+	REQUIRE(buffer[2] == 123456789);
+	REQUIRE(buffer[3] == 12345678901234567);
+	REQUIRE(buffer[4] == std::numeric_limits<std::int64_t>::min());
+
+	std::vector<std::uint8_t> bytes {7};
+	REQUIRE(flex::pipes::to_numbers<std::uint8_t> ("0;255;17", ';', bytes) == 3);
+	REQUIRE(bytes == std::vector<std::uint8_t> {7, 0, 255, 17});
+
+	std::vector<std::uint64_t> longs {};
+	REQUIRE(flex::pipes::to_numbers<std::uint64_t> ("18446744073709551615 00000000000000000000042", ' ', longs) == 2);
+	REQUIRE(longs == std::vector<std::uint64_t> {std::numeric_limits<std::uint64_t>::max(), 42});
+
+	REQUIRE(flex::pipes::to_numbers<std::int64_t> ("", ',', buffer) == 0);
+}
+
+
+TEST_CASE("delimited floating points", "[pipes]") {
+	std::vector<double> values {};
+	REQUIRE(flex::pipes::to_numbers<double> ("1.5,-2,3e2", ',', values) == 3);
+	REQUIRE(values == std::vector<double> {1.5, -2.0, 300.0});
+}
+
+
+TEST_CASE("errors", "[pipes]") {
+	using flex::pipes::ToNumbersError;
+	std::vector<int> values {1};
+
+	REQUIRE(flex::pipes::to_numbers<int> ("10,2x,3", ',', values).error() == ToNumbersError{std::errc::invalid_argument, 3});
+	REQUIRE(flex::pipes::to_numbers<int> ("10,,3", ',', values).error() == ToNumbersError{std::errc::invalid_argument, 3});
+	REQUIRE(flex::pipes::to_numbers<int> ("1,2,", ',', values).error() == ToNumbersError{std::errc::invalid_argument, 4});
+	REQUIRE(flex::pipes::to_numbers<int> ("1,12345678a", ',', values).error() == ToNumbersError{std::errc::invalid_argument, 2});
+	REQUIRE(flex::pipes::to_numbers<int> ("1,2147483648", ',', values).error() == ToNumbersError{std::errc::result_out_of_range, 2});
+	REQUIRE(flex::pipes::to_numbers<int> ("+1", ',', values).error() == ToNumbersError{std::errc::invalid_argument, 0});
+	REQUIRE(values == std::vector<int> {1});
+
+	std::array<int, 2> small {};
+	REQUIRE(flex::pipes::to_numbers<int> ("1,2,3", ',', small).error() == ToNumbersError{std::errc::value_too_large, 4});
+}
@@ -0,0 +1,64 @@
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <string>
+#include <vector>
+
+#include <flex/pipes/toString.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+static_assert(flex::pipes::NumberString<std::int64_t>::capacity() == 20);
+static_assert(flex::pipes::NumberString<std::uint8_t>::capacity() == 3);
+
+
+TEST_CASE("to string", "[pipes]") {
+	REQUIRE((42 | flex::pipes::to_string()) == "42");
+	REQUIRE((std::numeric_limits<std::int64_t>::min() | flex::pipes::to_string()) == "-9223372036854775808");
+	REQUIRE((-std::numeric_limits<double>::denorm_min() | flex::pipes::to_string()) == "-5e-324");
+	REQUIRE((-std::numeric_limits<double>::max() | flex::pipes::to_string()) == "-1.7976931348623157e+308");
+	REQUIRE((true | flex::pipes::to_string()) == "true");
+}
+
+
+TEST_CASE("inplace string", "[pipes]") {
+	const auto string {std::int16_t{-1234} | flex::pipes::to_inplace_string()};
+	REQUIRE(string == "-1234");
+	REQUIRE(string.c_str()[5] == '\0');
+	REQUIRE((std::numeric_limits<std::uint64_t>::max() | flex::pipes::to_inplace_string()) == "18446744073709551615");
+	REQUIRE((std::optional<float> {0.5f} | flex::pipes::to_inplace_string()) == flex::InplaceString<16> {"0.5"}.view());
+}
+
+
+TEST_CASE("to string into", "[pipes]") {
+	std::array<char, 4> buffer {};
+	REQUIRE((123 | flex::pipes::to_string_into(buffer)) == "123");
+	REQUIRE(!(12345 | flex::pipes::to_string_into(buffer)));
+
+	flex::InplaceString<8> string {"x="};
+	REQUIRE((77 | flex::pipes::to_string_into(string)) == "77");
+	REQUIRE(string == "x=77");
+	REQUIRE(!(123456789 | flex::pipes::to_string_into(string)));
+	REQUIRE(string == "x=77");
+
+	std::string output {};
+	(2.25 | flex::pipes::to_string_into(std::back_inserter(output)));
+	REQUIRE(output == "2.25");
+}
+
+
+TEST_CASE("batch", "[pipes]") {
+	const std::vector<int> numbers {1, -20, 300};
+	std::array<char, 16> buffer {};
+	REQUIRE(flex::pipes::to_strings(numbers, ',', buffer) == "1,-20,300");
+	REQUIRE(!flex::pipes::to_strings(numbers, ',', std::span{buffer}.first(8)));
+
+	std::string output {"values:"};
+	flex::pipes::to_strings(numbers, ';', output);
+	REQUIRE(output == "values:1;-20;300");
+
+	std::string fromList {};
+	flex::pipes::to_strings(std::list<double> {0.5, 2.0}, ' ', std::back_inserter(fromList));
+	REQUIRE(fromList == "0.5 2");
+}
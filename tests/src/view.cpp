@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <flex/view.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+
+namespace {
+	enum class Priority : std::uint8_t {
+		eLow,
+		eHigh
+	};
+
+	struct Sample {
+		float x;
+		float y;
+	};
+
+	struct Route {
+		std::string target;
+		std::uint16_t port;
+	};
+
+	struct Message {
+		std::uint64_t id;
+		std::string name;
+		Priority priority;
+		bool urgent;
+		std::vector<std::int32_t> values;
+		std::vector<Sample> samples;
+		Route route;
+		std::optional<std::string> comment;
+	};
+
+	struct MessageV2 {
+		std::uint64_t id;
+		std::string name;
+		Priority priority;
+		bool urgent;
+		std::vector<std::int32_t> values;
+		std::vector<Sample> samples;
+		Route route;
+		std::optional<std::string> comment;
+		std::optional<double> score;
+		std::string region;
+	};
+
+	// the counts of the spans end up 4 bytes past a multiple of 8
+	struct Measures {
+		std::int32_t unit;
+		std::vector<double> values;
+		std::string tag;
+		std::vector<std::int64_t> ids;
+		std::optional<std::vector<double>> extra;
+	};
+
+	auto encode(const auto &value) -> std::vector<std::byte> {
+		std::vector<std::byte> buffer {};
+		flex::View<std::remove_cvref_t<decltype(value)>>::encode(value, buffer);
+		return buffer;
+	}
+
+} // namespace
+
+
+TEST_CASE("view", "[view]") {
+	const Message message {
+		.id = 0x0102030405060708,
+		.name = "gateway",
+		.priority = Priority::eHigh,
+		.urgent = true,
+		.values = {1, -2, 3},
+		.samples = {{0.5f, 1.5f}, {2.f, 3.f}},
+		.route = {"backend", 8443},
+		.comment = std::nullopt
+	};
+	const std::vector<std::byte> buffer {encode(message)};
+
+	const auto view {flex::View<Message>::make(buffer)};
+	REQUIRE(view.has_value());
+	REQUIRE(view->get<"id">() == message.id);
+	REQUIRE(view->get<"name">() == "gateway");
+	REQUIRE(view->get<"name">().data() >= reinterpret_cast<const char*> (buffer.data()));
+	REQUIRE(view->get<"priority">() == Priority::eHigh);
+	REQUIRE(view->get<"urgent">());
+	REQUIRE(std::ranges::equal(view->get<"values">(), message.values));
+	REQUIRE(view->get<"samples">()[1].y == 3.f);
+	REQUIRE(view->get<"route">().get<"target">() == "backend");
+	REQUIRE(view->get<"route">().get<1>() == 8443);
+	REQUIRE(!view->has<"comment">());
+	REQUIRE(view->get<"comment">() == std::nullopt);
+	REQUIRE(view->getData().size() == buffer.size());
+
+	SECTION("added fields") {
+		const auto newer {flex::View<MessageV2>::make(buffer)};
+		REQUIRE(newer.has_value());
+		REQUIRE(newer->getFieldsCount() == 8);
+		REQUIRE(newer->get<"name">() == "gateway");
+		REQUIRE(newer->get<"score">() == std::nullopt);
+		REQUIRE(newer->get<"region">().empty());
+
+		MessageV2 messageV2 {};
+		messageV2.name = "newer";
+		messageV2.comment = "note";
+		messageV2.score = 0.75;
+		const std::vector<std::byte> newerBuffer {encode(messageV2)};
+		const auto older {flex::View<Message>::make(newerBuffer)};
+		REQUIRE(older.has_value());
+		REQUIRE(older->get<"name">() == "newer");
+		REQUIRE(older->get<"comment">() == "note");
+		REQUIRE(flex::View<MessageV2>::make(newerBuffer)->get<"score">() == 0.75);
+	}
+
+	SECTION("invalid") {
+		REQUIRE(flex::View<Message>::make(std::span{buffer}.first(buffer.size() - 1)).error() == flex::ViewError::eTruncated);
+		REQUIRE(flex::View<Message>::make(std::span{buffer}.subspan(4)).error() == flex::ViewError::eMisaligned);
+
+		std::vector<std::byte> corrupted {buffer};
+		corrupted[flex::__internals::getViewOffsetsPosition(8) + 4] = std::byte{0xff};
+		REQUIRE(flex::View<Message>::make(corrupted).error() == flex::ViewError::eInvalidOffset);
+	}
+}
+
+
+TEST_CASE("view of 8 bytes aligned elements", "[view]") {
+	const Measures measures {3, {0.5, -1.25, 1e300}, "abc", {-7, 1ll << 40}, std::vector<double> {2.5}};
+	const std::vector<std::byte> buffer {encode(measures)};
+	const auto view {flex::View<Measures>::make(buffer)};
+	REQUIRE(view.has_value());
+
+	const auto values {view->get<"values">()};
+	REQUIRE(reinterpret_cast<std::uintptr_t> (values.data()) % alignof(double) == 0);
+	REQUIRE(std::ranges::equal(values, measures.values));
+	REQUIRE(view->get<"tag">() == "abc");
+	const auto ids {view->get<"ids">()};
+	REQUIRE(reinterpret_cast<std::uintptr_t> (ids.data()) % alignof(std::int64_t) == 0);
+	REQUIRE(std::ranges::equal(ids, measures.ids));
+	REQUIRE(std::ranges::equal(*view->get<"extra">(), *measures.extra));
+}
@@ -0,0 +1,72 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <flex/logger/binary.hpp>
+
+
+namespace {
+	auto getResultMessage(flex::logger::binary::DecodeResult result) noexcept -> std::string_view {
+		switch (result) {
+			using enum flex::logger::binary::DecodeResult;
+			case eSuccess: return "success";
+			case eInvalidHeader: return "invalid header";
+			case eUnsupportedVersion: return "unsupported version";
+			case eTruncated: return "truncated chunk";
+			case eInvalidChunk: return "invalid chunk";
+			case eInvalidValue: return "invalid value";
+		}
+		return "unknown error";
+	}
+
+	auto printUsage(std::string_view program) noexcept -> void {
+		std::cerr << "usage : " << program << " [--json] <file>...\n"
+			<< "Decode binary logs written by flex::Logger. Segments of a rotated log must be given in order\n";
+	}
+
+} // namespace
+
+
+auto main(int argc, char **argv) -> int {
+	const std::span<char*> arguments {argv, static_cast<std::size_t> (argc)};
+	auto outputFormat {flex::logger::binary::DecodeOutputFormat::eText};
+	std::vector<std::string_view> paths {};
+	for (std::string_view argument : arguments.subspan(1)) {
+		if (argument == "--json")
+			outputFormat = flex::logger::binary::DecodeOutputFormat::eJson;
+		else if (argument == "--help" || argument == "-h") {
+			printUsage(arguments[0]);
+			return EXIT_SUCCESS;
+		}
+		else
+			paths.push_back(argument);
+	}
+	if (paths.empty()) {
+		printUsage(arguments[0]);
+		return EXIT_FAILURE;
+	}
+
+	flex::logger::binary::Decoder decoder {outputFormat};
+	for (std::string_view path : paths) {
+		std::ifstream file {std::string{path}, std::ios::binary};
+		if (!file) {
+			std::cerr << path << " : can't open the file\n";
+			return EXIT_FAILURE;
+		}
+		const std::string data {std::istreambuf_iterator<char> {file}, std::istreambuf_iterator<char> {}};
+
+		std::string output {};
+		const flex::logger::binary::DecodeResult result {decoder.decode(std::as_bytes(std::span{data}), output)};
+		std::cout << output;
+		if (result != flex::logger::binary::DecodeResult::eSuccess) {
+			std::cerr << path << " : " << getResultMessage(result) << "\n";
+			return EXIT_FAILURE;
+		}
+	}
+	return EXIT_SUCCESS;
+}